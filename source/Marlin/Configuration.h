@@ -1055,11 +1055,15 @@
  * Tare Probe (determine zero-point) prior to each probe.
  * Useful for a strain gauge or piezo sensor that needs to factor out
  * elements such as cables pulling on the carriage.
+ *
+ * The Kobra's probe has no tare pin, so this stays off and none of the tare
+ * code is built. tests/module/test_probe_tare.cpp turns it on to test it.
  */
 //#define PROBE_TARE
 #if ENABLED(PROBE_TARE)
-  #define PROBE_TARE_TIME  200    // (ms) Time to hold tare pin
-  #define PROBE_TARE_DELAY 200    // (ms) Delay after tare before
+  #define PROBE_TARE_TIME  200    // (ms) Time to hold tare pin. Starts before the move to each point.
+  #define PROBE_TARE_DELAY 200    // (ms) Longest wait for the probe to be ready after tare
+  #define PROBE_TARE_SETTLE 20    // (ms) Probe output must stay untriggered this long to be ready
   #define PROBE_TARE_STATE HIGH   // State to write pin for tare
   //#define PROBE_TARE_PIN PA5    // Override default pin
   #if ENABLED(PROBE_ACTIVATION_SWITCH)
@@ -1433,6 +1437,27 @@
       #define BILINEAR_SUBDIVISIONS 3
     #endif
 
+    //
+    // Bicubic surface through the grid points, from Catmull-Rom patches made
+    // once per cell whenever the grid changes and kept in fixed point.
+    // Smoother than bilinear between sparse points. Works best with
+    // SEGMENT_LEVELED_MOVES, so every segment follows the curve.
+    //
+    #define ABL_BICUBIC
+
+    //
+    // Named meshes kept packed at the end of the settings store, each with
+    // the bed temperature it was probed at. M424 saves, loads, lists and
+    // deletes them, and M424 A loads the one for the current bed target,
+    // so a repeat job can skip G29.
+    //
+    #define ABL_MESH_SLOTS
+    #if ENABLED(ABL_MESH_SLOTS)
+      #define MESH_SLOTS_SIZE      768  // (bytes) Taken from the end of the settings store
+      #define MESH_SLOTS_MAX         8  // Slots 0 to 7
+      #define MESH_SLOT_TEMP_RANGE   5  // (°C) M424 A only takes a slot probed this close to the bed target
+    #endif
+
   #endif
 
 #elif ENABLED(AUTO_BED_LEVELING_UBL)
@@ -1631,6 +1656,7 @@
 #define EEPROM_BOOT_SILENT    // Keep M503 quiet and only give errors during first load
 #if ENABLED(EEPROM_SETTINGS)
 #define EEPROM_AUTO_INIT  // Init EEPROM automatically on any errors.
+#define FLASH_EEPROM_LOG  // Append changed settings to pre-erased flash instead of rewriting the page. Saving is safe while printing.
 #endif
 
 //
@@ -298,6 +298,36 @@
   #endif
 #endif
 
+/**
+ * Fast PID Autotune
+ *
+ * Add 'M303 F1' to tune from a single heating step instead of relay cycles.
+ * The step response is fitted to a first-order-plus-dead-time model and the
+ * gains come from IMC tuning rules. With M111 S8 (dry run) the fit runs
+ * against a simulated heater, with parameters { K °C/count, tau s, dead time s }.
+ */
+#define PID_AUTOTUNE_FAST
+#if ENABLED(PID_AUTOTUNE_FAST)
+  #define PID_AUTOTUNE_FAST_LAMBDA      1.0   // Closed-loop time constant, in dead times. Higher is slower with less overshoot.
+  #define PID_AUTOTUNE_FAST_LAMBDA_BED  3.0
+  #define PID_AUTOTUNE_SIM_HOTEND { 1.30, 150.0,  4.0 }
+  #define PID_AUTOTUNE_SIM_BED    { 0.55, 260.0, 12.0 }
+#endif
+
+/**
+ * Event-driven temperature sampling
+ *
+ * Let a hardware timer start the ADC scan and sample the sensors when DMA has
+ * stored the results, instead of stepping through them from the ~1KHz tick.
+ * Readings are ready every OVERSAMPLENR samples, so PID_dT follows the rate.
+ */
+#define TEMP_SENSOR_EVENT_ISR
+#if ENABLED(TEMP_SENSOR_EVENT_ISR)
+  #define TEMP_SENSOR_FREQUENCY 100           // (Hz) 100 keeps the 0.16s PID interval
+#endif
+
+#define TEMP_ISR_STATS                        // Add 'M270' to report temperature ISR cycles and CPU load. 'M270 R' to reset.
+
 /**
  * Automatic Temperature Mode
  *
@@ -354,6 +384,72 @@
 // This shouldn't need to be more than 30 seconds (30000)
 //#define MILLISECONDS_PREHEAT_TIME 0
 
+/**
+ * Heater Thermal Models
+ *
+ * First-order models used by PREHEAT_SCHEDULER and HEATER_HEALTH_CHECK.
+ * Models are { heater watts at nominal voltage, heat capacity J/K, loss W/K }.
+ * Heater power is scaled by the measured PSU voltage (POWER_MONITOR_VOLTAGE).
+ */
+#define HEATER_NOMINAL_VOLTAGE  24.0        // (V) Supply voltage the heater watts are given for
+#define HOTEND_THERMAL_MODEL { 40.0,  18.0, 0.12 }
+#define BED_THERMAL_MODEL    { 220.0, 420.0, 1.60 }
+
+/**
+ * Preheat Scheduler
+ *
+ * Heat the bed and hotend together with M193 instead of one after the other.
+ * The thermal model of each heater predicts its time to target. The slowest
+ * heater starts at once and the others are released so that all heaters arrive
+ * at about the same time, without drawing more than the PSU power budget.
+ *
+ * The release times come straight from HOTEND_THERMAL_MODEL and
+ * BED_THERMAL_MODEL, and the models above are placeholders. Replace them with
+ * the "Thermal model" lines from M303 F1 before enabling this.
+ */
+//#define PREHEAT_SCHEDULER
+#if ENABLED(PREHEAT_SCHEDULER)
+  #define PREHEAT_POWER_BUDGET      270     // (W) Total power available to heaters
+  #define PREHEAT_ARRIVAL_MARGIN     10     // (s) Release a heater this early to absorb model error
+  #define PREHEAT_REPORT_INTERVAL     2     // (s) Progress report interval to host and LCD
+#endif
+
+/**
+ * Heater Health Check
+ *
+ * Runs beside THERMAL_PROTECTION and compares each heater's power balance
+ * against its thermal model over a short window. The heat the model can't
+ * account for, less a slowly learned load (e.g., filament melting, part
+ * cooling), is the residual.
+ *  - Heat missing: powered heater not warming as it should (failed heater,
+ *    loose thermistor). Stops with "Heating failed".
+ *  - Heat appearing: warming with no power to explain it (shorted MOSFET).
+ *    Stops with "Thermal Runaway".
+ * A fault must persist for HEATER_HEALTH_STRIKES windows in a row.
+ *
+ * The check is only as good as HOTEND_THERMAL_MODEL and BED_THERMAL_MODEL.
+ * Calibrate them first: M303 F1 prints a "Thermal model" for each heater
+ * from its measured step response. Until then keep HEATER_HEALTH_REPORT_ONLY
+ * so a fault is only reported.
+ *
+ * NOTE: With HEATER_HEALTH_REPORT_ONLY (the default here) this check stops
+ *       nothing. The only protection is the stock THERMAL_PROTECTION_HOTENDS
+ *       and THERMAL_PROTECTION_BED runaway checks. Disable REPORT_ONLY once the
+ *       models are calibrated and a few prints have run without a report.
+ */
+#define HEATER_HEALTH_CHECK
+#if ENABLED(HEATER_HEALTH_CHECK)
+  #define HEATER_HEALTH_REPORT_ONLY         // Report faults to the host without stopping the printer (no added protection)
+  #define HEATER_HEALTH_WINDOW         4    // (s) Hotend balance window. A few times the heater-to-sensor lag.
+  #define HEATER_HEALTH_BED_WINDOW    20    // (s) Bed balance window
+  #define HEATER_HEALTH_STRIKES        2    // Consecutive bad windows to trip
+  #define HEATER_HEALTH_MIN_POWER   0.30    // Check for missing heat above this fraction of full power
+  #define HEATER_HEALTH_MISSING     0.65    // Trip when this fraction of the applied power is unaccounted for
+  #define HEATER_HEALTH_EXCESS      0.40    // Trip when unexplained heating exceeds this fraction of full power
+  #define HEATER_HEALTH_MAX_LOAD    0.30    // Limit of the learned load, as a fraction of full power
+  //#define HEATER_HEALTH_DEBUG             // Report the power balance of every window
+#endif
+
 // @section extruder
 
 // Extruder runout prevention.
@@ -1253,6 +1349,26 @@
     // Without a POWER_LOSS_PIN the following option helps reduce wear on the SD card,
     // especially with "vase mode" printing. Set too high and vases cannot be continued.
     #define POWER_LOSS_MIN_Z_CHANGE 0.05 // (mm) Minimum Z change before saving power-loss data
+
+    // Append power-loss data to a ring of internal flash sectors instead of rewriting one
+    // sector per save. Saves no longer erase, so they also run on each layer change with
+    // a POWER_LOSS_PIN. Sectors are erased from idle while the planner is empty.
+    #define POWER_LOSS_JOURNAL
+    #if ENABLED(POWER_LOSS_JOURNAL)
+      #define POWER_LOSS_JOURNAL_CMDS 0 // Also save after this many extruding moves. (0 to disable)
+    #endif
+
+    #define POWER_LOSS_ADC_THRESHOLD 2200 // (ADC) POWER_MONITOR_VOLTAGE reading that means the PSU is failing
+
+    // Sample the PSU voltage on its own timer and, as soon as it reads below the threshold,
+    // write a checkpoint from the ADC watchdog interrupt into a slot the journal keeps erased.
+    // A flash write or erase in progress finishes first, so a dip during a ~20ms erase
+    // is only caught if the rail holds up that long.
+    // Requires POWER_LOSS_JOURNAL and POWER_MONITOR_VOLTAGE. Report the cost with M413.
+    #define POWER_LOSS_BROWNOUT
+    #if ENABLED(POWER_LOSS_BROWNOUT)
+      #define POWER_LOSS_BROWNOUT_FREQUENCY 5000 // (Hz) PSU sample rate. Detection takes up to one period.
+    #endif
   #endif
 
   /**
@@ -1293,6 +1409,41 @@
                                       // Note: Only affects SCROLL_LONG_FILENAMES with SDSORT_CACHE_NAMES but not SDSORT_DYNAMIC_RAM.
   #endif
 
+  /**
+   * Directory Index
+   *
+   * Index the working directory once per mount or folder change so that
+   * selecting an item by number seeks straight to its directory entry
+   * instead of re-reading the folder from the start. Paging through large
+   * folders then costs one directory read per displayed item.
+   *
+   * SDCARD_DIR_PREFETCH reads the next page of names in the background
+   * while the current page is on screen, so the next page flip needs no
+   * media access at all.
+   */
+  #define SDCARD_DIR_INDEX
+  #if ENABLED(SDCARD_DIR_INDEX)
+    #define SDCARD_DIR_INDEX_SIZE  256    // Indexed items per folder. Costs 20 bytes each. Later items are found by scanning.
+    #define SDCARD_DIR_PREFETCH      8    // Names to read ahead while idle (0 to disable). Costs 44 bytes each, 84 with SCROLL_LONG_FILENAMES.
+  #endif
+
+  /**
+   * Print Time Estimator
+   *
+   * Estimate progress and time remaining from the moves in the file, not
+   * from the file position. The file is scanned in the background, adding
+   * up move times under the current accelerations and feedrate limits.
+   * Moves already read are timed by the planner, and the model is scaled
+   * to match the elapsed time as the print runs.
+   *
+   * The estimate drives the LCD progress, is given to ExtUI displays, and
+   * is reported to hosts by M27.
+   */
+  #define PRINT_ETA_ESTIMATOR
+  #if ENABLED(PRINT_ETA_ESTIMATOR)
+    #define PRINT_ETA_BINS 64             // File slices timed separately. Costs 4 bytes each.
+  #endif
+
   // Allow international symbols in long filenames. To display correctly, the
   // LCD's font must contain the characters. Check your selected LCD language.
   //#define UTF_FILENAME_SUPPORT
@@ -1526,6 +1677,23 @@
   #endif
 #endif // HAS_DGUS_LCD
 
+//
+// Additional options for the Anycubic DGUS panel
+//
+#if ENABLED(ANYCUBIC_LCD_DGUS)
+  #define ANYCUBIC_DGUS_SHADOW_STATE      // Only send VPs that changed, coalescing adjacent VPs into one frame
+  #if ENABLED(ANYCUBIC_DGUS_SHADOW_STATE)
+    #define DGUS_SHADOW_VP_COUNT   48     // Number of VPs tracked
+    #define DGUS_SHADOW_TX_BUDGET  64     // (bytes) Most value bytes sent per panel update
+  #endif
+  #define ANYCUBIC_DGUS_LOAD_STATS        // Count the cycles spent updating the panel. Report with M270.
+  #define ANYCUBIC_DGUS_TX_QUEUE          // Queue whole frames for the panel, merging and replacing queued VP writes. Report with M270.
+  #if ENABLED(ANYCUBIC_DGUS_TX_QUEUE)
+    #define DGUS_TX_QUEUE_SIZE    512     // (bytes) Frame data held while the UART is busy
+    #define DGUS_TX_QUEUE_FRAMES   24     // Frames held while the UART is busy
+  #endif
+#endif
+
 //
 // Touch UI for the FTDI Embedded Video Engine (EVE)
 //
@@ -1772,6 +1940,68 @@
   //#define OPTIMIZED_MESH_STORAGE  // Store mesh with less precision to save EEPROM space
 #endif
 
+/**
+ * Sequence G29 grid probing for less travel.
+ * Predict each point from the plane of the points probed before it. Where
+ * that has held, travel low over the prediction. The lift off each touch
+ * and the move to the next point are planned together. G29 reports the
+ * time in each phase. Requires MULTIPLE_PROBING 2.
+ *
+ * Both touches are kept at every point, so the gain is in travel alone:
+ * a 5x5 G29 goes from about 206s to 164s in the host model
+ * (tests/feature/test_fast_probe_model.cpp).
+ *
+ * G29_FAST_AGREE also skips the slow touch when the fast one lands on the
+ * prediction, which brings G29 to 75-98s. Those points carry the fast
+ * touch's own noise, so the mesh is faster but less accurate.
+ *
+ * Low travel is only taken where the prediction held to G29_FAST_FLAT, so
+ * G29_FAST_CLEARANCE only has to clear that error. At 1.5mm the probe came
+ * no closer than 1.25mm to a bed 2mm out of tram in the model. Raising it to
+ * Z_CLEARANCE_BETWEEN_PROBES gives back nearly all of the time saved.
+ */
+#if EITHER(AUTO_BED_LEVELING_LINEAR, AUTO_BED_LEVELING_BILINEAR)
+  #define G29_FAST_PROBING
+  #if ENABLED(G29_FAST_PROBING)
+    #define G29_FAST_CLEARANCE 1.5  // (mm) Travel height over a predicted point, and the lift off each touch
+    #define G29_FAST_FLAT      0.1  // (mm) Travel low if neighbors are this level, or the last prediction was this close
+    //#define G29_FAST_AGREE   0.02 // (mm) Fast touch within this of the prediction skips the slow touch
+  #endif
+#endif
+
+/**
+ * G29 A probes only the grid points around the print area and moves the
+ * rest of the stored mesh by the change measured there. Give the area with
+ * L R F B, or let G29 find it in the first layer of the SD file printing.
+ */
+#if ENABLED(AUTO_BED_LEVELING_BILINEAR)
+  #define G29_ADAPTIVE
+  #if ENABLED(G29_ADAPTIVE)
+    #define G29_ADAPTIVE_MARGIN        5  // (mm) Added around the print area
+    #define G29_ADAPTIVE_MIN_POINTS    3  // Fewest grid points to probe along each axis
+    #define G29_ADAPTIVE_SCAN_BYTES 524288 // Most of the SD file to read looking for the first layer
+  #endif
+#endif
+
+/**
+ * G29 U sweeps the probe over the bed in rows, touching down on the move, and
+ * fits the grid to the touches. Each touch is a diagonal move that the probe
+ * trigger ends, sampled where the steppers stopped, then a diagonal lift goes
+ * on along the row. For probes that trigger on contact, like the nozzle strain
+ * gauge. EXPERIMENTAL
+ */
+#if ENABLED(AUTO_BED_LEVELING_BILINEAR)
+  #define G29_SWEEP_PROBING
+  #if ENABLED(G29_SWEEP_PROBING)
+    #define G29_SWEEP_ROWS GRID_MAX_POINTS_Y // Rows from front to back, on the grid lines if the same count
+    #define G29_SWEEP_SPACING     20  // (mm) Between touches along a row
+    #define G29_SWEEP_FEEDRATE    50  // (mm/s) XY speed along a row. Touches stop it dead, as endstops do homing.
+    #define G29_SWEEP_LIFT       0.3  // (mm) Hover over the last touch
+    #define G29_SWEEP_DEPTH      1.0  // (mm) Search below the last touch before probing straight down
+    #define G29_SWEEP_MAX_SAMPLES 256 // Touches kept for the fit, 12 bytes each taken from the heap during G29 U
+  #endif
+#endif
+
 /**
  * Repeatedly attempt G29 leveling until it succeeds.
  * Stop after G29_MAX_RETRIES attempts.
@@ -2599,6 +2829,22 @@
     #define STOP_ON_ERROR
   #endif
 
+  /**
+   * Drive the shared TMC UART from its interrupts. Register writes are queued
+   * and sent behind the main loop, reads skip the library's fixed delays, and
+   * MONITOR_DRIVER_STATUS polls DRV_STATUS without waiting for the answer.
+   * All UART drivers must be on Serial1 with distinct slave addresses.
+   */
+  #define TMC_UART_ASYNC
+
+  /**
+   * Keep the drivers' configuration registers in RAM. Setters change the copy
+   * and each changed register is sent once, from idle() or before a homing
+   * move. Reading these registers back doesn't use the bus.
+   * Requires TMC_UART_ASYNC.
+   */
+  #define TMC_SHADOW_REGISTERS
+
   /**
    * TMC2130, TMC2160, TMC2208, TMC2209, TMC5130 and TMC5160 only
    * The driver will switch to spreadCycle when stepper speed is over HYBRID_THRESHOLD.
@@ -2666,6 +2912,23 @@
     //#define IMPROVE_HOMING_RELIABILITY
   #endif
 
+  /**
+   * Sensorless fast homing
+   *
+   * Home X/Y with one approach at a higher feedrate and no bump. At speed the
+   * stall is detected later than in the slow re-bump, so the step count where
+   * the axis stops differs from the bumped home by a nearly fixed offset.
+   * M915 C measures that offset per axis, M915 R reports how well the fast
+   * home repeats against the bumped one, and M500 saves it.
+   * Uncalibrated axes home the normal way. Recalibrate after changing M914.
+   */
+  #define SENSORLESS_FAST_HOMING
+  #if ENABLED(SENSORLESS_FAST_HOMING)
+    #define SENSORLESS_FAST_HOMING_FEEDRATE_MM_M { (100*60), (100*60) } // (mm/min) Single approach
+    #define SENSORLESS_FAST_HOMING_TRAVEL 20  // (mm) Start distance of the M915 approaches
+    #define SENSORLESS_FAST_HOMING_SAMPLES 5  // Default M915 C/R approaches per axis
+  #endif
+
   /**
    * TMC Homing stepper phase.
    *
@@ -3221,6 +3484,19 @@
  */
 #define AUTO_REPORT_TEMPERATURES
 
+/**
+ * Temperature telemetry stream with M156 S<hz> [B1]
+ * Timestamped raw ADC, temperature, target, PWM, and PID terms for each
+ * heater as fixed-field text or binary frames. Each frame carries a new
+ * reading, so the rate is also limited to one frame per PID_dT (about 6Hz
+ * here). M156 echoes the interval actually used. Frames that don't fit in
+ * the host port's TX ring are dropped (and counted) instead of blocking.
+ */
+#define TEMP_TELEMETRY
+#if ENABLED(TEMP_TELEMETRY)
+  #define TEMP_TELEMETRY_MAX_HZ 50
+#endif
+
 /**
  * Include capabilities in M115 output
  */
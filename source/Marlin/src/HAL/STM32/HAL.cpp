@@ -25,6 +25,7 @@
 #include "../../inc/MarlinConfig.h"
 #include "../shared/Delay.h"
 #include "HAL.h"
+#include "../../libs/crc16.h"
 #include "bsp_rmu.h"
 
 
@@ -38,6 +39,7 @@ uint16_t HAL_adc_result;
 void HAL_init() {
   NVIC_SetPriorityGrouping(0x3);
   FastIO_init();
+  HAL_crc16_init();
 
   #if ENABLED(SDSUPPORT) && DISABLED(SDIO_SUPPORT) && (defined(SDSS) && SDSS != -1)
     OUT_WRITE(SDSS, HIGH); // Try to set SDSS inactive before any other SPI users start up
@@ -78,6 +80,57 @@ uint8_t HAL_get_reset_source()
 
 void _delay_ms(const int delay_ms) { delay(delay_ms); }
 
+// ------------------------
+// CRC unit
+// ------------------------
+
+#define CRC16_RESLT (*(__IO uint16_t *)&M4_CRC->RESLT)
+#define CRC16_DAT   (*(__IO uint16_t *)&M4_CRC->DAT0)
+#define CRC16_MIN   8                 // Shorter blocks go through the table and skip the unit setup
+
+static bool crc_unit_ok, crc_swap;
+static volatile bool crc_unit_busy;   // A CRC in an ISR over a main-loop one uses the table
+
+// Feed whole aligned halfwords to the unit, odd bytes go through the table
+static uint16_t crc_unit(uint16_t crc, const uint8_t *data, uint32_t cnt) {
+  if (uintptr_t(data) & 1) { crc = crc16_sw(crc, data++, 1); --cnt; }
+  CRC16_RESLT = crc;
+  const uint16_t *h = (const uint16_t*)data;
+  for (uint32_t n = cnt >> 1; n--;) {
+    const uint16_t w = *h++;
+    CRC16_DAT = crc_swap ? uint16_t((w << 8) | (w >> 8)) : w;
+  }
+  crc = CRC16_RESLT;
+  return (cnt & 1) ? crc16_sw(crc, (const uint8_t*)h, 1) : crc;
+}
+
+/**
+ * The unit's bit order and output options don't map plainly onto the CRC
+ * already stored with settings, so use the first setup that gives the same
+ * results as the table, and the table alone if none does.
+ */
+void HAL_crc16_init() {
+  static const uint8_t probe[] = "123456789ABCDEF";
+  PWC_Fcg0PeriphClockCmd(PWC_FCG0_PERIPH_CRC, Enable);
+  LOOP_L_N(cfg, 8) LOOP_L_N(swap, 2) {
+    CRC_Init(CRC_SEL_16B | (cfg << 2));
+    crc_swap = swap;
+    if (crc_unit(0, probe, 9) == 0x31C3 && crc_unit(0x1D0F, probe + 1, 14) == crc16_sw(0x1D0F, probe + 1, 14)) {
+      crc_unit_ok = true;
+      return;
+    }
+  }
+  PWC_Fcg0PeriphClockCmd(PWC_FCG0_PERIPH_CRC, Disable);
+}
+
+uint16_t HAL_crc16(uint16_t crc, const uint8_t *data, uint32_t cnt) {
+  if (cnt < CRC16_MIN || !crc_unit_ok || crc_unit_busy) return crc16_sw(crc, data, cnt);
+  crc_unit_busy = true;
+  crc = crc_unit(crc, data, cnt);
+  crc_unit_busy = false;
+  return crc;
+}
+
 extern "C" {
   extern unsigned int _ebss; // end of bss section
 }
@@ -122,6 +122,16 @@ void HAL_clear_reset_source();
 // Reset reason
 uint8_t HAL_get_reset_source();
 
+// CRC-16 on the CRC unit, falling back to the table in libs/crc16.cpp
+void HAL_crc16_init();
+uint16_t HAL_crc16(uint16_t crc, const uint8_t *data, uint32_t cnt);
+
+#if ENABLED(FLASH_EEPROM_LOG)
+  // Settings log housekeeping, in eeprom_flash.cpp
+  #define HAL_IDLETASK 1
+  void HAL_idletask();
+#endif
+
 inline void HAL_reboot() {}  // reboot the board or restart the bootloader
 
 void _delay_ms(const int delay);
@@ -175,6 +185,33 @@ inline static uint32_t HAL_adc_read()
 
 void HAL_adc_start_conversion(const uint8_t adc_pin);
 
+// Convert all ADC channels on a hardware timer and interrupt on DMA completion
+extern "C" void adc_event_trigger_init(uint32_t frequency);
+#define HAL_ADC_EVENT_START(F)  adc_event_trigger_init(F)
+
+// Sample the PSU voltage channel on its own timer and interrupt when it reads below L (raw)
+extern "C" void adc_awd_init(uint16_t low, uint32_t frequency);
+extern "C" void adc_awd_irq_cmd(en_functional_state_t state);
+extern "C" bool adc_awd_irq_enabled(void);
+#define HAL_ADC_AWD_START(L,F)  adc_awd_init(L, F)
+#define HAL_ADC_AWD_ENABLE()    adc_awd_irq_cmd(Enable)
+#define HAL_ADC_AWD_DISABLE()   adc_awd_irq_cmd(Disable)
+#define HAL_ADC_AWD_ENABLED()   adc_awd_irq_enabled()
+
+// Core cycle counter, for measuring ISR cost
+inline void HAL_cycle_counter_init() {
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CYCCNT = 0;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+#define HAL_cycle_count() (DWT->CYCCNT)
+
+// Hand the TMC UART (USART1) to interrupt-driven byte callbacks. T returns -1 when done sending.
+extern "C" void (*usart1_rx_hook)(uint8_t c);
+extern "C" int16_t (*usart1_tx_hook)(void);
+#define HAL_TMC_UART_ATTACH(R,T)  do{ usart1_rx_hook = R; usart1_tx_hook = T; }while(0)
+#define HAL_TMC_UART_SEND()       USART_FuncCmd(M4_USART1, UsartTxEmptyInt, Enable)
+
 uint16_t HAL_adc_get_result();
 
 #define GET_PIN_MAP_PIN(index) index
@@ -45,11 +45,243 @@
 
 static bool eeprom_data_written = false;
 
+// Both stores below hold EEPROM_SIZE bytes
 size_t PersistentStore::capacity()
 {
-    return MARLIN_EEPROM_SIZE;
+    return EEPROM_SIZE;
 }
 
+#if ENABLED(FLASH_EEPROM_LOG)
+
+#include "../../module/planner.h"
+
+/**
+ * Log-structured settings store
+ *
+ * The emulated EEPROM is kept in RAM as 32-byte blocks. A save appends one
+ * record for each block that differs from flash into erased space, and flags
+ * the last record of the save, so a save cut short by a reset is ignored as a
+ * whole. A save never erases and never disables interrupts.
+ *
+ * Two sectors take turns. When the active one fills up, every block is copied
+ * into the spare and the spare's header is programmed last, which makes it
+ * the active sector. Erasing stalls the CPU, so the spare is erased from
+ * idle() while the planner is empty and is normally blank before it's needed.
+ *
+ * The old single-page image in the EEPROM sector, or else the one the stock
+ * firmware kept lower in flash, is imported on first boot.
+ */
+
+#define LOG_BLOCK         32
+#define LOG_KEYS          (EEPROM_SIZE / LOG_BLOCK)
+#define LOG_MAGIC         0x474F4C53UL    // "SLOG"
+
+static_assert(EEPROM_SIZE % LOG_BLOCK == 0, "EEPROM_SIZE must be a multiple of the settings log block size.");
+
+typedef struct { uint32_t magic, gen, gen_inv, reserved; } log_head_t;
+typedef struct { uint8_t key, flags; uint16_t crc; uint8_t data[LOG_BLOCK]; } log_rec_t;
+
+#define REC_LAST          0x80            // Flags hold the id of the save and this bit on its last record
+
+#define LOG_SLOTS         ((FLASH_SECTOR_SIZE - sizeof(log_head_t)) / sizeof(log_rec_t))
+
+static const uint32_t log_sector[2] = { FLASH_SETTINGS_BASE, FLASH_EEPROM_BASE };
+
+static uint8_t image[EEPROM_SIZE] __attribute__((aligned(4)));
+static uint32_t where[LOG_KEYS];    // Address of each block's newest saved copy, 0 for none
+static uint32_t gen;
+static uint16_t next_slot;
+static uint8_t save_id;
+static uint8_t active;
+static bool mounted, spare_blank;
+
+static inline uint32_t slot_addr(const uint8_t s, const uint16_t slot) {
+  return log_sector[s] + sizeof(log_head_t) + slot * sizeof(log_rec_t);
+}
+
+static bool is_blank(const void * const p, const uint32_t len) {
+  const uint32_t *w = (const uint32_t*)p;
+  for (uint32_t n = len / 4; n--;) if (*w++ != 0xFFFFFFFFUL) return false;
+  return true;
+}
+
+static uint16_t rec_crc(const log_rec_t &r) {
+  uint16_t c = 0;
+  crc16(&c, &r.key, 2);
+  crc16(&c, r.data, LOG_BLOCK);
+  return c;
+}
+
+static bool head_gen(const uint8_t s, uint32_t &g) {
+  const log_head_t &h = *(const log_head_t*)log_sector[s];
+  g = h.gen;
+  return h.magic == LOG_MAGIC && h.gen_inv == ~h.gen;
+}
+
+static bool erase_spare() {
+  const uint32_t addr = log_sector[active ^ 1];
+  spare_blank = Intflash::FlashErasePage(addr) == Ok && is_blank((const void*)addr, FLASH_SECTOR_SIZE);
+  return spare_blank;
+}
+
+// Copy the saved blocks into the RAM image, dropping unsaved writes
+static void refill() {
+  LOOP_L_N(k, LOG_KEYS) {
+    uint8_t * const blk = &image[k * LOG_BLOCK];
+    if (where[k]) memcpy(blk, ((const log_rec_t*)where[k])->data, LOG_BLOCK);
+    else memset(blk, 0xFF, LOG_BLOCK);
+  }
+}
+
+static bool write_rec(const uint32_t addr, const uint8_t key, const bool last) {
+  log_rec_t r;
+  r.key = key;
+  r.flags = (save_id & ~REC_LAST) | (last ? REC_LAST : 0);
+  memcpy(r.data, &image[key * LOG_BLOCK], LOG_BLOCK);
+  r.crc = rec_crc(r);
+  return Intflash::FlashProgram(addr, &r, sizeof(r)) == Ok;
+}
+
+/**
+ * Copy every non-blank block into the spare as one save,
+ * then program its header to make it the active sector
+ */
+static bool compact() {
+  if (!spare_blank && !erase_spare()) return false;
+
+  const uint8_t to = active ^ 1;
+  spare_blank = false;
+  ++save_id;
+
+  uint8_t keys[LOG_KEYS], n = 0;
+  LOOP_L_N(k, LOG_KEYS)
+    if (!is_blank(&image[k * LOG_BLOCK], LOG_BLOCK)) keys[n++] = k;
+
+  LOOP_L_N(i, n)
+    if (!write_rec(slot_addr(to, i), keys[i], i == n - 1)) return false;
+
+  const log_head_t h = { LOG_MAGIC, gen + 1, ~(gen + 1), 0xFFFFFFFFUL };
+  if (Intflash::FlashProgram(log_sector[to], &h, sizeof(h)) != Ok) return false;
+
+  ++gen;
+  active = to;
+  next_slot = n;
+  ZERO(where);
+  LOOP_L_N(i, n) where[keys[i]] = slot_addr(to, i);
+  return true;
+}
+
+/**
+ * Find the newest sector and rebuild the image from its complete saves.
+ * A record that fails its CRC was cut short, so its save is dropped.
+ * So is a save with a blank slot, left by a record that failed to program;
+ * the saves after it are still read, and new records go after the last one.
+ */
+static void mount() {
+  mounted = true;
+  ZERO(where);
+  next_slot = 0;
+
+  uint32_t g0, g1;
+  const bool v0 = head_gen(0, g0), v1 = head_gen(1, g1);
+
+  if (!v0 && !v1) {
+    // Import the single-page EEPROM image, if any, else the stock firmware's.
+    // A page that has since been overwritten by code fails the settings CRC.
+    memset(image, 0xFF, sizeof(image));
+    if (!is_blank((const void*)FLASH_EEPROM_BASE, EEPROM_SIZE))
+      memcpy(image, (const void*)FLASH_EEPROM_BASE, EEPROM_SIZE);
+    else if (!is_blank((const void*)FLASH_STOCK_EEPROM_BASE, EEPROM_SIZE))
+      memcpy(image, (const void*)FLASH_STOCK_EEPROM_BASE, EEPROM_SIZE);
+    gen = 0;
+    active = 1;
+    spare_blank = is_blank((const void*)log_sector[0], FLASH_SECTOR_SIZE);
+    compact();
+    return;
+  }
+
+  active = (v0 && (!v1 || int32_t(g0 - g1) > 0)) ? 0 : 1;
+  gen = active ? g1 : g0;
+
+  uint32_t pend[LOG_KEYS] = { 0 };
+  for (uint16_t slot = 0; slot < LOG_SLOTS; ++slot) {
+    const uint32_t addr = slot_addr(active, slot);
+    if (is_blank((const void*)addr, sizeof(log_rec_t))) { ZERO(pend); continue; }
+    next_slot = slot + 1;
+    const log_rec_t &r = *(const log_rec_t*)addr;
+    if (r.key >= LOG_KEYS || r.crc != rec_crc(r)) { ZERO(pend); continue; }
+    if ((r.flags ^ save_id) & ~REC_LAST) { ZERO(pend); save_id = r.flags & ~REC_LAST; }
+    pend[r.key] = addr;
+    if (r.flags & REC_LAST) LOOP_L_N(k, LOG_KEYS) if (pend[k]) { where[k] = pend[k]; pend[k] = 0; }
+  }
+
+  refill();
+  spare_blank = is_blank((const void*)log_sector[active ^ 1], FLASH_SECTOR_SIZE);
+}
+
+// Append the blocks that differ from flash as one save
+static bool commit() {
+  uint8_t keys[LOG_KEYS], n = 0;
+  LOOP_L_N(k, LOG_KEYS) {
+    const uint8_t * const blk = &image[k * LOG_BLOCK];
+    if (where[k] ? memcmp(blk, ((const log_rec_t*)where[k])->data, LOG_BLOCK) : !is_blank(blk, LOG_BLOCK))
+      keys[n++] = k;
+  }
+  if (!n) return true;
+  if (next_slot + n > LOG_SLOTS) return compact();
+
+  const uint16_t first = next_slot;
+  next_slot += n;                   // Failed records are skipped, not programmed over
+  ++save_id;                        // and left out of the next save
+  LOOP_L_N(i, n)
+    if (!write_rec(slot_addr(active, first + i), keys[i], i == n - 1)) return false;
+
+  LOOP_L_N(i, n) where[keys[i]] = slot_addr(active, first + i);
+  return true;
+}
+
+/**
+ * Erase the spare sector, and compact a nearly full sector,
+ * while the planner is empty so no move waits on the flash
+ */
+void HAL_idletask() {
+  if (!mounted || planner.has_blocks_queued()) return;
+  if (!spare_blank)
+    erase_spare();
+  else if (next_slot + LOG_KEYS > LOG_SLOTS)
+    compact();
+}
+
+bool PersistentStore::access_start() {
+  if (!mounted) mount(); else refill();
+  return true;
+}
+
+bool PersistentStore::access_finish() {
+  if (!eeprom_data_written) return true;
+  eeprom_data_written = false;
+  return commit();
+}
+
+bool PersistentStore::write_data(int &pos, const uint8_t *value, size_t size, uint16_t *crc) {
+  crc16(crc, value, size);
+  if (memcmp(&image[pos], value, size)) {
+    memcpy(&image[pos], value, size);
+    eeprom_data_written = true;
+  }
+  pos += size;
+  return false;
+}
+
+bool PersistentStore::read_data(int &pos, uint8_t *value, size_t size, uint16_t *crc, const bool writing/*=true*/) {
+  crc16(crc, &image[pos], size);
+  if (writing) memcpy(value, &image[pos], size);
+  pos += size;
+  return false;
+}
+
+#else // !FLASH_EEPROM_LOG
+
 bool PersistentStore::access_start() {
     Intflash::eeprom_buffer_fill();
     return true;
@@ -68,13 +300,13 @@ bool PersistentStore::access_finish() {
 }
 
 bool PersistentStore::write_data(int &pos, const uint8_t *value, size_t size, uint16_t *crc) {
+  crc16(crc, value, size);
   while (size--) {
     uint8_t v = *value;
       if (v != Intflash::eeprom_buffered_read_byte(pos)) {
         Intflash::eeprom_buffered_write_byte(pos, v);
         eeprom_data_written = true;
       }
-    crc16(crc, &v, 1);
     pos++;
     value++;
   }
@@ -92,6 +324,8 @@ bool PersistentStore::read_data(int &pos, uint8_t *value, size_t size, uint16_t
   return false;
 }
 
+#endif // !FLASH_EEPROM_LOG
+
 uint32_t PersistentStore::FLASH_If_Erase(uint32_t addr_start, uint32_t addr_end) {
     Intflash::FlashErasePage(addr_start);
     return(0);
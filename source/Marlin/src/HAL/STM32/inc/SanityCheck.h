@@ -46,6 +46,10 @@
   #error "FLASH_EEPROM_LEVELING is currently only supported on STM32F4 hardware."
 #endif
 
+#if ENABLED(FLASH_EEPROM_LOG) && DISABLED(FLASH_EEPROM_EMULATION)
+  #error "FLASH_EEPROM_LOG requires FLASH_EEPROM_EMULATION."
+#endif
+
 #if ENABLED(SERIAL_STATS_MAX_RX_QUEUED)
   #error "SERIAL_STATS_MAX_RX_QUEUED is not supported on this platform."
 #elif ENABLED(SERIAL_STATS_DROPPED_RX)
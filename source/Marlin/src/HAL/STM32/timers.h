@@ -85,6 +85,8 @@ typedef uint16_t hal_timer_t;
 #define HAL_STEP_TIMER_ISR()      void timer42_zero_match_irq_cb(void)
 #define HAL_TEMP_TIMER_ISR()      void timer41_zero_match_irq_cb(void)
 #define HAL_TONE_TIMER_ISR()      void Timer01B_CallBack(void)
+#define HAL_ADC_EVENT_ISR()       extern "C" void adc_dma_btc_irq_cb(void)
+#define HAL_ADC_AWD_ISR()         extern "C" void adc_awd_irq_cb(void)
 
 // ------------------------
 // Public Variables
@@ -128,6 +130,9 @@ static inline void HAL_timer_isr_epilogue(uint8_t timer_num)
     }
 }
 
+#define HAL_adc_event_isr_epilogue() DMA_ClearIrqFlag(M4_DMA2, DmaCh3, BlkTrnCpltIrq)
+#define HAL_adc_awd_isr_epilogue()   ADC_ClrAwdFlag(M4_ADC1)
+
 #define TIMER_OC_NO_PRELOAD 0 // Need to disable preload also on compare registers.
 
 
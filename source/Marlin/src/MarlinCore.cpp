@@ -234,6 +234,22 @@
   #include "feature/password/password.h"
 #endif
 
+#if ENABLED(TEMP_TELEMETRY)
+  #include "feature/temp_telemetry.h"
+#endif
+
+#if ENABLED(PRINT_ETA_ESTIMATOR)
+  #include "feature/print_eta.h"
+#endif
+
+#if ENABLED(POWER_LOSS_JOURNAL)
+  #include "feature/plr_journal.h"
+#endif
+
+#if ENABLED(TMC_UART_ASYNC)
+  #include "feature/tmc_bus.h"
+#endif
+
 PGMSTR(NUL_STR, "");
 PGMSTR(M112_KILL_STR, "M112 Shutdown");
 PGMSTR(G28_STR, "G28");
@@ -671,6 +687,8 @@ inline void manage_inactivity(const bool ignore_stepper_queue=false) {
 
   TERN_(TEMP_STAT_LEDS, handle_status_leds());
 
+  TERN_(TMC_UART_ASYNC, tmc_bus.task());
+
   TERN_(MONITOR_DRIVER_STATUS, monitor_tmc_drivers());
 
   TERN_(MONITOR_L6470_DRIVER_STATUS, L64xxManager.monitor_driver());
@@ -749,6 +767,12 @@ void idle(TERN_(ADVANCED_PAUSE_FEATURE, bool no_stepper_sleep/*=false*/)) {
     if (printJobOngoing()) recovery.outage();
   #endif
 
+  // Erase the next power-loss journal sector ahead of need
+  TERN_(POWER_LOSS_JOURNAL, plr_journal.task());
+
+  // Keep the brown-out checkpoint current
+  TERN_(POWER_LOSS_BROWNOUT, recovery.brownout_task());
+
   // Run StallGuard endstop checks
   #if ENABLED(SPI_ENDSTOPS)
     if (endstops.tmc_spi_homing.any
@@ -760,6 +784,12 @@ void idle(TERN_(ADVANCED_PAUSE_FEATURE, bool no_stepper_sleep/*=false*/)) {
   // Handle SD Card insert / remove
   TERN_(SDSUPPORT, card.manage_media());
 
+  // Read ahead the next page of the file browser
+  TERN_(SD_PREFETCH, card.prefetch_task());
+
+  // Scan ahead in the printed file and refresh the time estimate
+  TERN_(PRINT_ETA_ESTIMATOR, print_eta.task());
+
   // Handle USB Flash Drive insert / remove
   TERN_(USB_FLASH_DRIVE_SUPPORT, Sd2Card::idle());
 
@@ -797,6 +827,8 @@ void idle(TERN_(ADVANCED_PAUSE_FEATURE, bool no_stepper_sleep/*=false*/)) {
     }
   #endif
 
+  TERN_(TEMP_TELEMETRY, temp_telemetry.tick());
+
   // Update the Průša MMU2
   TERN_(HAS_PRUSA_MMU2, mmu2.mmu_loop());
 
@@ -1340,6 +1372,10 @@ void setup() {
 
   SETUP_RUN(thermalManager.init());   // Initialize temperature loop
 
+  #if ENABLED(POWER_LOSS_BROWNOUT)
+    SETUP_RUN(recovery.brownout_init()); // After the temperature ADC setup
+  #endif
+
   #if HAS_TFT_LVGL_UI
     #if ENABLED(SDSUPPORT)
       if (!card.isMounted()) SETUP_RUN(card.mount()); // Mount SD to load graphics and fonts
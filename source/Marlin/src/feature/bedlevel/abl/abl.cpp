@@ -142,22 +142,10 @@ void print_bilinear_leveling_grid() {
   );
 }
 
-#if ENABLED(ABL_BILINEAR_SUBDIVISION)
+#if EITHER(ABL_BILINEAR_SUBDIVISION, ABL_BICUBIC)
 
-  #define ABL_GRID_POINTS_VIRT_X (GRID_MAX_POINTS_X - 1) * (BILINEAR_SUBDIVISIONS) + 1
-  #define ABL_GRID_POINTS_VIRT_Y (GRID_MAX_POINTS_Y - 1) * (BILINEAR_SUBDIVISIONS) + 1
   #define ABL_TEMP_POINTS_X (GRID_MAX_POINTS_X + 2)
   #define ABL_TEMP_POINTS_Y (GRID_MAX_POINTS_Y + 2)
-  float z_values_virt[ABL_GRID_POINTS_VIRT_X][ABL_GRID_POINTS_VIRT_Y];
-  xy_pos_t bilinear_grid_spacing_virt;
-  xy_float_t bilinear_grid_factor_virt;
-
-  void print_bilinear_leveling_grid_virt() {
-    SERIAL_ECHOLNPGM("Subdivided with CATMULL ROM Leveling Grid:");
-    print_2d_array(ABL_GRID_POINTS_VIRT_X, ABL_GRID_POINTS_VIRT_Y, 5,
-      [](const uint8_t ix, const uint8_t iy) { return z_values_virt[ix][iy]; }
-    );
-  }
 
   #define LINEAR_EXTRAPOLATION(E, I) ((E) * 2 - (I))
   float bed_level_virt_coord(const uint8_t x, const uint8_t y) {
@@ -205,6 +193,23 @@ void print_bilinear_leveling_grid() {
     return z_values[x - 1][y - 1];
   }
 
+#endif
+
+#if ENABLED(ABL_BILINEAR_SUBDIVISION)
+
+  #define ABL_GRID_POINTS_VIRT_X (GRID_MAX_POINTS_X - 1) * (BILINEAR_SUBDIVISIONS) + 1
+  #define ABL_GRID_POINTS_VIRT_Y (GRID_MAX_POINTS_Y - 1) * (BILINEAR_SUBDIVISIONS) + 1
+  float z_values_virt[ABL_GRID_POINTS_VIRT_X][ABL_GRID_POINTS_VIRT_Y];
+  xy_pos_t bilinear_grid_spacing_virt;
+  xy_float_t bilinear_grid_factor_virt;
+
+  void print_bilinear_leveling_grid_virt() {
+    SERIAL_ECHOLNPGM("Subdivided with CATMULL ROM Leveling Grid:");
+    print_2d_array(ABL_GRID_POINTS_VIRT_X, ABL_GRID_POINTS_VIRT_Y, 5,
+      [](const uint8_t ix, const uint8_t iy) { return z_values_virt[ix][iy]; }
+    );
+  }
+
   static float bed_level_virt_cmr(const float p[4], const uint8_t i, const float t) {
     return (
         p[i-1] * -t * sq(1 - t)
@@ -245,14 +250,162 @@ void print_bilinear_leveling_grid() {
   }
 #endif // ABL_BILINEAR_SUBDIVISION
 
+#if ENABLED(ABL_BICUBIC)
+
+  #define BICUBIC_ONE 65536   // Q16 fixed point: mm for coefficients, cell fraction for t
+
+  // Per cell, a[i][j] multiplies tx^i * ty^j
+  static int32_t bicubic_patch[GRID_MAX_POINTS_X - 1][GRID_MAX_POINTS_Y - 1][4][4];
+  static bool bicubic_valid;
+
+  /**
+   * Make the Catmull-Rom patch of every grid cell, the same surface that
+   * ABL_BILINEAR_SUBDIVISION samples, as polynomial coefficients. Points
+   * beyond the grid are extrapolated from the edges. Leave the patches
+   * unused if any grid point is unknown.
+   */
+  void bed_level_bicubic_patches() {
+    // Catmull-Rom basis: power of t by point p[-1] .. p[2]
+    static constexpr float M[4][4] = {
+      {  0.0f,  1.0f,  0.0f,  0.0f },
+      { -0.5f,  0.0f,  0.5f,  0.0f },
+      {  1.0f, -2.5f,  2.0f, -0.5f },
+      { -0.5f,  1.5f, -1.5f,  0.5f }
+    };
+
+    bicubic_valid = false;
+    GRID_LOOP(x, y) if (isnan(z_values[x][y])) return;
+
+    LOOP_L_N(cx, GRID_MAX_POINTS_X - 1) LOOP_L_N(cy, GRID_MAX_POINTS_Y - 1) {
+      float P[4][4], MP[4][4];
+      LOOP_L_N(i, 4) LOOP_L_N(j, 4) P[i][j] = bed_level_virt_coord(cx + i, cy + j);
+      LOOP_L_N(p, 4) LOOP_L_N(j, 4) {
+        MP[p][j] = 0;
+        LOOP_L_N(i, 4) MP[p][j] += M[p][i] * P[i][j];
+      }
+      LOOP_L_N(p, 4) LOOP_L_N(q, 4) {
+        float a = 0;
+        LOOP_L_N(j, 4) a += MP[p][j] * M[q][j];
+        bicubic_patch[cx][cy][p][q] = LROUND(a * BICUBIC_ONE);
+      }
+    }
+
+    bicubic_valid = true;
+  }
+
+  // c[3] t^3 + c[2] t^2 + c[1] t + c[0], all Q16
+  FORCE_INLINE static int32_t bicubic_horner(const int32_t c0, const int32_t c1, const int32_t c2, const int32_t c3, const int32_t t) {
+    int32_t r = c3;
+    r = int32_t((int64_t(r) * t) >> 16) + c2;
+    r = int32_t((int64_t(r) * t) >> 16) + c1;
+    return int32_t((int64_t(r) * t) >> 16) + c0;
+  }
+
+  // Grid cell and Q16 fraction within it. Beyond the grid, hold the edge.
+  FORCE_INLINE static uint8_t bicubic_cell(const float rel, const float factor, const uint8_t points, int32_t &t) {
+    const float r = rel * factor;
+    const int16_t g = constrain(int16_t(FLOOR(r)), 0, points - 2);
+    t = constrain(LROUND((r - g) * BICUBIC_ONE), 0, BICUBIC_ONE);
+    return g;
+  }
+
+  static float bicubic_z_offset(const xy_pos_t &raw) {
+    int32_t tx, ty;
+    const uint8_t gx = bicubic_cell(raw.x - bilinear_start.x, bilinear_grid_factor.x, GRID_MAX_POINTS_X, tx),
+                  gy = bicubic_cell(raw.y - bilinear_start.y, bilinear_grid_factor.y, GRID_MAX_POINTS_Y, ty);
+    const int32_t (&a)[4][4] = bicubic_patch[gx][gy];
+    const int32_t z = bicubic_horner(
+      bicubic_horner(a[0][0], a[0][1], a[0][2], a[0][3], ty),
+      bicubic_horner(a[1][0], a[1][1], a[1][2], a[1][3], ty),
+      bicubic_horner(a[2][0], a[2][1], a[2][2], a[2][3], ty),
+      bicubic_horner(a[3][0], a[3][1], a[3][2], a[3][3], ty),
+      tx
+    );
+    return z * (1.0f / BICUBIC_ONE);
+  }
+
+#endif // ABL_BICUBIC
+
 // Refresh after other values have been updated
 void refresh_bed_level() {
   bilinear_grid_factor.x = bilinear_grid_spacing.x ? 1.0f / bilinear_grid_spacing.x : 0.0f;
   bilinear_grid_factor.y = bilinear_grid_spacing.y ? 1.0f / bilinear_grid_spacing.y : 0.0f;
 
   TERN_(ABL_BILINEAR_SUBDIVISION, bed_level_virt_interpolate());
+  TERN_(ABL_BICUBIC, bed_level_bicubic_patches());
 }
 
+#if ENABLED(ABL_MESH_SLOTS)
+
+  /**
+   * Mesh slot packing. Each point is kept in microns as the difference from
+   * a guess made from its left, lower and lower-left neighbors, so a flat or
+   * tilted bed packs into a byte per point. Differences go out as zigzag
+   * varints offset by one, and a 0 byte marks an unprobed point.
+   */
+  #define MESH_PACK_NAN INT32_MIN
+
+  static int32_t mesh_guess(const int32_t (&q)[GRID_MAX_POINTS_X][GRID_MAX_POINTS_Y], const uint8_t x, const uint8_t y) {
+    const int32_t l = x ? q[x - 1][y] : MESH_PACK_NAN,
+                  d = y ? q[x][y - 1] : MESH_PACK_NAN,
+                  c = x && y ? q[x - 1][y - 1] : MESH_PACK_NAN;
+    if (l != MESH_PACK_NAN && d != MESH_PACK_NAN && c != MESH_PACK_NAN) return l + d - c;
+    if (l != MESH_PACK_NAN) return l;
+    if (d != MESH_PACK_NAN) return d;
+    return 0;
+  }
+
+  // Pack z_values into out. Return the bytes used, or 0 if they don't fit.
+  uint16_t bed_level_pack(uint8_t * const out, const uint16_t size) {
+    int32_t q[GRID_MAX_POINTS_X][GRID_MAX_POINTS_Y];
+    uint16_t n = 0;
+    LOOP_L_N(y, GRID_MAX_POINTS_Y) LOOP_L_N(x, GRID_MAX_POINTS_X) {
+      uint32_t code = 0;
+      if (isnan(z_values[x][y]))
+        q[x][y] = MESH_PACK_NAN;
+      else {
+        q[x][y] = LROUND(z_values[x][y] * 1000.0f);
+        const int32_t r = q[x][y] - mesh_guess(q, x, y);
+        code = ((uint32_t(r) << 1) ^ uint32_t(r >> 31)) + 1;
+      }
+      do {
+        if (n >= size) return 0;
+        out[n++] = (code & 0x7F) | (code > 0x7F ? 0x80 : 0);
+        code >>= 7;
+      } while (code);
+    }
+    return n;
+  }
+
+  // Unpack into z_values. False, with z_values untouched, if the data is short or runs over.
+  bool bed_level_unpack(const uint8_t * const in, const uint16_t len) {
+    int32_t q[GRID_MAX_POINTS_X][GRID_MAX_POINTS_Y];
+    uint16_t n = 0;
+    LOOP_L_N(y, GRID_MAX_POINTS_Y) LOOP_L_N(x, GRID_MAX_POINTS_X) {
+      uint32_t code = 0;
+      for (uint8_t shift = 0; ; shift += 7) {
+        if (n >= len || shift > 28) return false;
+        const uint8_t b = in[n++];
+        code |= uint32_t(b & 0x7F) << shift;
+        if (!(b & 0x80)) break;
+      }
+      if (code) {
+        --code;
+        q[x][y] = mesh_guess(q, x, y) + int32_t((code >> 1) ^ -(code & 1));
+      }
+      else
+        q[x][y] = MESH_PACK_NAN;
+    }
+    if (n != len) return false;
+    GRID_LOOP(x, y) {
+      z_values[x][y] = q[x][y] == MESH_PACK_NAN ? NAN : q[x][y] * 0.001f;
+      TERN_(EXTENSIBLE_UI, ExtUI::onMeshUpdate(x, y, z_values[x][y]));
+    }
+    return true;
+  }
+
+#endif // ABL_MESH_SLOTS
+
 #if ENABLED(ABL_BILINEAR_SUBDIVISION)
   #define ABL_BG_SPACING(A) bilinear_grid_spacing_virt.A
   #define ABL_BG_FACTOR(A)  bilinear_grid_factor_virt.A
@@ -270,6 +423,10 @@ void refresh_bed_level() {
 // Get the Z adjustment for non-linear bed leveling
 float bilinear_z_offset(const xy_pos_t &raw) {
 
+  #if ENABLED(ABL_BICUBIC)
+    if (bicubic_valid) return bicubic_z_offset(raw);
+  #endif
+
   static float z1, d2, z3, d4, L, D;
 
   static xy_pos_t prev={ -999.999, -999.999 }, ratio;
@@ -35,6 +35,13 @@ void refresh_bed_level();
   void print_bilinear_leveling_grid_virt();
   void bed_level_virt_interpolate();
 #endif
+#if ENABLED(ABL_BICUBIC)
+  void bed_level_bicubic_patches();
+#endif
+#if ENABLED(ABL_MESH_SLOTS)
+  uint16_t bed_level_pack(uint8_t * const out, const uint16_t size);
+  bool bed_level_unpack(const uint8_t * const in, const uint16_t len);
+#endif
 
 #if IS_CARTESIAN && DISABLED(SEGMENT_LEVELED_MOVES)
   void bilinear_line_to_destination(const feedRate_t &scaled_fr_mm_s, uint16_t x_splits=0xFFFF, uint16_t y_splits=0xFFFF);
@@ -0,0 +1,122 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * feature/fopdt.cpp - First-order-plus-dead-time heater identification
+ *
+ * Past the dead time the model obeys  dx/dt = (K * u - x) / tau
+ * with x = T - T0, so a line fitted to (x, dx/dt) gives 1/tau from
+ * its slope and K * u / tau from its intercept. Only samples after the
+ * steepest point are used, which keeps the dead-time lag out of the fit.
+ * The dead time is where the tangent at the steepest point crosses T0.
+ */
+
+#include "../inc/MarlinConfigPre.h"
+
+#if ENABLED(PID_AUTOTUNE_FAST)
+
+#include "fopdt.h"
+
+#define FOPDT_TAU_MAX     3600.0f   // (s) Treat slower heaters as integrating
+#define FOPDT_MIN_POINTS  4
+#define FOPDT_SIM_STEP_MS 50
+
+void FOPDTFit::start(const float t0, const float step, const uint16_t period) {
+  T0 = t0;
+  u = step;
+  period_ms = period;
+  max_slope = max_slope_t = max_slope_x = 0;
+  sx = sy = sxx = sxy = 0;
+  n = count = 0;
+  next_ms = 0;
+}
+
+void FOPDTFit::sample(const millis_t ms, const float T) {
+  if (ms < next_ms) return;
+  next_ms = ms + period_ms;
+
+  const float t = ms * 0.001f, x = T - T0;
+  if (count >= 2) {
+    // Central difference about the middle sample
+    const float slope = (x - prev_x[0]) / (t - prev_t[0]);
+    if (slope > max_slope) {
+      max_slope = slope;
+      max_slope_t = prev_t[1];
+      max_slope_x = prev_x[1];
+      sx = sy = sxx = sxy = 0;
+      n = 0;
+    }
+    sx += prev_x[1];
+    sy += slope;
+    sxx += sq(prev_x[1]);
+    sxy += prev_x[1] * slope;
+    n++;
+  }
+  prev_t[0] = prev_t[1]; prev_x[0] = prev_x[1];
+  prev_t[1] = t;         prev_x[1] = x;
+  if (count < 2) count++;
+}
+
+bool FOPDTFit::fit(fopdt_model_t &m) const {
+  if (n < FOPDT_MIN_POINTS || max_slope <= 0 || u <= 0) return false;
+
+  const float mx = sx / n, my = sy / n,
+              vxx = sxx / n - sq(mx),
+              vxy = sxy / n - mx * my,
+              b = vxx > 0 ? -vxy / vxx : 0;
+
+  m.L = _MAX(max_slope_t - max_slope_x / max_slope, period_ms * 0.001f);
+
+  if (b > 1.0f / FOPDT_TAU_MAX) {
+    m.tau = 1.0f / b;
+    m.K = (my + b * mx) * m.tau / u;
+  }
+  else {
+    // Too little curvature to see the losses
+    m.tau = FOPDT_TAU_MAX;
+    m.K = max_slope * m.tau / u;
+  }
+  return m.K > 0;
+}
+
+void FOPDTFit::simulate(const fopdt_model_t &plant, const float target) {
+  float x = 0;
+  for (millis_t ms = 0; T0 + x < target && ms < SEC_TO_MS(FOPDT_TAU_MAX); ms += FOPDT_SIM_STEP_MS) {
+    const float drive = ms * 0.001f >= plant.L ? plant.K * u : 0;
+    x += (drive - x) * (FOPDT_SIM_STEP_MS * 0.001f) / plant.tau;
+    sample(ms, T0 + LROUND(x * 10) * 0.1f); // Quantize like a real reading
+  }
+}
+
+fopdt_gains_t FOPDTFit::gains(const fopdt_model_t &m, const float lambda) {
+  const float L = m.L, tau = m.tau, lc = lambda * L;
+  fopdt_gains_t g;
+  g.Kp = (2 * tau + L) / (2 * m.K * (lc + L));
+  // Cap the integral time so lag-dominant heaters still reject disturbances
+  const float Ti = _MIN(tau + L * 0.5f, 4 * (lc + L)),
+              Td = tau * L / (2 * tau + L);
+  g.Ki = g.Kp / Ti;
+  g.Kd = g.Kp * Td;
+  return g;
+}
+
+#endif // PID_AUTOTUNE_FAST
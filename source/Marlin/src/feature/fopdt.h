@@ -0,0 +1,68 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * feature/fopdt.h - First-order-plus-dead-time heater identification
+ *
+ * Fits the heating step response of a heater to
+ *   T(t) = T0 + K * u * (1 - e^(-(t - L) / tau))
+ * and derives PID gains from the model. There is no hardware access here,
+ * so the same code runs against the real heater or the simulated plant.
+ */
+
+#include "../inc/MarlinConfig.h"
+
+typedef struct {
+  float K,      // (°C per PID count) Steady-state gain
+        tau,    // (s) Time constant
+        L;      // (s) Dead time
+} fopdt_model_t;
+
+typedef struct { float Kp, Ki, Kd; } fopdt_gains_t;
+
+class FOPDTFit {
+public:
+  // Begin a step of 'u' PID counts from temperature T0, sampling every 'period_ms'
+  void start(const float T0, const float u, const uint16_t period_ms);
+
+  // Feed a temperature reading taken 'ms' after the step began
+  void sample(const millis_t ms, const float T);
+
+  // Fit the model to the samples so far. False if there is too little data.
+  bool fit(fopdt_model_t &m) const;
+
+  // Step the given plant from T0 to 'target' and feed this fitter as it goes
+  void simulate(const fopdt_model_t &plant, const float target);
+
+  // IMC tuning. 'lambda' is the closed-loop time constant in dead times.
+  static fopdt_gains_t gains(const fopdt_model_t &m, const float lambda);
+
+private:
+  float T0, u,
+        prev_t[2], prev_x[2],   // Last two samples, relative to T0
+        max_slope,              // Steepest slope seen (°C/s)
+        max_slope_t, max_slope_x,
+        sx, sy, sxx, sxy;       // Regression sums past the steepest point
+  uint16_t period_ms, n, count;
+  millis_t next_ms;
+};
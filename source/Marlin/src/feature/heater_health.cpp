@@ -0,0 +1,147 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * feature/heater_health.cpp - Model-based heater fault detection
+ *
+ * Over each window the heater's thermal model must balance:
+ *   applied = lost + stored + load
+ *   applied = P * pwm                     (P scaled by supply voltage)
+ *   lost    = k * avg(T - Tamb)
+ *   stored  = C * (T_end - T_start) / window
+ * 'load' is heat taken by things the model leaves out, such as filament
+ * and part cooling. It is learned slowly near steady state and bounded,
+ * so a high-flow print shifts the balance without tripping it. What is left
+ * over is heat that went missing (or appeared from nowhere), which a real
+ * fault makes large within a window or two.
+ */
+
+#include "../inc/MarlinConfigPre.h"
+
+#if ENABLED(HEATER_HEALTH_CHECK)
+
+#include "heater_health.h"
+
+HeaterHealth heater_health;
+
+#define HEALTH_AMBIENT    25.0f   // (°C) Assumed ambient unless a heater reads cooler
+#define HEALTH_MAX_GAP     2.0f   // (s) Restart the window after a longer pause between samples
+#define HEALTH_STEADY      2.0f   // (°C) Learn the load only when a window changes less than this
+#define HEALTH_LEARN_RATE 0.25f   // Share of the residual added to the load per window
+
+typedef struct {
+  float t0,             // (°C) Temperature at the window start
+        joules,         // (J) Energy applied in the window
+        kelvin_seconds, // (K*s) Integral of (T - Tamb) over the window
+        load;           // (W) Learned load outside the model
+  millis_t start_ms, last_ms;
+  uint8_t strikes;
+  bool started;
+} health_state_t;
+
+static health_state_t state[HEALTH_COUNT];
+static float ambient = HEALTH_AMBIENT;
+
+static const heater_model_t& model_for(const uint8_t index) {
+  static constexpr heater_model_t hotend_model = HOTEND_THERMAL_MODEL;
+  #if HAS_HEATED_BED
+    static constexpr heater_model_t bed_model = BED_THERMAL_MODEL;
+    if (index == HEALTH_INDEX_BED) return bed_model;
+  #else
+    UNUSED(index);
+  #endif
+  return hotend_model;
+}
+
+static inline float window_for(const uint8_t index) {
+  #if HAS_HEATED_BED
+    if (index == HEALTH_INDEX_BED) return HEATER_HEALTH_BED_WINDOW;
+  #else
+    UNUSED(index);
+  #endif
+  return HEATER_HEALTH_WINDOW;
+}
+
+static void start_window(health_state_t &s, const float celsius, const millis_t ms) {
+  s.t0 = celsius;
+  s.joules = s.kelvin_seconds = 0;
+  s.start_ms = ms;
+  s.started = true;
+}
+
+void HeaterHealth::reset() {
+  ZERO(state);
+  ambient = HEALTH_AMBIENT;
+}
+
+HeaterHealth::Verdict HeaterHealth::update(const uint8_t index, const float celsius, const uint8_t pwm, const millis_t ms) {
+  health_state_t &s = state[index];
+
+  const float dt = (ms - s.last_ms) * 0.001f;
+  s.last_ms = ms;
+  if (!s.started || dt > HEALTH_MAX_GAP) {
+    start_window(s, celsius, ms);
+    return HEALTH_OK;
+  }
+
+  NOMORE(ambient, celsius);
+
+  const heater_model_t &m = model_for(index);
+  const float full = m.watts * thermalManager.heater_supply_scale();
+  s.joules += full * pwm * (1.0f / 127) * dt;
+  s.kelvin_seconds += (celsius - ambient) * dt;
+
+  const float span = (ms - s.start_ms) * 0.001f;
+  if (span < window_for(index)) return HEALTH_OK;
+
+  // Power balance over the window, in watts. Positive residual is missing heat.
+  const float applied = s.joules / span,
+              lost = m.loss * s.kelvin_seconds / span,
+              stored = m.capacity * (celsius - s.t0) / span,
+              residual = applied - lost - stored - s.load;
+
+  // The load may stop at any time (e.g., a travel move) so only let it relax each test
+  Verdict verdict = HEALTH_OK;
+  if (applied > (HEATER_HEALTH_MIN_POWER) * full && residual + _MIN(s.load, 0) > (HEATER_HEALTH_MISSING) * applied)
+    verdict = HEALTH_HEAT_MISSING;
+  else if (-(residual + _MAX(s.load, 0)) > (HEATER_HEALTH_EXCESS) * full)
+    verdict = HEALTH_HEAT_EXCESS;
+
+  #if ENABLED(HEATER_HEALTH_DEBUG)
+    SERIAL_ECHOLNPAIR("Health ", int(index), " P:", applied, " loss:", lost, " stored:", stored, " load:", s.load, " r:", residual);
+  #endif
+
+  if (verdict == HEALTH_OK) {
+    s.strikes = 0;
+    if (ABS(celsius - s.t0) < HEALTH_STEADY) {
+      const float limit = (HEATER_HEALTH_MAX_LOAD) * full;
+      s.load = constrain(s.load + residual * (HEALTH_LEARN_RATE), -limit, limit);
+    }
+  }
+  else if (s.strikes < HEATER_HEALTH_STRIKES && ++s.strikes < HEATER_HEALTH_STRIKES)
+    verdict = HEALTH_OK;
+
+  start_window(s, celsius, ms);
+  return verdict;
+}
+
+#endif // HEATER_HEALTH_CHECK
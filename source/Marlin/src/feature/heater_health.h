@@ -0,0 +1,49 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * feature/heater_health.h - Model-based heater fault detection
+ */
+
+#include "../inc/MarlinConfig.h"
+#include "../module/temperature.h"
+
+#define HEALTH_INDEX_BED HOTENDS
+#define HEALTH_COUNT (HOTENDS + ENABLED(HAS_HEATED_BED))
+
+class HeaterHealth {
+public:
+  enum Verdict : uint8_t { HEALTH_OK, HEALTH_HEAT_MISSING, HEALTH_HEAT_EXCESS };
+
+  /**
+   * Add one sample for a heater (hotend index or HEALTH_INDEX_BED) with the
+   * PWM applied since the previous sample. At the end of each window, check
+   * the power balance and return a fault once it has persisted.
+   */
+  static Verdict update(const uint8_t index, const float celsius, const uint8_t pwm, const millis_t ms);
+
+  // Forget the learned loads and open windows, e.g., when all heaters go off
+  static void reset();
+};
+
+extern HeaterHealth heater_health;
@@ -0,0 +1,342 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * feature/plr_journal.cpp - Append-only power-loss journal in internal flash
+ *
+ * Recovery records are appended to pre-erased 16-byte slots in a ring of
+ * flash sectors. A save writes a delta of the fields that change while
+ * printing, or a full snapshot when anything else changed. The first record
+ * in each sector is a snapshot or a clear, so the older sector never holds
+ * the base of a newer delta and can be erased at any time.
+ *
+ * Erasing stalls the CPU for the duration, so the next sector is erased from
+ * idle() while the planner is empty, or once the active sector is 3/4 full.
+ * A save only waits on an erase if the ring fills before that happens.
+ *
+ * With POWER_LOSS_BROWNOUT the slots for one delta stay free at the end of
+ * the active sector, so the ADC watchdog ISR can always write the delta armed
+ * by the main loop without an erase. If the ISR comes while anything holds the
+ * flash (a save, an erase, a settings write) the checkpoint is written as soon
+ * as the flash is released.
+ */
+
+#include "../inc/MarlinConfig.h"
+
+#if ENABLED(POWER_LOSS_JOURNAL)
+
+#include "plr_journal.h"
+#include "../module/planner.h"
+#include "../libs/crc16.h"
+#include "flash.h"
+
+#define JOURNAL_MAGIC   0x4A50                                // "PJ"
+#define JOURNAL_SLOT    16                                    // (bytes) Record granularity
+#define SECTOR_SLOTS    (FLASH_SECTOR_SIZE / JOURNAL_SLOT)
+#define SLOTS_FOR(L)    ((sizeof(rec_head_t) + (L) + JOURNAL_SLOT - 1) / JOURNAL_SLOT)
+#define DELTA_SLOTS     SLOTS_FOR(sizeof(rec_delta_t))
+#define RESERVED_SLOTS  TERN0(POWER_LOSS_BROWNOUT, DELTA_SLOTS) // Kept free for a brown-out checkpoint
+
+PLRJournal plr_journal;
+
+bool PLRJournal::mounted, // = false
+     PLRJournal::has_base, PLRJournal::next_blank;
+uint8_t PLRJournal::active, PLRJournal::last_type;
+uint16_t PLRJournal::wr_slot;
+uint32_t PLRJournal::seq, PLRJournal::snap_addr, PLRJournal::delta_addr;
+uint16_t PLRJournal::saved, PLRJournal::erased, PLRJournal::stalls;
+job_recovery_info_t PLRJournal::base;
+
+#if ENABLED(POWER_LOSS_BROWNOUT)
+  volatile bool PLRJournal::pending;
+  volatile int8_t PLRJournal::armed = -1;
+  uint32_t PLRJournal::pending_sdpos;
+  PLRJournal::rec_delta_t PLRJournal::ready[2];
+#endif
+
+static inline uint8_t next_sector(const uint8_t s) { return (s + 1) % (FLASH_PLR_JOURNAL_SECTORS); }
+static inline uint32_t sector_addr(const uint8_t s) { return FLASH_PLR_JOURNAL_BASE + uint32_t(s) * FLASH_SECTOR_SIZE; }
+static inline uint32_t slot_addr(const uint8_t s, const uint16_t slot) { return sector_addr(s) + uint32_t(slot) * JOURNAL_SLOT; }
+
+// True if all flash from addr to the end of its sector is erased
+static bool is_blank(uint32_t addr) {
+  const uint32_t end = (addr & ~(FLASH_SECTOR_SIZE - 1)) + FLASH_SECTOR_SIZE;
+  for (; addr < end; addr += 4) if (*(const uint32_t*)addr != 0xFFFFFFFFUL) return false;
+  return true;
+}
+
+uint16_t PLRJournal::crc(const rec_head_t &h, const void * const data) {
+  uint16_t c = 0;
+  crc16(&c, &h, offsetof(rec_head_t, crc));
+  crc16(&c, data, h.len);
+  return c;
+}
+
+/**
+ * Find the newest snapshot and delta, the newest record's sector, and
+ * where the next record goes. A sector holding anything but records is
+ * treated as full so it's erased before use.
+ */
+void PLRJournal::mount() {
+  #if ENABLED(POWER_LOSS_BROWNOUT)
+    disarm();
+    Intflash::FlashSetReleaseCallback(flash_released);
+  #endif
+  mounted = true;
+  has_base = false;
+  active = 0;
+  last_type = REC_CLEAR;
+  snap_addr = delta_addr = 0;
+
+  bool any = false;
+  uint32_t newest = 0, snap_seq = 0, delta_seq = 0, clear_seq = 0;
+  uint16_t used[FLASH_PLR_JOURNAL_SECTORS];
+
+  LOOP_L_N(s, FLASH_PLR_JOURNAL_SECTORS) {
+    uint16_t slot = 0;
+    while (slot < SECTOR_SLOTS) {
+      const uint32_t addr = slot_addr(s, slot);
+      if (*(const uint32_t*)addr == 0xFFFFFFFFUL) break;      // End of the records
+
+      const rec_head_t &h = *(const rec_head_t*)addr;
+      if (h.magic != JOURNAL_MAGIC || !h.slots || h.slots > SECTOR_SLOTS - slot) {
+        slot = SECTOR_SLOTS;
+        break;
+      }
+
+      // A record cut short by a power loss fails the CRC and is skipped
+      if (h.len <= h.slots * JOURNAL_SLOT - sizeof(rec_head_t) && h.crc == crc(h, (const void*)(addr + sizeof(rec_head_t)))) {
+        if (!any || h.seq > newest) { any = true; newest = h.seq; active = s; last_type = h.type; }
+        switch (h.type) {
+          case REC_SNAPSHOT: if (!snap_addr  || h.seq > snap_seq)  { snap_addr = addr;  snap_seq = h.seq;  } break;
+          case REC_DELTA:    if (!delta_addr || h.seq > delta_seq) { delta_addr = addr; delta_seq = h.seq; } break;
+          case REC_CLEAR:    NOLESS(clear_seq, h.seq); break;
+        }
+      }
+      slot += h.slots;
+    }
+    used[s] = slot;
+  }
+
+  // A clear voids older snapshots, and a delta only applies to the snapshot before it
+  if (snap_addr && snap_seq < clear_seq) snap_addr = 0;
+  if (!snap_addr || delta_seq < snap_seq) delta_addr = 0;
+
+  seq = newest + 1;
+  wr_slot = used[active];
+  if (!is_blank(slot_addr(active, wr_slot))) wr_slot = SECTOR_SLOTS;
+  next_blank = is_blank(sector_addr(next_sector(active)));
+}
+
+/**
+ * Rebuild the newest saved state from its snapshot and the delta after it
+ */
+bool PLRJournal::load(job_recovery_info_t &dest) {
+  mount();
+
+  // A snapshot of another size was saved by another firmware
+  if (!snap_addr || ((const rec_head_t*)snap_addr)->len != sizeof(dest)) return false;
+
+  memcpy(&dest, (const void*)(snap_addr + sizeof(rec_head_t)), sizeof(dest));
+
+  if (delta_addr && ((const rec_head_t*)delta_addr)->len == sizeof(rec_delta_t)) {
+    rec_delta_t d;
+    memcpy(&d, (const void*)(delta_addr + sizeof(rec_head_t)), sizeof(d));
+    apply_delta(dest, d);
+  }
+  return true;
+}
+
+void PLRJournal::make_delta(rec_delta_t &d, const job_recovery_info_t &src) {
+  d.sdpos = src.sdpos;
+  d.print_job_elapsed = src.print_job_elapsed;
+  d.current_position = src.current_position;
+  d.feedrate = src.feedrate;
+  TERN_(HAS_HOTEND, COPY(d.target_temperature, src.target_temperature));
+  TERN_(HAS_HEATED_BED, d.target_temperature_bed = src.target_temperature_bed);
+  TERN_(HAS_FAN, COPY(d.fan_speed, src.fan_speed));
+  d.print_progress = src.print_progress;
+  d.valid = src.valid_head;
+}
+
+void PLRJournal::apply_delta(job_recovery_info_t &dest, const rec_delta_t &d) {
+  dest.sdpos = d.sdpos;
+  dest.print_job_elapsed = d.print_job_elapsed;
+  dest.current_position = d.current_position;
+  dest.feedrate = d.feedrate;
+  TERN_(HAS_HOTEND, COPY(dest.target_temperature, d.target_temperature));
+  TERN_(HAS_HEATED_BED, dest.target_temperature_bed = d.target_temperature_bed);
+  TERN_(HAS_FAN, COPY(dest.fan_speed, d.fan_speed));
+  dest.print_progress = d.print_progress;
+  dest.valid_head = dest.valid_foot = d.valid;
+}
+
+/**
+ * Save the given state, as a delta if only the printing fields
+ * changed since the last snapshot and the delta fits in this sector
+ */
+bool PLRJournal::append(const job_recovery_info_t &src) {
+  if (!mounted) mount();
+
+  // Work on one copy since the stepper ISR updates sdpos
+  job_recovery_info_t now;
+  memcpy(&now, &src, sizeof(now));
+
+  Intflash::FlashClaim();                         // Keep the ISR out until the record is done
+
+  bool ok = false, done = false;
+  if (has_base && wr_slot + DELTA_SLOTS <= SECTOR_SLOTS - RESERVED_SLOTS) {
+    rec_delta_t d;
+    make_delta(d, now);
+    job_recovery_info_t rebuilt;
+    memcpy(&rebuilt, &base, sizeof(rebuilt));
+    apply_delta(rebuilt, d);
+    if (!memcmp(&rebuilt, &now, sizeof(now))) {
+      ok = write(REC_DELTA, &d, sizeof(d));
+      done = true;
+    }
+  }
+
+  if (!done) {
+    memcpy(&base, &now, sizeof(base));
+    ok = has_base = write(REC_SNAPSHOT, &base, sizeof(base));
+    TERN_(POWER_LOSS_BROWNOUT, arm(now));         // Rebase a pending checkpoint on the new snapshot
+  }
+
+  Intflash::FlashRelease();
+  return ok;
+}
+
+void PLRJournal::clear() {
+  if (!mounted) mount();
+  TERN_(POWER_LOSS_BROWNOUT, disarm());
+  has_base = false;
+  if (last_type != REC_CLEAR) {
+    Intflash::FlashClaim();
+    write(REC_CLEAR, nullptr, 0);
+    Intflash::FlashRelease();
+  }
+}
+
+/**
+ * Program one record into the erased slots after the last,
+ * moving to the next sector when this one is full
+ */
+bool PLRJournal::write(const uint8_t type, const void * const data, const uint16_t len, const bool reserved/*=false*/) {
+  static_assert(SLOTS_FOR(sizeof(job_recovery_info_t)) <= SECTOR_SLOTS / 4, "job_recovery_info_t is too large for the power-loss journal.");
+  static uint32_t buf[SLOTS_FOR(sizeof(job_recovery_info_t)) * JOURNAL_SLOT / 4];
+
+  const uint8_t slots = SLOTS_FOR(len);
+  if (wr_slot + slots > SECTOR_SLOTS - (reserved ? 0 : RESERVED_SLOTS)) {
+    if (reserved) return false;                   // No erasing from the ISR
+    if (!next_blank) { erase_next(); ++stalls; }
+    active = next_sector(active);
+    wr_slot = 0;
+    next_blank = false;
+  }
+
+  rec_head_t &h = *(rec_head_t*)buf;
+  h.magic = JOURNAL_MAGIC;
+  h.type = type;
+  h.slots = slots;
+  h.seq = seq++;
+  h.len = len;
+  h.crc = crc(h, data);
+  if (len) memcpy(&h + 1, data, len);
+
+  // Skip the slots of a failed record rather than program over them
+  const uint32_t addr = slot_addr(active, wr_slot);
+  wr_slot += slots;
+  if (Intflash::FlashProgram(addr, buf, (sizeof(rec_head_t) + len + 3) & ~3) != Ok) return false;
+
+  last_type = type;
+  ++saved;
+  return true;
+}
+
+void PLRJournal::erase_next() {
+  Intflash::FlashClaim();
+  const uint32_t addr = sector_addr(next_sector(active));
+  next_blank = Intflash::FlashErasePage(addr) == Ok && is_blank(addr);
+  ++erased;
+  Intflash::FlashRelease();
+}
+
+void PLRJournal::task() {
+  if (!mounted) mount();
+  if (next_blank) return;
+  if (planner.has_blocks_queued() && wr_slot < SECTOR_SLOTS * 3 / 4) return;
+  erase_next();
+}
+
+void PLRJournal::report() {
+  SERIAL_ECHOLNPAIR("PLR journal sector:", active, " slot:", wr_slot, "/", SECTOR_SLOTS,
+    " saved:", saved, " erased:", erased, " stalls:", stalls);
+}
+
+#if ENABLED(POWER_LOSS_BROWNOUT)
+
+  /**
+   * Build the delta a brown-out would write. A state that needs
+   * a new snapshot isn't armed until save() has written one.
+   */
+  void PLRJournal::arm(const job_recovery_info_t &src) {
+    if (!mounted || !has_base) return disarm();
+
+    job_recovery_info_t now, rebuilt;
+    memcpy(&now, &src, sizeof(now));
+
+    const int8_t i = armed == 0 ? 1 : 0;          // Fill the copy the ISR isn't using
+    make_delta(ready[i], now);
+    memcpy(&rebuilt, &base, sizeof(rebuilt));
+    apply_delta(rebuilt, ready[i]);
+    armed = memcmp(&rebuilt, &now, sizeof(now)) ? -1 : i;
+  }
+
+  // From the ADC watchdog ISR
+  bool PLRJournal::checkpoint(const uint32_t sdpos) {
+    if (armed < 0) return false;
+    pending_sdpos = sdpos;
+    if (Intflash::FlashBusy()) { pending = true; return true; }
+    return write_checkpoint();
+  }
+
+  bool PLRJournal::write_checkpoint() {
+    const int8_t i = armed;
+    if (i < 0) return false;
+    rec_delta_t d = ready[i];
+    d.sdpos = pending_sdpos;
+    return write(REC_DELTA, &d, sizeof(d), true);
+  }
+
+  // Nothing holds the flash now. Write a checkpoint the ISR left waiting.
+  void PLRJournal::flash_released() {
+    if (!pending) return;
+    pending = false;
+    Intflash::FlashClaim();
+    write_checkpoint();
+    Intflash::FlashRelease();
+  }
+
+#endif // POWER_LOSS_BROWNOUT
+
+#endif // POWER_LOSS_JOURNAL
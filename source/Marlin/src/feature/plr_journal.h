@@ -0,0 +1,101 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * feature/plr_journal.h - Append-only power-loss journal in internal flash
+ */
+
+#include "powerloss.h"
+
+class PLRJournal {
+public:
+  static bool load(job_recovery_info_t &dest);  // Rebuild the newest saved state. False if there is none.
+  static bool append(const job_recovery_info_t &src);
+  static void clear();                          // Invalidate the saved state
+
+  // Erase the next sector ahead of need. Called from idle().
+  static void task();
+
+  static void report();
+
+  #if ENABLED(POWER_LOSS_BROWNOUT)
+    // A delta built ahead in the main loop and written from the ADC watchdog ISR
+    static void arm(const job_recovery_info_t &src);
+    static inline void disarm() { armed = -1; }
+    static bool checkpoint(const uint32_t sdpos);
+  #endif
+
+private:
+  enum : uint8_t { REC_SNAPSHOT = 1, REC_DELTA, REC_CLEAR };
+
+  typedef struct {
+    uint16_t magic;
+    uint8_t type, slots;
+    uint32_t seq;
+    uint16_t len, crc;
+  } rec_head_t;
+
+  // The recovery fields that change while printing
+  typedef struct {
+    uint32_t sdpos;
+    millis_t print_job_elapsed;
+    xyze_pos_t current_position;
+    uint16_t feedrate;
+    #if HAS_HOTEND
+      int16_t target_temperature[HOTENDS];
+    #endif
+    #if HAS_HEATED_BED
+      int16_t target_temperature_bed;
+    #endif
+    #if HAS_FAN
+      uint8_t fan_speed[FAN_COUNT];
+    #endif
+    uint8_t print_progress, valid;
+  } rec_delta_t;
+
+  static bool mounted, has_base, next_blank;
+  static uint8_t active, last_type;
+  static uint16_t wr_slot;
+  static uint32_t seq, snap_addr, delta_addr;
+  static uint16_t saved, erased, stalls;
+  static job_recovery_info_t base;              // Last snapshot written, deltas are relative to it
+
+  #if ENABLED(POWER_LOSS_BROWNOUT)
+    static volatile bool pending;               // A checkpoint waits for the flash
+    static volatile int8_t armed;               // Index of the ready delta, -1 for none
+    static uint32_t pending_sdpos;
+    static rec_delta_t ready[2];
+    static bool write_checkpoint();
+    static void flash_released();
+  #endif
+
+  static void mount();
+  static uint16_t crc(const rec_head_t &h, const void * const data);
+  static bool write(const uint8_t type, const void * const data, const uint16_t len, const bool reserved=false);
+  static void erase_next();
+
+  static void make_delta(rec_delta_t &d, const job_recovery_info_t &src);
+  static void apply_delta(job_recovery_info_t &dest, const rec_delta_t &d);
+};
+
+extern PLRJournal plr_journal;
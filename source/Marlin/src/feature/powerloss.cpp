@@ -47,6 +47,10 @@
 #include "babystep.h"
 #endif
 
+#if ENABLED(POWER_LOSS_JOURNAL)
+  #include "plr_journal.h"
+#endif
+
 bool PrintJobRecovery::enabled; // Initialized by settings.load()
 
 SdFile PrintJobRecovery::file;
@@ -144,10 +148,14 @@ void PrintJobRecovery::purge() {
 	  card.removeJobRecoveryFile();
 #endif
 	
+#if ENABLED(POWER_LOSS_JOURNAL)
+	  plr_journal.clear();
+#else
 	  if(info.valid_head != 0xFF || info.valid_foot != 0xFF) {
 		if(persistentStore.FLASH_If_Erase(FLASH_OUTAGE_DATA_ADDR, FLASH_OUTAGE_DATA_ADDR+0x400) != FLASHIF_OK) {
 		}
 	  }
+#endif
 	
 	  memset(&info, 0, sizeof(info));	// init();
 
@@ -157,7 +165,11 @@ void PrintJobRecovery::purge() {
  * Load the recovery data, if it exists
  */
 void PrintJobRecovery::load() {
+  #if ENABLED(POWER_LOSS_JOURNAL)
+    if (!plr_journal.load(info)) init();
+  #else
      memcpy(&info, (uint8_t *)(FLASH_OUTAGE_DATA_ADDR), sizeof(info));
+  #endif
 }
 
 /**
@@ -168,6 +180,67 @@ void PrintJobRecovery::prepare() {
   cmd_sdpos = 0;
 }
 
+/**
+ * Copy the current machine state into the given recovery info
+ */
+void PrintJobRecovery::capture(job_recovery_info_t &dest, const float zraise) {
+  // Machine state
+  dest.current_position = current_position;
+  dest.feedrate = uint16_t(MMS_TO_MMM(feedrate_mm_s));
+  dest.zraise = zraise;
+
+  TERN_(GCODE_REPEAT_MARKERS, dest.stored_repeat = repeat);
+  TERN_(HAS_HOME_OFFSET, dest.home_offset = home_offset);
+  TERN_(HAS_POSITION_SHIFT, dest.position_shift = position_shift);
+
+  #if HAS_MULTI_EXTRUDER
+    dest.active_extruder = active_extruder;
+  #endif
+
+  #if DISABLED(NO_VOLUMETRICS)
+    dest.volumetric_enabled = parser.volumetric_enabled;
+    #if HAS_MULTI_EXTRUDER
+      for (int8_t e = 0; e < EXTRUDERS; e++) dest.filament_size[e] = planner.filament_size[e];
+    #else
+      if (parser.volumetric_enabled) dest.filament_size[0] = planner.filament_size[active_extruder];
+    #endif
+  #endif
+
+  #if EXTRUDERS
+    HOTEND_LOOP() dest.target_temperature[e] = thermalManager.temp_hotend[e].target;
+  #endif
+
+  TERN_(HAS_HEATED_BED, dest.target_temperature_bed = thermalManager.temp_bed.target);
+
+  #if HAS_FAN
+    COPY(dest.fan_speed, thermalManager.fan_speed);
+  #endif
+
+  #if HAS_LEVELING
+    dest.flag.leveling = planner.leveling_active;
+    dest.fade = TERN0(ENABLE_LEVELING_FADE_HEIGHT, planner.z_fade_height);
+  #endif
+
+  TERN_(GRADIENT_MIX, memcpy(&dest.gradient, &mixer.gradient, sizeof(dest.gradient)));
+
+  #if ENABLED(FWRETRACT)
+    COPY(dest.retract, fwretract.current_retract);
+    dest.retract_hop = fwretract.current_hop;
+  #endif
+
+  // Elapsed print job time
+  dest.print_job_elapsed = print_job_timer.duration();
+
+  dest.print_progress = card.percentDone();
+
+  // Relative axis modes
+  dest.axis_relative = gcode.axis_relative;
+
+  // Misc. Marlin flags
+  dest.flag.dryrun = !!(marlin_debug_flags & MARLIN_DEBUG_DRYRUN);
+  dest.flag.allow_cold_extrusion = TERN0(PREVENT_COLD_EXTRUSION, thermalManager.allow_cold_extrude);
+}
+
 /**
  * Save the current machine state to the power-loss recovery file
  */
@@ -178,6 +251,10 @@ void PrintJobRecovery::save(const bool force/*=false*/, const float zraise/*=0*/
     millis_t ms = millis();
   #endif
 
+  #if POWER_LOSS_JOURNAL_CMDS
+    static uint16_t unsaved_cmds; // = 0
+  #endif
+
   #ifndef POWER_LOSS_MIN_Z_CHANGE
     #define POWER_LOSS_MIN_Z_CHANGE 0.05  // Vase-mode-friendly out of the box
   #endif
@@ -190,9 +267,17 @@ void PrintJobRecovery::save(const bool force/*=false*/, const float zraise/*=0*/
       #endif
       // Save if Z is above the last-saved position by some minimum height
       || current_position.z > info.current_position.z + POWER_LOSS_MIN_Z_CHANGE
+      #if POWER_LOSS_JOURNAL_CMDS
+        // Save after some number of extruding moves
+        || ++unsaved_cmds >= POWER_LOSS_JOURNAL_CMDS
+      #endif
     #endif
   ) {
 
+    #if POWER_LOSS_JOURNAL_CMDS
+      unsaved_cmds = 0;
+    #endif
+
     #if SAVE_INFO_INTERVAL_MS > 0
       next_save_ms = ms + SAVE_INFO_INTERVAL_MS;
     #endif
@@ -203,61 +288,7 @@ void PrintJobRecovery::save(const bool force/*=false*/, const float zraise/*=0*/
     info.valid_foot = info.valid_head;
 //	SERIAL_ECHOLNPAIR("head=", info.valid_head,"foot=", info.valid_foot);
 
-    // Machine state
-    info.current_position = current_position;
-    info.feedrate = uint16_t(MMS_TO_MMM(feedrate_mm_s));
-    info.zraise = zraise;
-
-    TERN_(GCODE_REPEAT_MARKERS, info.stored_repeat = repeat);
-    TERN_(HAS_HOME_OFFSET, info.home_offset = home_offset);
-    TERN_(HAS_POSITION_SHIFT, info.position_shift = position_shift);
-
-    #if HAS_MULTI_EXTRUDER
-      info.active_extruder = active_extruder;
-    #endif
-
-    #if DISABLED(NO_VOLUMETRICS)
-      info.volumetric_enabled = parser.volumetric_enabled;
-      #if HAS_MULTI_EXTRUDER
-        for (int8_t e = 0; e < EXTRUDERS; e++) info.filament_size[e] = planner.filament_size[e];
-      #else
-        if (parser.volumetric_enabled) info.filament_size[0] = planner.filament_size[active_extruder];
-      #endif
-    #endif
-
-    #if EXTRUDERS
-      HOTEND_LOOP() info.target_temperature[e] = thermalManager.temp_hotend[e].target;
-    #endif
-
-    TERN_(HAS_HEATED_BED, info.target_temperature_bed = thermalManager.temp_bed.target);
-
-    #if HAS_FAN
-      COPY(info.fan_speed, thermalManager.fan_speed);
-    #endif
-
-    #if HAS_LEVELING
-      info.flag.leveling = planner.leveling_active;
-      info.fade = TERN0(ENABLE_LEVELING_FADE_HEIGHT, planner.z_fade_height);
-    #endif
-
-    TERN_(GRADIENT_MIX, memcpy(&info.gradient, &mixer.gradient, sizeof(info.gradient)));
-
-    #if ENABLED(FWRETRACT)
-      COPY(info.retract, fwretract.current_retract);
-      info.retract_hop = fwretract.current_hop;
-    #endif
-
-    // Elapsed print job time
-    info.print_job_elapsed = print_job_timer.duration();
-
-    info.print_progress = card.percentDone();
-
-    // Relative axis modes
-    info.axis_relative = gcode.axis_relative;
-
-    // Misc. Marlin flags
-    info.flag.dryrun = !!(marlin_debug_flags & MARLIN_DEBUG_DRYRUN);
-    info.flag.allow_cold_extrusion = TERN0(PREVENT_COLD_EXTRUSION, thermalManager.allow_cold_extrude);
+    capture(info, zraise);
 
     write();
   }
@@ -273,7 +304,7 @@ void PrintJobRecovery::save(const bool force/*=false*/, const float zraise/*=0*/
         return ;
       }
 
-        if(power_monitor.getVoltsADC() < 2200) {
+        if(power_monitor.getVoltsADC() < POWER_LOSS_ADC_THRESHOLD) {
 
 //        SERIAL_ECHOLNPAIR("v:", AD_DMA[2]);
 
@@ -378,6 +409,56 @@ void PrintJobRecovery::save(const bool force/*=false*/, const float zraise/*=0*/
 
 #endif
 
+#if ENABLED(POWER_LOSS_BROWNOUT)
+
+  #define BROWNOUT_ARM_MS        100  // (ms) Interval between checkpoint updates
+  #define BROWNOUT_HYSTERESIS    100  // (ADC) Recovery above the threshold to re-enable the watchdog
+
+  uint32_t PrintJobRecovery::brownout_cycles; // = 0
+
+  /**
+   * The ADC watchdog saw the PSU voltage drop below POWER_LOSS_ADC_THRESHOLD.
+   * Write the armed checkpoint with the file position of the block the steppers
+   * are on. Stopping the machine is left to outage(), which filters short dips.
+   */
+  HAL_ADC_AWD_ISR() {
+    const uint32_t start = HAL_cycle_count();
+    HAL_ADC_AWD_DISABLE();                      // Once per dip
+    if (recovery.enabled && plr_journal.checkpoint(recovery.info.sdpos))
+      PrintJobRecovery::brownout_cycles = HAL_cycle_count() - start;
+    HAL_adc_awd_isr_epilogue();
+  }
+
+  void PrintJobRecovery::brownout_init() {
+    HAL_cycle_counter_init();
+    HAL_ADC_AWD_START(POWER_LOSS_ADC_THRESHOLD, POWER_LOSS_BROWNOUT_FREQUENCY);
+  }
+
+  /**
+   * Keep the checkpoint current while printing, and re-enable
+   * the watchdog once the voltage has come back
+   */
+  void PrintJobRecovery::brownout_task() {
+    static millis_t next_ms; // = 0
+    const millis_t ms = millis();
+    if (PENDING(ms, next_ms)) return;
+    next_ms = ms + BROWNOUT_ARM_MS;
+
+    if (!HAL_ADC_AWD_ENABLED() && power_monitor.getVoltsADC() > POWER_LOSS_ADC_THRESHOLD + BROWNOUT_HYSTERESIS)
+      HAL_ADC_AWD_ENABLE();
+
+    if (enabled && IS_SD_PRINTING()) {
+      job_recovery_info_t now;
+      memcpy(&now, &info, sizeof(now));
+      capture(now, 0);
+      plr_journal.arm(now);
+    }
+    else
+      plr_journal.disarm();
+  }
+
+#endif // POWER_LOSS_BROWNOUT
+
 /**
  * Save the recovery info the recovery file
  */
@@ -396,9 +477,13 @@ void PrintJobRecovery::write() {
     return;
   }
 */
+#if ENABLED(POWER_LOSS_JOURNAL)
+  if (!plr_journal.append(info)) SERIAL_ECHOLNPGM("write error");
+#else
   if(persistentStore.FLASH_If_Write(FLASH_OUTAGE_DATA_ADDR, &info, sizeof(info)) != FLASHIF_OK) {
   	SERIAL_ECHOLNPGM("write error");
   }
+#endif
 }
 
 /**
@@ -44,6 +44,10 @@
   #define POWER_LOSS_STATE HIGH
 #endif
 
+#ifndef POWER_LOSS_ADC_THRESHOLD
+  #define POWER_LOSS_ADC_THRESHOLD 2200
+#endif
+
 #define DEBUG_POWER_LOSS_RECOVERY
 //#define SAVE_EACH_CMD_MODE
 //#define SAVE_INFO_INTERVAL_MS 0
@@ -188,6 +192,12 @@ class PrintJobRecovery {
       static void adc_raw();
     #endif
 
+    #if ENABLED(POWER_LOSS_BROWNOUT)
+      static uint32_t brownout_cycles;  //!< Cost of the last brown-out checkpoint
+      static void brownout_init();
+      static void brownout_task();
+    #endif
+
     // The referenced file exists
     static inline bool interrupted_file_exists() { return card.fileExists(info.sd_filename); }
 
@@ -200,6 +210,7 @@ class PrintJobRecovery {
     #endif
 
   private:
+    static void capture(job_recovery_info_t &dest, const float zraise);
     static void write();
 
     #if ENABLED(BACKUP_POWER_SUPPLY)
@@ -0,0 +1,234 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * feature/preheat.cpp - Concurrent preheat scheduler
+ *
+ * Each heater is modeled as a first-order system:
+ *   C * dT/dt = P - k * (T - Tamb)
+ * which reaches 'to' from 'from' in
+ *   t = C/k * ln((Tss - from) / (Tss - to)),  Tss = Tamb + P/k
+ *
+ * The heater with the longest predicted time (the leader) is released first.
+ * Other heaters are released once their own prediction, at the power left
+ * over by the heaters already running, catches up with the leader's remaining
+ * time. Released heaters are capped so the summed draw stays in the budget,
+ * with earlier heaters taking priority.
+ */
+
+#include "../inc/MarlinConfigPre.h"
+
+#if ENABLED(PREHEAT_SCHEDULER)
+
+#include "preheat.h"
+#include "../module/temperature.h"
+#include "../gcode/gcode.h"
+#include "../lcd/marlinui.h"
+#include "../MarlinCore.h" // for wait_for_heatup, idle
+
+PreheatScheduler preheat;
+
+#define PREHEAT_ETA_MAX     3600.0f   // (s) Used when a target can't be reached at the available power
+#define PREHEAT_AMBIENT       25.0f   // (°C) Assumed ambient unless a heater reads cooler
+#define PREHEAT_UPDATE_MS     500UL
+#define PREHEAT_MIN_SHARE      0.5f   // Don't release a heater with less than this share of its power
+
+float PreheatScheduler::ambient = PREHEAT_AMBIENT;
+
+enum PreheatSlot : uint8_t { PH_HOTEND, PH_BED, PH_COUNT };
+
+static struct {
+  heater_info_t *info;
+  heater_model_t model;
+  int16_t target;
+  float window,       // (°C) Proximity counted as "arrived"
+        watts,        // (W) Full power at the present supply voltage
+        eta;          // (s) Predicted time to target
+  bool active, released;
+} slot[PH_COUNT];
+
+static uint8_t release_order[PH_COUNT], released_count;
+static float leader_eta, watts_used;
+
+float PreheatScheduler::seconds_to_target(const heater_model_t &model, const float watts, const float from, const float to) {
+  if (to <= from) return 0;
+  if (watts <= 0) return PREHEAT_ETA_MAX;
+  const float ss = ambient + watts / model.loss;
+  if (to >= ss - 1) return PREHEAT_ETA_MAX;
+  return _MIN(PREHEAT_ETA_MAX, (model.capacity / model.loss) * logf((ss - from) / (ss - to)));
+}
+
+static void release_slot(const uint8_t i, const uint8_t e) {
+  auto &s = slot[i];
+  s.released = true;
+  release_order[released_count++] = i;
+  if (i == PH_BED)
+    thermalManager.setTargetBed(s.target);
+  else
+    thermalManager.setTargetHotend(s.target, e);
+}
+
+/**
+ * Recompute predictions, release waiting heaters and update power caps.
+ * Return true once every heater is within its window of the target.
+ */
+bool PreheatScheduler::update(const uint8_t e) {
+  const float scale = thermalManager.heater_supply_scale();
+  const float celsius[PH_COUNT] = { thermalManager.degHotend(e), thermalManager.degBed() };
+
+  // Cap released heaters in release order and sum their present draw
+  float used = 0;
+  LOOP_L_N(n, released_count) {
+    auto &s = slot[release_order[n]];
+    s.watts = s.model.watts * scale;
+    const float allowed = float(PREHEAT_POWER_BUDGET) - used;
+    s.info->soft_pwm_limit = allowed >= s.watts ? 0 : uint8_t(constrain(allowed / s.watts * 127, 1, 127));
+    used += s.watts * (s.info->soft_pwm_amount * (1.0f / 127));
+  }
+  watts_used = used;
+
+  // The longest remaining time among released heaters sets the pace
+  bool done = true;
+  leader_eta = 0;
+  LOOP_L_N(i, PH_COUNT) {
+    auto &s = slot[i];
+    if (!s.active) continue;
+    s.watts = s.model.watts * scale;
+    const float to = s.target - s.window;
+    if (celsius[i] < to) done = false;
+    if (s.released) {
+      const float avail = s.info->soft_pwm_limit ? s.watts * s.info->soft_pwm_limit * (1.0f / 127) : s.watts;
+      s.eta = seconds_to_target(s.model, avail, celsius[i], to);
+      NOLESS(leader_eta, s.eta);
+    }
+  }
+
+  // Predict the waiting heaters. With none released yet the slowest one leads.
+  const float spare = float(PREHEAT_POWER_BUDGET) - used;
+  float waiting_eta = 0;
+  LOOP_L_N(i, PH_COUNT) {
+    auto &s = slot[i];
+    if (!s.active || s.released) continue;
+    s.eta = seconds_to_target(s.model, _MIN(s.watts, spare), celsius[i], s.target - s.window);
+    NOLESS(waiting_eta, s.eta);
+  }
+  if (!released_count) leader_eta = waiting_eta;
+
+  // Release waiting heaters that would otherwise arrive late
+  LOOP_L_N(i, PH_COUNT) {
+    auto &s = slot[i];
+    if (!s.active || s.released) continue;
+    if (_MIN(s.watts, spare) >= s.watts * (PREHEAT_MIN_SHARE) && s.eta + (PREHEAT_ARRIVAL_MARGIN) >= leader_eta)
+      release_slot(i, e);
+  }
+  NOLESS(leader_eta, waiting_eta);
+
+  return done;
+}
+
+void PreheatScheduler::report(const uint8_t e, const millis_t elapsed_ms) {
+  const long eta = LROUND(leader_eta);
+  thermalManager.print_heater_states(e);
+  SERIAL_ECHOPAIR(" ETA:", eta, " P:", int(watts_used));
+  SERIAL_EOL();
+
+  const float elapsed = elapsed_ms * 0.001f,
+              total = elapsed + leader_eta;
+  const int pct = total > 0 ? int(100 * elapsed / total) : 100;
+  ui.status_printf_P(0, PSTR("Preheat %i%% %lis"), pct, eta);
+}
+
+// Drop the caps and hand any waiting heaters to the normal control loop
+void PreheatScheduler::finish(const uint8_t e) {
+  LOOP_L_N(i, PH_COUNT) {
+    auto &s = slot[i];
+    if (!s.active) continue;
+    if (!s.released) release_slot(i, e);
+    s.info->soft_pwm_limit = 0;
+  }
+}
+
+bool PreheatScheduler::run(const int16_t hotend_target, const int16_t bed_target, const uint8_t e/*=0*/) {
+  static constexpr heater_model_t hotend_model = HOTEND_THERMAL_MODEL,
+                                  bed_model = BED_THERMAL_MODEL;
+
+  slot[PH_HOTEND].info = &thermalManager.temp_hotend[e];
+  slot[PH_HOTEND].model = hotend_model;
+  slot[PH_HOTEND].target = hotend_target;
+  slot[PH_HOTEND].window = TEMP_WINDOW;
+  slot[PH_BED].info = &thermalManager.temp_bed;
+  slot[PH_BED].model = bed_model;
+  slot[PH_BED].target = bed_target;
+  slot[PH_BED].window = TEMP_BED_WINDOW;
+  LOOP_L_N(i, PH_COUNT) {
+    auto &s = slot[i];
+    s.watts = s.eta = 0;
+    s.released = false;
+  }
+  released_count = 0;
+  leader_eta = watts_used = 0;
+
+  ambient = _MIN(PREHEAT_AMBIENT, thermalManager.degHotend(e), thermalManager.degBed());
+
+  // Heaters already at temperature keep their target and take no part
+  LOOP_L_N(i, PH_COUNT) {
+    auto &s = slot[i];
+    s.info->soft_pwm_limit = 0;
+    s.active = s.target > 0;
+    if (!s.active) continue;
+    if (s.info->celsius >= s.target - s.window) {
+      release_slot(i, e);
+      continue;
+    }
+    if (i == PH_BED) thermalManager.setTargetBed(0); else thermalManager.setTargetHotend(0, e);
+  }
+
+  #if DISABLED(BUSY_WHILE_HEATING) && ENABLED(HOST_KEEPALIVE_FEATURE)
+    KEEPALIVE_STATE(NOT_BUSY);
+  #endif
+
+  const millis_t start_ms = millis();
+  millis_t next_update_ms = 0, next_report_ms = 0;
+  bool done = false;
+  wait_for_heatup = true;
+  do {
+    const millis_t now = millis();
+    if (ELAPSED(now, next_update_ms)) {
+      next_update_ms = now + PREHEAT_UPDATE_MS;
+      done = update(e);
+    }
+    if (ELAPSED(now, next_report_ms)) {
+      next_report_ms = now + SEC_TO_MS(PREHEAT_REPORT_INTERVAL);
+      report(e, now - start_ms);
+    }
+    idle();
+    gcode.reset_stepper_timeout(); // Keep steppers powered
+  } while (wait_for_heatup && !done);
+
+  finish(e);
+
+  if (!wait_for_heatup) return false;
+  wait_for_heatup = false;
+  return true;
+}
+
+#endif // PREHEAT_SCHEDULER
@@ -0,0 +1,50 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * feature/preheat.h - Concurrent preheat scheduler
+ */
+
+#include "../inc/MarlinConfig.h"
+#include "../module/temperature.h"
+
+class PreheatScheduler {
+public:
+  /**
+   * Heat the bed and hotend together, staggering their start so both arrive
+   * at about the same time and the summed power stays within the budget.
+   * Returns false if the wait was cancelled.
+   */
+  static bool run(const int16_t hotend_target, const int16_t bed_target, const uint8_t e=0);
+
+  // Predicted seconds to go from 'from' to 'to' with 'watts' applied
+  static float seconds_to_target(const heater_model_t &model, const float watts, const float from, const float to);
+
+private:
+  static float ambient;
+  static bool update(const uint8_t e);
+  static void report(const uint8_t e, const millis_t elapsed_ms);
+  static void finish(const uint8_t e);
+};
+
+extern PreheatScheduler preheat;
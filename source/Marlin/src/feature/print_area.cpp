@@ -0,0 +1,222 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/**
+ * feature/print_area.cpp - First layer extents of the printed file, for G29 A
+ *
+ * A second SdFile reads the printed file from the start. Moves that extrude
+ * while moving in XY at the height of the first such move make up the first
+ * layer, which ends at the first extrusion above it. Where the slicer marks
+ * layers (";LAYER:0" Cura, ";LAYER_CHANGE" PrusaSlicer, "; layer 1"
+ * Simplify3D), extrusion before the first mark (purge lines in the start
+ * G-code) is left out. The scan runs inside G29, so it calls idle() after
+ * each block to keep the heaters and the display going.
+ */
+
+#include "../inc/MarlinConfig.h"
+
+#if BOTH(G29_ADAPTIVE, SDSUPPORT)
+
+#include "print_area.h"
+#include "../MarlinCore.h"
+
+PrintArea print_area;
+
+SdFile PrintArea::file;
+bool PrintArea::have_file, PrintArea::scanned, PrintArea::found;
+xy_pos_t PrintArea::area_lf, PrintArea::area_rb;
+
+char PrintArea::line[96];
+uint8_t PrintArea::line_len, PrintArea::layers;
+xyze_float_t PrintArea::pos;
+float PrintArea::first_z;
+bool PrintArea::relative_xyz, PrintArea::relative_e, PrintArea::done;
+
+void PrintArea::reset() { have_file = scanned = false; }
+
+void PrintArea::start(const SdFile &printed) {
+  file = printed;
+  have_file = true;
+  scanned = false;
+}
+
+bool PrintArea::get(xy_pos_t &lf, xy_pos_t &rb) {
+  if (!have_file) return false;
+  if (!scanned) {
+    const millis_t ms = millis();
+    scan();
+    scanned = true;
+    if (found) SERIAL_ECHOLNPAIR("Print area X", area_lf.x, ":", area_rb.x, " Y", area_lf.y, ":", area_rb.y, " scanned in ", millis() - ms, "ms");
+  }
+  if (found) { lf = area_lf; rb = area_rb; }
+  return found;
+}
+
+void PrintArea::scan() {
+  found = done = false;
+  if (!file.seekSet(0)) return;
+
+  clear();
+  pos.reset();
+  relative_xyz = relative_e = false;
+  layers = 0;
+  line_len = 0;
+
+  static uint8_t buf[512];
+  bool skip_line = false;
+  for (uint32_t scanned_bytes = 0; !done && scanned_bytes < (G29_ADAPTIVE_SCAN_BYTES);) {
+    const int16_t n = file.read(buf, sizeof(buf));
+    if (n <= 0) {                 // End of file, so the first layer is complete
+      if (line_len) parse_line();
+      done = true;
+      break;
+    }
+    scanned_bytes += n;
+    idle();
+    for (int16_t i = 0; i < n && !done; i++) {
+      const char c = buf[i];
+      if (c == '\n' || c == '\r') {
+        if (line_len) parse_line();
+        line_len = 0;
+        skip_line = false;
+      }
+      else if (skip_line)
+        continue;
+      else if (c == ';' && line_len == 0)
+        line[line_len++] = c;     // Keep a whole-line comment to look for a layer mark
+      else if ((c == ';' && line[0] != ';') || c == '(' || line_len >= sizeof(line) - 1)
+        skip_line = true;         // Comment, or the rest of an overlong line
+      else
+        line[line_len++] = c;
+    }
+  }
+
+  // A first layer cut off by the scan limit could be missing parts
+  found = done && !isnan(first_z);
+}
+
+void PrintArea::clear() {
+  area_lf.set(99999, 99999);
+  area_rb.set(-99999, -99999);
+  first_z = NAN;
+}
+
+void PrintArea::add(const float x, const float y) {
+  NOMORE(area_lf.x, x); NOMORE(area_lf.y, y);
+  NOLESS(area_rb.x, x); NOLESS(area_rb.y, y);
+}
+
+// Only whole marks count, not ";LAYER_COUNT:", ";Layer height:" or ";   layerHeight,"
+bool PrintArea::is_layer_mark(const char * const p) {
+  if (!strncmp(p, ";LAYER:", 7)) return NUMERIC(p[7]) || p[7] == '-';   // Cura, negative under a raft
+  if (!strncmp(p, "; layer ", 8)) return NUMERIC(p[8]);                 // Simplify3D
+  return !strcmp(p, ";LAYER_CHANGE");                                   // PrusaSlicer
+}
+
+void PrintArea::parse_line() {
+  line[line_len] = '\0';
+  char *p = line;
+
+  if (*p == ';') {
+    if (!is_layer_mark(p)) return;
+    if (layers < 2) layers++;
+    if (layers == 1)              // Only what follows the first mark is the print
+      clear();
+    else if (!isnan(first_z))
+      done = true;
+    return;
+  }
+
+  while (*p == ' ') p++;
+  if (*p == 'N') {                // Skip a line number
+    while (*p && *p != ' ') p++;
+    while (*p == ' ') p++;
+  }
+
+  const char letter = *p++;
+  if ((letter != 'G' && letter != 'M') || !NUMERIC(*p)) return;
+  const uint16_t code = uint16_t(strtoul(p, &p, 10));
+  if (*p == '.') return;
+
+  if (letter == 'M') {
+    if (code == 82) relative_e = false;
+    else if (code == 83) relative_e = true;
+    return;
+  }
+
+  // Parameters, indexed to match X_AXIS..E_AXIS
+  static const char params[] = "XYZEIJ";
+  enum { P_I = 4, P_J };
+  float val[COUNT(params) - 1];
+  uint8_t seen = 0;
+  while (*p) {
+    const char * const k = strchr(params, *p++);
+    if (!k || !*k) continue;
+    char *end;
+    const float v = strtof(p, &end);
+    if (end == p) continue;
+    const uint8_t n = k - params;
+    val[n] = v;
+    SBI(seen, n);
+    p = end;
+  }
+
+  switch (code) {
+    case 0: case 1: case 2: case 3: {
+      xyze_float_t target = pos;
+      LOOP_XYZE(a) if (TEST(seen, a))
+        target[a] = (a == E_AXIS ? relative_e : relative_xyz) ? pos[a] + val[a] : val[a];
+
+      if (target.e > pos.e && (target.x != pos.x || target.y != pos.y)) {
+        if (isnan(first_z))
+          first_z = target.z;
+        else if (target.z > first_z + 0.01f) {
+          done = true;            // Extruding on the second layer
+          return;
+        }
+        add(pos.x, pos.y);
+        add(target.x, target.y);
+        if (code >= 2 && (TEST(seen, P_I) || TEST(seen, P_J))) {
+          const float i = TEST(seen, P_I) ? val[P_I] : 0, j = TEST(seen, P_J) ? val[P_J] : 0,
+                      r = HYPOT(i, j), cx = pos.x + i, cy = pos.y + j;
+          add(cx - r, cy - r);    // The whole circle, to be sure of the arc
+          add(cx + r, cy + r);
+        }
+      }
+      pos = target;
+    } break;
+
+    case 28:                      // Homing ends at 0, near enough for the bounds
+      LOOP_XYZ(a) if (!(seen & 0x07) || TEST(seen, a)) pos[a] = 0;
+      break;
+
+    case 90: relative_xyz = relative_e = false; break;
+    case 91: relative_xyz = relative_e = true; break;
+
+    case 92:
+      LOOP_XYZE(a) if (TEST(seen, a)) pos[a] = val[a];
+      break;
+  }
+}
+
+#endif // G29_ADAPTIVE && SDSUPPORT
@@ -0,0 +1,58 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * feature/print_area.h - First layer extents of the printed file, for G29 A
+ */
+
+#include "../inc/MarlinConfig.h"
+#include "../sd/SdFile.h"
+
+class PrintArea {
+public:
+  static void start(const SdFile &printed);   // A file was opened for printing
+  static void reset();
+
+  // Get the first layer's extents, scanning the file on the first call.
+  // False if the file has no first layer within G29_ADAPTIVE_SCAN_BYTES.
+  static bool get(xy_pos_t &lf, xy_pos_t &rb);
+
+private:
+  static SdFile file;                         // Own reader over the printed file
+  static bool have_file, scanned, found;
+  static xy_pos_t area_lf, area_rb;
+
+  static char line[96];
+  static uint8_t line_len, layers;
+  static xyze_float_t pos;
+  static float first_z;
+  static bool relative_xyz, relative_e, done;
+
+  static void scan();
+  static bool is_layer_mark(const char * const p);
+  static void parse_line();
+  static void clear();
+  static void add(const float x, const float y);
+};
+
+extern PrintArea print_area;
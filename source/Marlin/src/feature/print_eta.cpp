@@ -0,0 +1,343 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * feature/print_eta.cpp - Print progress and time remaining from a move-time model
+ *
+ * A second SdFile reads the printed file one block at a time, ahead of the
+ * print. It reads into its own buffer, bypassing the volume's one-block cache,
+ * so the print's cached block isn't evicted and read again. G0-G3 moves are timed as trapezoids under the planner's limits,
+ * slowing at each corner in proportion to the turn, and each move's time is
+ * added to the slice of the file where it starts.
+ *
+ * During the print, the model time up to the read position, less what the
+ * planner still holds, is compared with the elapsed time to find how much
+ * slower (or faster) the printer runs than the model. Time remaining is the
+ * planner's queued time plus the model time of the unread part of the file,
+ * scaled by that ratio and the feedrate percentage.
+ */
+
+#include "../inc/MarlinConfig.h"
+
+#if ENABLED(PRINT_ETA_ESTIMATOR)
+
+#include "print_eta.h"
+#include "../module/motion.h"
+#include "../module/planner.h"
+#include "../module/printcounter.h"
+#include "../sd/cardreader.h"
+
+#define ETA_SCAN_MS         2   // (ms) Interval between 512-byte scan reads
+#define ETA_UPDATE_MS    1000   // (ms) Interval between estimates
+#define ETA_CAL_MODEL_S    10   // (s) Model time between ratio updates
+
+PrintETA print_eta;
+
+SdFile PrintETA::file;
+uint32_t PrintETA::file_size, // = 0
+         PrintETA::scan_pos, PrintETA::line_pos, PrintETA::bin_bytes;
+bool PrintETA::scanning, PrintETA::scan_done;
+
+float PrintETA::bin_time[PRINT_ETA_BINS], PrintETA::scanned_s;
+
+char PrintETA::line[96];
+uint8_t PrintETA::line_len;
+bool PrintETA::skip_line;
+
+xyze_float_t PrintETA::pos;
+xyz_float_t PrintETA::dir;
+float PrintETA::feedrate;
+bool PrintETA::relative_xyz, PrintETA::relative_e, PrintETA::has_pending;
+PrintETA::pending_move_t PrintETA::pending;
+
+float PrintETA::ratio, PrintETA::cal_elapsed, PrintETA::cal_model;
+millis_t PrintETA::next_scan_ms, PrintETA::next_estimate_ms;
+bool PrintETA::estimate_ok;
+uint32_t PrintETA::remaining_s;
+
+void PrintETA::reset() {
+  file_size = 0;
+  scanning = scan_done = estimate_ok = false;
+  remaining_s = 0;
+}
+
+void PrintETA::start(const SdFile &printed) {
+  reset();
+  file = printed;
+  if (!file.seekSet(0) || !(file_size = file.fileSize())) return;
+
+  scan_pos = line_pos = 0;
+  bin_bytes = file_size / (PRINT_ETA_BINS) + 1;
+  LOOP_L_N(i, PRINT_ETA_BINS) bin_time[i] = 0;
+  scanned_s = 0;
+
+  line_len = 0;
+  skip_line = false;
+
+  pos.reset();
+  feedrate = 25;
+  relative_xyz = relative_e = has_pending = false;
+
+  ratio = 1;
+  cal_elapsed = -1;               // Calibrate from the first move
+  scanning = true;
+}
+
+void PrintETA::task() {
+  if (!file_size) return;
+  if (!card.isFileOpen()) return reset();
+
+  const millis_t ms = millis();
+
+  // Scan while the planner is empty (heating, paused) or at least half full.
+  // In between it is running low and the print needs the media.
+  if (scanning && ELAPSED(ms, next_scan_ms)) {
+    next_scan_ms = ms + ETA_SCAN_MS;
+    const uint8_t moves = planner.movesplanned();
+    if (!moves || moves >= (BLOCK_BUFFER_SIZE) / 2) scan_block();
+  }
+
+  if (card.isPrinting() && ELAPSED(ms, next_estimate_ms)) {
+    next_estimate_ms = ms + ETA_UPDATE_MS;
+    estimate();
+  }
+}
+
+void PrintETA::scan_block() {
+  static cache_t block;
+  const int16_t n = file.readBlockUncached(&block);
+
+  if (n <= 0) {                   // End of file (or unreadable)
+    if (line_len) parse_line();
+    if (has_pending) finish_pending(0);
+    scanning = false;
+    scan_done = true;
+    return;
+  }
+
+  for (int16_t i = 0; i < n; i++) {
+    const char c = block.data[i];
+    scan_pos++;
+    if (c == '\n' || c == '\r') {
+      if (line_len) parse_line();
+      line_len = 0;
+      skip_line = false;
+      line_pos = scan_pos;
+    }
+    else if (skip_line)
+      continue;
+    else if (c == ';' || c == '(' || line_len >= sizeof(line) - 1)
+      skip_line = true;           // Comment, or the rest of an overlong line
+    else
+      line[line_len++] = c;
+  }
+}
+
+void PrintETA::parse_line() {
+  line[line_len] = '\0';
+  char *p = line;
+  while (*p == ' ') p++;
+  if (*p == 'N') {                // Skip a line number
+    while (*p && *p != ' ') p++;
+    while (*p == ' ') p++;
+  }
+
+  const char letter = *p++;
+  if ((letter != 'G' && letter != 'M') || !NUMERIC(*p)) return;
+  const uint16_t code = uint16_t(strtoul(p, &p, 10));
+  if (*p == '.') return;          // Subcodes don't move
+
+  if (letter == 'M') {
+    if (code == 82) relative_e = false;
+    else if (code == 83) relative_e = true;
+    return;
+  }
+
+  // Parameters, indexed to match X_AXIS..E_AXIS
+  static const char params[] = "XYZEFIJPS";
+  enum { P_F = 4, P_I, P_J, P_P, P_S };
+  float val[COUNT(params) - 1];
+  uint16_t seen = 0;
+  while (*p) {
+    const char * const k = strchr(params, *p++);
+    if (!k || !*k) continue;
+    char *end;
+    const float v = strtof(p, &end);
+    if (end == p) continue;
+    const uint8_t n = k - params;
+    val[n] = v;
+    SBI(seen, n);
+    p = end;
+  }
+
+  switch (code) {
+    case 0: case 1: case 2: case 3: {
+      xyze_float_t target = pos;
+      LOOP_XYZE(a) if (TEST(seen, a))
+        target[a] = (a == E_AXIS ? relative_e : relative_xyz) ? pos[a] + val[a] : val[a];
+      if (TEST(seen, P_F) && val[P_F] > 0) feedrate = MMM_TO_MMS(val[P_F]);
+
+      float arc_length = 0;
+      if (code >= 2 && (TEST(seen, P_I) || TEST(seen, P_J))) {
+        const float i = TEST(seen, P_I) ? val[P_I] : 0, j = TEST(seen, P_J) ? val[P_J] : 0,
+                    cx = pos.x + i, cy = pos.y + j,
+                    a0 = ATAN2(pos.y - cy, pos.x - cx), a1 = ATAN2(target.y - cy, target.x - cx);
+        float sweep = a1 - a0;    // Counter-clockwise (G3) is positive
+        if (code == 2) { if (sweep >= 0) sweep -= RADIANS(360); }
+        else if (sweep <= 0) sweep += RADIANS(360);
+        arc_length = HYPOT(ABS(sweep) * HYPOT(i, j), target.z - pos.z);
+      }
+
+      add_move(target, arc_length);
+      pos = target;
+    } break;
+
+    case 4: {                     // Dwell
+      if (has_pending) finish_pending(0);
+      const float s = TEST(seen, P_P) ? val[P_P] * 0.001f : TEST(seen, P_S) ? val[P_S] : 0;
+      bin_time[line_pos / bin_bytes] += s;
+      scanned_s += s;
+    } break;
+
+    case 28:                      // Homing ends at 0, near enough for timing
+      if (has_pending) finish_pending(0);
+      LOOP_XYZ(a) if (!(seen & 0x07) || TEST(seen, a)) pos[a] = 0;
+      break;
+
+    case 90: relative_xyz = relative_e = false; break;
+    case 91: relative_xyz = relative_e = true; break;
+
+    case 92:
+      LOOP_XYZE(a) if (TEST(seen, a)) pos[a] = val[a];
+      break;
+  }
+}
+
+void PrintETA::add_move(const xyze_float_t &target, const float arc_length) {
+  const xyze_float_t d = target - pos;
+  const float xyz = arc_length ?: SQRT(sq(d.x) + sq(d.y) + sq(d.z));
+  const bool e_only = xyz < 0.0001f;
+  const float length = e_only ? ABS(d.e) : xyz;
+  if (length < 0.0001f) return;
+
+  // Cruise speed and acceleration within the per-axis limits, as the planner does
+  const planner_settings_t &ps = planner.settings;
+  float cruise = feedrate,
+        accel = e_only ? ps.retract_acceleration : d.e > 0 ? ps.acceleration : ps.travel_acceleration;
+  LOOP_XYZE(a) {
+    const float frac = ABS(d[a]) / length;
+    if (frac > 0.0001f) {
+      NOMORE(cruise, ps.max_feedrate_mm_s[a] / frac);
+      NOMORE(accel, ps.max_acceleration_mm_per_s2[a] / frac);
+    }
+  }
+  NOLESS(cruise, 0.1f);
+  NOLESS(accel, 1.0f);
+
+  // Corner speed falls off with the angle turned, reaching zero at 90°
+  xyz_float_t unit = { 0, 0, 0 };
+  if (!e_only) unit.set(d.x / xyz, d.y / xyz, d.z / xyz);
+  float junction = 0;
+  if (has_pending) {
+    const float cos_theta = dir.x * unit.x + dir.y * unit.y + dir.z * unit.z;
+    if (cos_theta > 0) junction = _MIN(pending.cruise, cruise) * cos_theta;
+    finish_pending(junction);
+  }
+
+  pending.length = length;
+  pending.accel = accel;
+  pending.cruise = cruise;
+  pending.entry = junction;
+  pending.bin = line_pos / bin_bytes;
+  dir = unit;
+  has_pending = true;
+}
+
+// Time the pending move now that its exit speed is known
+void PrintETA::finish_pending(const float exit_speed) {
+  const pending_move_t &m = pending;
+  const float a = m.accel, v = m.cruise,
+              vi = _MIN(m.entry, v), vf = _MIN(exit_speed, v),
+              d_acc = (sq(v) - sq(vi)) / (2 * a),
+              d_dec = (sq(v) - sq(vf)) / (2 * a);
+  float t;
+  if (d_acc + d_dec <= m.length)
+    t = (v - vi) / a + (v - vf) / a + (m.length - d_acc - d_dec) / v;
+  else {
+    const float peak = SQRT((2 * a * m.length + sq(vi) + sq(vf)) * 0.5f);
+    t = peak > _MAX(vi, vf) ? (peak - vi) / a + (peak - vf) / a : 2 * m.length / (vi + vf);
+  }
+  bin_time[m.bin] += t;
+  scanned_s += t;
+  has_pending = false;
+}
+
+float PrintETA::model_time_at(const uint32_t sdpos) {
+  const uint32_t b = sdpos / bin_bytes;
+  float t = 0;
+  LOOP_L_N(i, _MIN(b, uint32_t(PRINT_ETA_BINS))) t += bin_time[i];
+  if (b < PRINT_ETA_BINS) t += bin_time[b] * float(sdpos % bin_bytes) / bin_bytes;
+  return t;
+}
+
+void PrintETA::estimate() {
+  const uint32_t read_pos = card.getIndex();
+  if (!scan_done && scan_pos <= read_pos) { estimate_ok = false; return; }
+
+  const float speed = _MAX(feedrate_percentage * 0.01f, 0.1f),
+              elapsed = print_job_timer.duration(),
+              queued = planner.block_buffer_runtime() * 0.001024f,   // (s) Moves read but not yet done
+              model_read = model_time_at(read_pos),
+              model_done = _MAX(model_read - queued * speed, 0.0f);
+
+  // Heating before the first move is left out of the ratio
+  if (cal_elapsed < 0 || model_done < cal_model) {
+    if (model_done > 0) { cal_elapsed = elapsed; cal_model = model_done; }
+  }
+  else if (model_done - cal_model >= ETA_CAL_MODEL_S) {
+    const float r = (elapsed - cal_elapsed) * speed / (model_done - cal_model);
+    ratio += (constrain(r, 0.25f, 4.0f) - ratio) * 0.25f;
+    cal_elapsed = elapsed;
+    cal_model = model_done;
+  }
+
+  // Until the scan is done, assume the rest of the file is like the part scanned
+  const float total = scan_done ? scanned_s : scanned_s * file_size / scan_pos;
+  remaining_s = LROUND(queued + _MAX(total - model_read, 0.0f) * ratio / speed);
+  estimate_ok = true;
+}
+
+uint16_t PrintETA::permyriad() {
+  if (!estimate_ok) return 0;
+  const uint32_t elapsed = print_job_timer.duration(), total = elapsed + remaining_s;
+  return total ? uint16_t(10000ULL * elapsed / total) : 0;
+}
+
+void PrintETA::report() {
+  if (!estimate_ok) return;
+  const uint16_t p = permyriad();
+  SERIAL_ECHOPAIR("Estimated progress:", p / 100);
+  SERIAL_CHAR('.', '0' + char((p / 10) % 10), '0' + char(p % 10));
+  SERIAL_ECHOLNPAIR("% remaining:", remaining_s, "s");
+}
+
+#endif // PRINT_ETA_ESTIMATOR
@@ -0,0 +1,81 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * feature/print_eta.h - Print progress and time remaining from a move-time model
+ */
+
+#include "../inc/MarlinConfig.h"
+#include "../sd/SdFile.h"
+
+class PrintETA {
+public:
+  static void start(const SdFile &printed);   // A file was opened for printing
+  static void reset();
+
+  // Scan ahead and recalibrate. Called from idle().
+  static void task();
+
+  static inline bool valid() { return estimate_ok; }
+  static inline uint32_t remaining() { return estimate_ok ? remaining_s : 0; }
+  static uint16_t permyriad();
+  static void report();
+
+private:
+  typedef struct {
+    float length, accel, cruise, entry;       // (mm) (mm/s^2) (mm/s) (mm/s)
+    uint8_t bin;
+  } pending_move_t;
+
+  static SdFile file;                         // Own reader over the printed file
+  static uint32_t file_size, scan_pos, line_pos, bin_bytes;
+  static bool scanning, scan_done;
+
+  static float bin_time[PRINT_ETA_BINS];      // (s) Model time of the moves starting in each slice
+  static float scanned_s;                     // (s) Model time of everything scanned so far
+
+  static char line[96];
+  static uint8_t line_len;
+  static bool skip_line;
+
+  static xyze_float_t pos;
+  static xyz_float_t dir;                     // Unit vector of the pending move
+  static float feedrate;                      // (mm/s)
+  static bool relative_xyz, relative_e, has_pending;
+  static pending_move_t pending;
+
+  static float ratio;                         // Real time over model time
+  static float cal_elapsed, cal_model;
+  static millis_t next_scan_ms, next_estimate_ms;
+  static bool estimate_ok;
+  static uint32_t remaining_s;
+
+  static void scan_block();
+  static void parse_line();
+  static void add_move(const xyze_float_t &target, const float arc_length);
+  static void finish_pending(const float exit_speed);
+  static float model_time_at(const uint32_t sdpos);
+  static void estimate();
+};
+
+extern PrintETA print_eta;
@@ -0,0 +1,188 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * feature/temp_telemetry.cpp - Temperature telemetry stream
+ *
+ * Each frame holds a millisecond timestamp and, for every heater, the raw
+ * (oversampled) ADC value, temperature in 1/100 °C, target °C, PWM (0-127)
+ * and the P, I, D terms in 1/10 PWM counts. A frame only goes out for a
+ * reading that hasn't been sent yet and its timestamp is the time of that
+ * reading. A new reading comes once per PID_dT, so a faster rate is clamped
+ * to that and M156 echoes the interval in effect.
+ *
+ * Text frames are one line of fixed-width fields:
+ *   TT:0000123456 E0:12345 +20512 210 127 +01234 +00567 -00012 B:...
+ *
+ * Binary frames are little-endian:
+ *   A5 5A len seq ms[4] { id raw[2] temp[2] target[2] pwm P[2] I[2] D[2] }... sum[2]
+ * 'len' counts the bytes from 'seq' to the last heater, 'id' is the hotend
+ * index or -1 for the bed, and 'sum' is the Fletcher-16 of 'len' to the last
+ * heater.
+ *
+ * All formatting is integer-only. A frame is only queued if it fits in the
+ * TX ring, so a busy link drops frames instead of stalling the main loop.
+ */
+
+#include "../inc/MarlinConfigPre.h"
+
+#if ENABLED(TEMP_TELEMETRY)
+
+#include "temp_telemetry.h"
+#include "../module/temperature.h"
+
+TempTelemetry temp_telemetry;
+
+uint16_t TempTelemetry::interval_ms; // = 0
+bool TempTelemetry::binary;
+uint32_t TempTelemetry::dropped;
+millis_t TempTelemetry::next_ms, TempTelemetry::sample_ms;
+bool TempTelemetry::fresh;
+uint8_t TempTelemetry::seq;
+
+#define TELEMETRY_HEATERS (HOTENDS + ENABLED(HAS_HEATED_BED))
+#define TELEMETRY_HEATER_BYTES 14
+#define TELEMETRY_TEXT_HEATER  48
+#define TELEMETRY_FRAME_SIZE   (16 + TELEMETRY_HEATERS * TELEMETRY_TEXT_HEATER)
+#define TELEMETRY_MIN_INTERVAL uint16_t(PID_dT * 1000 + 0.999f)  // (ms) One frame per reading
+
+typedef struct {
+  int8_t id;
+  uint16_t raw;
+  int16_t centi, target;
+  uint8_t pwm;
+  int16_t term[3];
+} telemetry_sample_t;
+
+static void get_sample(telemetry_sample_t &s, const int8_t id, const heater_info_t &h) {
+  s.id = id;
+  s.raw = uint16_t(h.raw);
+  s.centi = int16_t(constrain(h.celsius * 100, -32767, 32767));
+  s.target = h.target;
+  s.pwm = h.soft_pwm_amount;
+  LOOP_L_N(i, 3) s.term[i] = h.pid_term[i];
+}
+
+// Write 'v' as exactly 'width' zero-padded digits, capped at the largest that fits
+static char* put_uint(char *p, uint32_t v, const uint8_t width) {
+  static constexpr uint32_t limit[] = { 0, 9, 99, 999, 9999, 99999, 999999, 9999999, 99999999, 999999999 };
+  if (width < COUNT(limit)) NOMORE(v, limit[width]);
+  char *q = (p += width);
+  LOOP_L_N(i, width) { *--q = '0' + v % 10; v /= 10; }
+  return p;
+}
+
+static char* put_int(char *p, const int32_t v, const uint8_t width) {
+  *p++ = v < 0 ? '-' : '+';
+  return put_uint(p, v < 0 ? -v : v, width);
+}
+
+static inline uint8_t* put_le16(uint8_t *p, const uint16_t v) { *p++ = v & 0xFF; *p++ = v >> 8; return p; }
+
+void TempTelemetry::start(const uint8_t hz, const bool bin) {
+  interval_ms = hz ? _MAX(1000U / _MIN(hz, TEMP_TELEMETRY_MAX_HZ), TELEMETRY_MIN_INTERVAL) : 0;
+  binary = bin;
+  dropped = 0;
+  next_ms = millis();
+}
+
+void TempTelemetry::report() {
+  if (interval_ms) {
+    SERIAL_ECHOPAIR("Telemetry every ", interval_ms, "ms");
+    serialprintPGM(binary ? PSTR(" binary") : PSTR(" text"));
+    SERIAL_ECHOLNPAIR(" dropped:", dropped);
+  }
+  else
+    SERIAL_ECHOLNPGM("Telemetry off");
+}
+
+void TempTelemetry::tick() {
+  if (!interval_ms || !fresh) return;
+  const millis_t ms = millis();
+  if (PENDING(ms, next_ms)) return;
+  next_ms += interval_ms;
+  if (ELAPSED(ms, next_ms)) next_ms = ms + interval_ms; // Fell behind: don't burst to catch up
+  fresh = false;
+  send_frame(sample_ms);
+}
+
+void TempTelemetry::send_frame(const millis_t ms) {
+  telemetry_sample_t sample[TELEMETRY_HEATERS];
+  uint8_t n = 0;
+  #if HAS_HOTEND
+    HOTEND_LOOP() get_sample(sample[n++], e, thermalManager.temp_hotend[e]);
+  #endif
+  #if HAS_HEATED_BED
+    get_sample(sample[n++], -1, thermalManager.temp_bed);
+  #endif
+
+  uint8_t frame[TELEMETRY_FRAME_SIZE];
+  size_t len;
+
+  if (binary) {
+    uint8_t *p = frame;
+    *p++ = 0xA5; *p++ = 0x5A;
+    *p++ = 5 + n * TELEMETRY_HEATER_BYTES;
+    *p++ = seq++;
+    p = put_le16(p, ms & 0xFFFF);
+    p = put_le16(p, ms >> 16);
+    LOOP_L_N(i, n) {
+      const telemetry_sample_t &s = sample[i];
+      *p++ = uint8_t(s.id);
+      p = put_le16(p, s.raw);
+      p = put_le16(p, uint16_t(s.centi));
+      p = put_le16(p, uint16_t(s.target));
+      *p++ = s.pwm;
+      LOOP_L_N(t, 3) p = put_le16(p, uint16_t(s.term[t]));
+    }
+    // Fletcher-16 from 'len' to the last heater
+    uint16_t a = 0, b = 0;
+    for (const uint8_t *c = frame + 2; c < p; ++c) { a = (a + *c) % 255; b = (b + a) % 255; }
+    *p++ = uint8_t(a); *p++ = uint8_t(b);
+    len = p - frame;
+  }
+  else {
+    char *p = (char*)frame;
+    *p++ = 'T'; *p++ = 'T'; *p++ = ':';
+    p = put_uint(p, ms, 10);
+    LOOP_L_N(i, n) {
+      const telemetry_sample_t &s = sample[i];
+      *p++ = ' ';
+      if (s.id < 0) *p++ = 'B';
+      else { *p++ = 'E'; *p++ = '0' + s.id; }
+      *p++ = ':';
+      p = put_uint(p, s.raw, 5);
+      *p++ = ' '; p = put_int(p, s.centi, 5);
+      *p++ = ' '; p = put_uint(p, _MAX(s.target, 0), 3);
+      *p++ = ' '; p = put_uint(p, s.pwm, 3);
+      LOOP_L_N(t, 3) { *p++ = ' '; p = put_int(p, s.term[t], 5); }
+    }
+    *p++ = '\n';
+    len = p - (char*)frame;
+  }
+
+  // Skip the frame rather than wait for the TX ring
+  if (MYSERIAL0.availableForWrite() < int(len)) { dropped++; return; }
+  SERIAL_OUT(write, frame, len);
+}
+
+#endif // TEMP_TELEMETRY
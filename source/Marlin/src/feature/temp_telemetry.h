@@ -0,0 +1,54 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * feature/temp_telemetry.h - Temperature telemetry stream
+ */
+
+#include "../inc/MarlinConfig.h"
+
+class TempTelemetry {
+public:
+  static uint16_t interval_ms;  // Frame interval (0 = stopped)
+  static bool binary;           // Binary frames instead of fixed-field text
+  static uint32_t dropped;      // Frames skipped for lack of TX room
+
+  // Start at 'hz', clamped to TEMP_TELEMETRY_MAX_HZ and to one frame per PID_dT
+  static void start(const uint8_t hz, const bool bin);
+  static inline void stop() { interval_ms = 0; }
+  static void report();
+
+  // A new reading is in. Called by manage_heater() once per PID_dT.
+  static inline void sampled(const millis_t ms) { sample_ms = ms; fresh = true; }
+
+  // Send a frame when one is due and there is a reading not yet sent. Called from idle().
+  static void tick();
+
+private:
+  static millis_t next_ms, sample_ms;
+  static bool fresh;
+  static uint8_t seq;
+  static void send_frame(const millis_t ms);
+};
+
+extern TempTelemetry temp_telemetry;
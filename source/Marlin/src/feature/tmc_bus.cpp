@@ -0,0 +1,329 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * feature/tmc_bus.cpp - Interrupt-driven transactions on the shared TMC UART
+ *
+ * All drivers share one half-duplex UART, so one datagram is on the bus at a
+ * time. Requests wait in a ring and the USART1 interrupts send each one and
+ * collect its answer: a write is done when its 8 bytes have echoed back, a
+ * read when a reply with the read register and a good CRC comes in. Only the
+ * addressed node answers a read, so the reply belongs to the request on the
+ * bus. The next request goes out from the same interrupt after a write.
+ *
+ * Every node hears a reply and may take it for the start of a datagram, so
+ * after a read the bus is left idle until the nodes reset their receivers
+ * (63 bit times) and task() sends the next request.
+ *
+ * Timeouts, retries and callbacks are handled by task() in the main loop, so
+ * a callback may queue more requests. Writes are sent behind the caller's
+ * back and a lost write echo is not retried, matching the library.
+ */
+
+#include "../inc/MarlinConfig.h"
+
+#if ENABLED(TMC_UART_ASYNC)
+
+#include "tmc_bus.h"
+
+#define TMC_BUS_SYNC      0x05
+#define TMC_BUS_MASTER    0xFF
+#define TMC_BUS_WRITE     0x80
+#define TMC_BUS_TIMEOUT   3                     // (ms) A full read takes ~1.2ms at 115200 baud
+#define TMC_BUS_RETRIES   2
+
+#ifndef TMC_BAUD_RATE
+  #define TMC_BAUD_RATE   115200
+#endif
+#define TMC_BUS_QUIET     ((F_CPU) / (TMC_BAUD_RATE) * 64)   // (cycles) Idle time for the nodes to resync
+
+#define NEXT(I) (((I) + 1) & (TMC_BUS_QUEUE - 1))
+
+static_assert(!(TMC_BUS_QUEUE & (TMC_BUS_QUEUE - 1)), "TMC_BUS_QUEUE must be a power of 2.");
+
+TMCBus tmc_bus;
+
+TMCBus::xfer_t TMCBus::q[TMC_BUS_QUEUE];
+volatile uint8_t TMCBus::fill,  // = 0
+                 TMCBus::cur,   // = 0
+                 TMCBus::done;  // = 0
+volatile bool TMCBus::busy;     // = false
+volatile millis_t TMCBus::deadline;
+volatile uint32_t TMCBus::quiet_from;
+uint8_t TMCBus::tx_buf[8], TMCBus::tx_len, TMCBus::tx_pos,
+        TMCBus::rx_buf[8], TMCBus::rx_len, TMCBus::tries;
+uint32_t TMCBus::sync;
+uint16_t TMCBus::sent, TMCBus::retried, TMCBus::crc_errors, TMCBus::timeouts;
+
+typedef struct { volatile int8_t ok; uint32_t value; } wait_t;   // ok is -1 until the reply
+
+static void tmc_bus_rx(uint8_t c) { TMCBus::rx_isr(c); }
+static int16_t tmc_bus_tx() { return TMCBus::tx_isr(); }
+
+void TMCBus::init() {
+  HAL_cycle_counter_init();
+  HAL_TMC_UART_ATTACH(tmc_bus_rx, tmc_bus_tx);
+}
+
+// The TMC220x datagram CRC: polynomial 0x07, bits taken LSB first
+uint8_t TMCBus::crc8(const uint8_t * const data, const uint8_t len) {
+  uint8_t crc = 0;
+  LOOP_L_N(i, len) {
+    uint8_t b = data[i];
+    LOOP_L_N(j, 8) {
+      crc = ((crc >> 7) ^ (b & 0x01)) ? (crc << 1) ^ 0x07 : crc << 1;
+      b >>= 1;
+    }
+  }
+  return crc;
+}
+
+// Put q[cur] on the bus. Interrupt context, or the main loop with the bus idle.
+void TMCBus::start() {
+  const xfer_t &x = q[cur];
+  tx_buf[0] = TMC_BUS_SYNC;
+  tx_buf[1] = x.node;
+  tx_buf[2] = x.reg;
+  if (x.reg & TMC_BUS_WRITE) {
+    tx_buf[3] = x.value >> 24;
+    tx_buf[4] = x.value >> 16;
+    tx_buf[5] = x.value >> 8;
+    tx_buf[6] = x.value;
+    tx_len = 7;
+  }
+  else
+    tx_len = 3;
+  tx_buf[tx_len] = crc8(tx_buf, tx_len);
+  tx_len++;
+  tx_pos = rx_len = 0;
+  sync = 0;
+  deadline = millis() + TMC_BUS_TIMEOUT;
+  busy = true;
+  sent++;
+  HAL_TMC_UART_SEND();
+}
+
+// Leave the bus idle, for task() to send q[cur] once the nodes have resynced
+void TMCBus::hold() {
+  quiet_from = HAL_cycle_count();
+  busy = false;
+}
+
+bool TMCBus::quiet() { return HAL_cycle_count() - quiet_from >= TMC_BUS_QUIET; }
+
+void TMCBus::retry() {
+  if (++tries > TMC_BUS_RETRIES) return finish(false);
+  retried++;
+  hold();
+}
+
+void TMCBus::finish(const bool ok, const uint32_t value/*=0*/) {
+  const bool was_read = !(q[cur].reg & TMC_BUS_WRITE);
+  q[cur].ok = ok;
+  q[cur].value = value;
+  cur = NEXT(cur);
+  tries = 0;
+  if (was_read)
+    hold();
+  else {
+    busy = false;
+    if (cur != fill) start();
+  }
+}
+
+int16_t TMCBus::tx_isr() {
+  return tx_pos < tx_len ? tx_buf[tx_pos++] : -1;
+}
+
+void TMCBus::rx_isr(const uint8_t c) {
+  if (!busy) return;                            // Noise
+
+  const uint8_t reg = q[cur].reg;
+  if (reg & TMC_BUS_WRITE) {                    // Count the echo of the whole datagram
+    if (++rx_len >= 8) finish(true);
+    return;
+  }
+
+  // Skip the echo of the request until the reply's sync, master address and register line up
+  if (rx_len < 3) {
+    sync = (sync << 8 | c) & 0xFFFFFF;
+    if (sync == (uint32_t(TMC_BUS_SYNC) << 16 | TMC_BUS_MASTER << 8 | reg)) {
+      rx_buf[0] = TMC_BUS_SYNC;
+      rx_buf[1] = TMC_BUS_MASTER;
+      rx_buf[2] = reg;
+      rx_len = 3;
+    }
+    return;
+  }
+
+  rx_buf[rx_len++] = c;
+  if (rx_len < 8) return;
+  if (crc8(rx_buf, 7) == rx_buf[7])
+    finish(true, uint32_t(rx_buf[3]) << 24 | uint32_t(rx_buf[4]) << 16 | uint32_t(rx_buf[5]) << 8 | rx_buf[6]);
+  else {
+    crc_errors++;
+    retry();
+  }
+}
+
+bool TMCBus::enqueue(const uint8_t node, const uint8_t reg, const uint32_t value, const tmc_bus_cb_t cb, void * const ctx) {
+  const uint8_t f = fill;
+  if (NEXT(f) == done) return false;
+  xfer_t &x = q[f];
+  x.node = node;
+  x.reg = reg;
+  x.value = value;
+  x.cb = cb;
+  x.ctx = ctx;
+  fill = NEXT(f);                               // The ISR may start it from here on
+  if (!busy && quiet()) start();
+  return true;
+}
+
+void TMCBus::write(const uint8_t node, const uint8_t reg, const uint32_t value) {
+  while (!enqueue(node, reg | TMC_BUS_WRITE, value, nullptr, nullptr)) task();
+}
+
+bool TMCBus::read(const uint8_t node, const uint8_t reg, const tmc_bus_cb_t cb, void * const ctx) {
+  return enqueue(node, reg & ~TMC_BUS_WRITE, 0, cb, ctx);
+}
+
+bool TMCBus::read_wait(const uint8_t node, const uint8_t reg, uint32_t &value) {
+  wait_t w = { -1, 0 };
+  const tmc_bus_cb_t cb = [](void * const ctx, const bool ok, const uint32_t v) {
+    wait_t * const p = (wait_t*)ctx;
+    p->value = v;
+    p->ok = ok;
+  };
+  while (!read(node, reg, cb, &w)) task();
+  while (w.ok < 0) task();
+  value = w.value;
+  return w.ok;
+}
+
+void TMCBus::drain() {
+  TERN_(TMC_SHADOW_REGISTERS, TMCShadow::flush_all());
+  while (cur != fill || done != cur) task();
+}
+
+void TMCBus::task() {
+  TERN_(TMC_SHADOW_REGISTERS, TMCShadow::flush_all());
+
+  if (busy && ELAPSED(millis(), deadline)) {
+    DISABLE_ISRS();
+    if (busy && ELAPSED(millis(), deadline)) {  // Still stuck with the UART quiet
+      if (q[cur].reg & TMC_BUS_WRITE)
+        finish(true);                           // No echo on this wiring
+      else {
+        timeouts++;
+        retry();
+      }
+    }
+    ENABLE_ISRS();
+  }
+  else if (!busy && cur != fill && quiet())
+    start();
+
+  while (done != cur) {
+    const xfer_t &x = q[done];
+    if (x.cb) x.cb(x.ctx, x.ok, x.value);
+    done = NEXT(done);
+  }
+}
+
+void TMCBus::report() {
+  SERIAL_ECHOLNPAIR("TMC bus sent:", sent, " retried:", retried, " crc errors:", crc_errors, " timeouts:", timeouts);
+  TERN_(TMC_SHADOW_REGISTERS, TMCShadow::report());
+}
+
+#if ENABLED(TMC_SHADOW_REGISTERS)
+
+  // GCONF, SLAVECONF, IHOLD_IRUN, TPOWERDOWN, TPWMTHRS, TCOOLTHRS, VACTUAL, SGTHRS, COOLCONF, CHOPCONF, PWMCONF
+  static const uint8_t shadow_regs[TMC_SHADOW_REGS] PROGMEM = { 0x00, 0x03, 0x10, 0x11, 0x13, 0x14, 0x22, 0x40, 0x42, 0x6C, 0x70 };
+
+  TMCShadow *TMCShadow::list[16];
+  uint8_t TMCShadow::count;                             // = 0
+  bool TMCShadow::pending;                              // = false
+  uint16_t TMCShadow::writes_in, TMCShadow::writes_out, TMCShadow::reads_cached;
+
+  TMCShadow::TMCShadow(const uint8_t node) : node(node), known(0), dirty(0), synced(0) {
+    if (count < COUNT(list)) list[count++] = this;
+  }
+
+  int8_t TMCShadow::slot(const uint8_t reg) {
+    LOOP_L_N(i, TMC_SHADOW_REGS) if (pgm_read_byte(&shadow_regs[i]) == reg) return i;
+    return -1;
+  }
+
+  bool TMCShadow::write(const uint8_t reg, const uint32_t v) {
+    const int8_t i = slot(reg);
+    if (i < 0) return false;
+    value[i] = v;
+    SBI(known, i);
+    SBI(dirty, i);
+    pending = true;
+    writes_in++;
+    return true;
+  }
+
+  bool TMCShadow::read(const uint8_t reg, uint32_t &v) {
+    const int8_t i = slot(reg);
+    if (i < 0 || !TEST(known, i)) return false;
+    v = value[i];
+    reads_cached++;
+    return true;
+  }
+
+  void TMCShadow::fill(const uint8_t reg, const uint32_t v) {
+    const int8_t i = slot(reg);
+    if (i < 0 || TEST(dirty, i)) return;
+    value[i] = sent[i] = v;
+    SBI(known, i);
+    SBI(synced, i);
+  }
+
+  void TMCShadow::flush() {
+    if (!dirty) return;
+    LOOP_L_N(i, TMC_SHADOW_REGS) if (TEST(dirty, i)) {
+      if (!TEST(synced, i) || sent[i] != value[i]) {  // Changes that cancel out cost nothing
+        tmc_bus.write(node, pgm_read_byte(&shadow_regs[i]), value[i]);
+        sent[i] = value[i];
+        SBI(synced, i);
+        writes_out++;
+      }
+    }
+    dirty = 0;
+  }
+
+  void TMCShadow::flush_all() {
+    if (!pending) return;
+    pending = false;
+    LOOP_L_N(i, count) list[i]->flush();
+  }
+
+  void TMCShadow::report() {
+    SERIAL_ECHOLNPAIR("TMC shadow writes:", writes_in, " sent:", writes_out, " reads cached:", reads_cached);
+  }
+
+#endif // TMC_SHADOW_REGISTERS
+
+#endif // TMC_UART_ASYNC
@@ -0,0 +1,131 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * feature/tmc_bus.h - Interrupt-driven transactions on the shared TMC UART
+ */
+
+#include "../inc/MarlinConfigPre.h"
+
+#ifndef TMC_BUS_QUEUE
+  #define TMC_BUS_QUEUE 16          // Transactions, a power of 2
+#endif
+
+// Called from task() when a read completes. ok is false after a timeout or CRC failure.
+typedef void (*tmc_bus_cb_t)(void * const ctx, const bool ok, const uint32_t value);
+
+class TMCBus {
+public:
+  static void init();                     // Take over the UART once it is open
+
+  // Queue a register write. Only waits if the queue is full.
+  static void write(const uint8_t node, const uint8_t reg, const uint32_t value);
+
+  // Queue a register read. False if the queue is full.
+  static bool read(const uint8_t node, const uint8_t reg, const tmc_bus_cb_t cb, void * const ctx);
+
+  // Read a register, running the queue until the reply is in
+  static bool read_wait(const uint8_t node, const uint8_t reg, uint32_t &value);
+
+  // Run callbacks, timeouts and retries. Called from idle().
+  static void task();
+
+  static void report();
+
+  // Send all pending writes and run the queue until it's empty
+  static void drain();
+
+  // USART1 interrupt hooks
+  static void rx_isr(const uint8_t c);
+  static int16_t tx_isr();
+
+private:
+  typedef struct {
+    uint8_t node, reg;                    // reg has TMC_BUS_WRITE set for writes
+    bool ok;
+    uint32_t value;
+    tmc_bus_cb_t cb;
+    void *ctx;
+  } xfer_t;
+
+  static xfer_t q[TMC_BUS_QUEUE];
+  static volatile uint8_t fill,           // Next free slot
+                          cur,            // On the bus, or next to go
+                          done;           // Next to report
+  static volatile bool busy;              // q[cur] is on the bus
+  static volatile millis_t deadline;
+  static volatile uint32_t quiet_from;    // Cycle count when the bus went idle after a reply
+
+  static uint8_t tx_buf[8], tx_len, tx_pos, rx_buf[8], rx_len, tries;
+  static uint32_t sync;                   // Last 3 bytes received
+  static uint16_t sent, retried, crc_errors, timeouts;
+
+  static uint8_t crc8(const uint8_t * const data, const uint8_t len);
+  static bool enqueue(const uint8_t node, const uint8_t reg, const uint32_t value, const tmc_bus_cb_t cb, void * const ctx);
+  static void start();
+  static void hold();
+  static bool quiet();
+  static void retry();
+  static void finish(const bool ok, const uint32_t value=0);
+};
+
+extern TMCBus tmc_bus;
+
+#if ENABLED(TMC_SHADOW_REGISTERS)
+
+  #define TMC_SHADOW_REGS 11
+
+  /**
+   * A driver's configuration registers kept in RAM. Writes land here and each
+   * changed register goes out once at the next flush. Reads of a register the
+   * firmware has written or read before are answered from here.
+   */
+  class TMCShadow {
+  public:
+    TMCShadow(const uint8_t node);
+
+    bool write(const uint8_t reg, const uint32_t value);   // False if the register isn't shadowed
+    bool read(const uint8_t reg, uint32_t &value);         // False if the chip must be asked
+    void fill(const uint8_t reg, const uint32_t value);    // Take a value read from the chip
+    void invalidate() { synced = 0; }                      // Send every register at the next flush
+    void flush();
+
+    static void flush_all();                               // Queue the writes of every driver
+    static void report();
+
+  private:
+    static TMCShadow *list[16];                            // X, Y, Z and their twins, E0-E7
+    static uint8_t count;
+    static bool pending;                                   // Some driver has dirty registers
+    static uint16_t writes_in, writes_out, reads_cached;
+
+    const uint8_t node;
+    uint16_t known,                                        // Registers with a value here
+             dirty,                                        // Written since the last flush
+             synced;                                       // sent[] matches the chip
+    uint32_t value[TMC_SHADOW_REGS], sent[TMC_SHADOW_REGS];
+
+    static int8_t slot(const uint8_t reg);
+  };
+
+#endif
@@ -145,11 +145,11 @@
       static uint32_t get_pwm_scale(TMC2208Stepper &st) { return st.pwm_scale_sum(); }
     #endif
 
-    static TMC_driver_data get_driver_data(TMC2208Stepper &st) {
+    static TMC_driver_data get_driver_data(TMC2208Stepper&, const uint32_t ds) {
       constexpr uint8_t OTPW_bp = 0, OT_bp = 1;
       constexpr uint8_t S2G_bm = 0b111100; // 2..5
       TMC_driver_data data;
-      const auto ds = data.drv_status = st.DRV_STATUS();
+      data.drv_status = ds;
       data.is_otpw = TEST(ds, OTPW_bp);
       data.is_ot = TEST(ds, OT_bp);
       data.is_s2g = !!(ds & S2G_bm);
@@ -174,6 +174,8 @@
       return data;
     }
 
+    static TMC_driver_data get_driver_data(TMC2208Stepper &st) { return get_driver_data(st, st.DRV_STATUS()); }
+
   #endif // TMC2208 || TMC2209
 
   #if HAS_DRIVER(TMC2660)
@@ -285,7 +287,13 @@
 
   template<typename TMC>
   bool monitor_tmc_driver(TMC &st, const bool need_update_error_counters, const bool need_debug_reporting) {
-    TMC_driver_data data = get_driver_data(st);
+    #if ENABLED(TMC_UART_ASYNC)
+      // Judge the status from the last poll and queue the next one
+      TMC_driver_data data = get_driver_data(st, st.polled_drv_status);
+      st.poll_drv_status();
+    #else
+      TMC_driver_data data = get_driver_data(st);
+    #endif
     if (data.drv_status == 0xFFFFFFFF || data.drv_status == 0x0) return false;
 
     bool should_step_down = false;
@@ -1125,11 +1133,13 @@
 
     st.TCOOLTHRS(0xFFFFF);
     st.en_spreadCycle(false);
+    TERN_(TMC_UART_ASYNC, tmc_bus.drain());   // On the chip before the homing move
     return stealthchop_was_enabled;
   }
   void tmc_disable_stallguard(TMC2209Stepper &st, const bool restore_stealth) {
     st.en_spreadCycle(!restore_stealth);
     st.TCOOLTHRS(0);
+    TERN_(TMC_UART_ASYNC, tmc_bus.drain());
   }
 
   bool tmc_enable_stallguard(TMC2660Stepper) {
@@ -29,6 +29,10 @@
 #include "TMCStepper.h"
 #include "../module/planner.h"
 
+#if ENABLED(TMC_UART_ASYNC)
+  #include "tmc_bus.h"
+#endif
+
 #define CHOPPER_DEFAULT_12V  { 3, -1, 1 }
 #define CHOPPER_DEFAULT_19V  { 4,  1, 1 }
 #define CHOPPER_DEFAULT_24V  { 4,  2, 1 }
@@ -195,6 +199,34 @@ class TMCMarlin<TMC2208Stepper, AXIS_LETTER, DRIVER_ID, AXIS_ID> : public TMC220
       }
     #endif
 
+    #if ENABLED(TMC_UART_ASYNC)
+      // Register access through the interrupt-driven bus. Writes don't wait.
+      void write(uint8_t reg, uint32_t value) override {
+        if (TERN1(TMC_SHADOW_REGISTERS, !shadow.write(reg, value))) tmc_bus.write(slave_address, reg, value);
+      }
+      uint32_t read(uint8_t reg) override {
+        uint32_t value;
+        TERN_(TMC_SHADOW_REGISTERS, if (shadow.read(reg, value)) return value);
+        this->CRCerror = !tmc_bus.read_wait(slave_address, reg, value);
+        TERN_(TMC_SHADOW_REGISTERS, if (!this->CRCerror) shadow.fill(reg, value));
+        return value;
+      }
+
+      #if ENABLED(TMC_SHADOW_REGISTERS)
+        TMCShadow shadow{slave_address};
+        // Send every register again, as after the drivers lost power
+        void push() { shadow.invalidate(); TMC2208Stepper::push(); shadow.flush(); }
+      #endif
+
+      // DRV_STATUS from the last poll, 0 until it answers
+      uint32_t polled_drv_status = 0;
+      void poll_drv_status() {
+        tmc_bus.read(slave_address, TMC2208_n::DRV_STATUS_t::address, [](void * const ctx, const bool ok, const uint32_t ds) {
+          ((TMCMarlin*)ctx)->polled_drv_status = ok ? ds : 0;
+        }, this);
+      }
+    #endif
+
     #if HAS_LCD_MENU
       inline void refresh_stepper_current() { rms_current(this->val_mA); }
 
@@ -251,6 +283,34 @@ class TMCMarlin<TMC2209Stepper, AXIS_LETTER, DRIVER_ID, AXIS_ID> : public TMC220
       }
     #endif
 
+    #if ENABLED(TMC_UART_ASYNC)
+      // Register access through the interrupt-driven bus. Writes don't wait.
+      void write(uint8_t reg, uint32_t value) override {
+        if (TERN1(TMC_SHADOW_REGISTERS, !shadow.write(reg, value))) tmc_bus.write(slave_address, reg, value);
+      }
+      uint32_t read(uint8_t reg) override {
+        uint32_t value;
+        TERN_(TMC_SHADOW_REGISTERS, if (shadow.read(reg, value)) return value);
+        this->CRCerror = !tmc_bus.read_wait(slave_address, reg, value);
+        TERN_(TMC_SHADOW_REGISTERS, if (!this->CRCerror) shadow.fill(reg, value));
+        return value;
+      }
+
+      #if ENABLED(TMC_SHADOW_REGISTERS)
+        TMCShadow shadow{slave_address};
+        // Send every register again, as after the drivers lost power
+        void push() { shadow.invalidate(); TMC2209Stepper::push(); shadow.flush(); }
+      #endif
+
+      // DRV_STATUS from the last poll, 0 until it answers
+      uint32_t polled_drv_status = 0;
+      void poll_drv_status() {
+        tmc_bus.read(slave_address, TMC2208_n::DRV_STATUS_t::address, [](void * const ctx, const bool ok, const uint32_t ds) {
+          ((TMCMarlin*)ctx)->polled_drv_status = ok ? ds : 0;
+        }, this);
+      }
+    #endif
+
     #if HAS_LCD_MENU
       inline void refresh_stepper_current() { rms_current(this->val_mA); }
 
@@ -179,6 +179,7 @@ void GcodeSuite::M420() {
               TERN_(EXTENSIBLE_UI, ExtUI::onMeshUpdate(x, y, Z_VALUES(x, y)));
             }
             TERN_(ABL_BILINEAR_SUBDIVISION, bed_level_virt_interpolate());
+            TERN_(ABL_BICUBIC, bed_level_bicubic_patches());
           }
 
         #endif
@@ -70,6 +70,10 @@
   #include "../../../module/tool_change.h"
 #endif
 
+#if BOTH(G29_ADAPTIVE, SDSUPPORT)
+  #include "../../../feature/print_area.h"
+#endif
+
 #if ABL_GRID
   #if ENABLED(PROBE_Y_FIRST)
     #define PR_OUTER_VAR meshCount.x
@@ -86,6 +90,74 @@
 
 #define G29_RETURN(b) return TERN_(G29_RETRY_AND_RECOVER, b)
 
+#if ENABLED(G29_FAST_PROBING)
+
+  typedef float g29_probed_t[GRID_MAX_POINTS_X][GRID_MAX_POINTS_Y];
+
+  /**
+   * Predict the bed Z at grid point 'm' by extending the plane of the points
+   * probed before it. 'in' steps along the row being probed and 'out' to the
+   * next row. Set 'flat' if those points are within G29_FAST_FLAT of each
+   * other. Return NAN if there's no prediction.
+   */
+  static float g29_predict(const g29_probed_t &pz, const xy_int8_t &m, const xy_int8_t &in, const xy_int8_t &out, bool &flat) {
+    auto at = [&](const xy_int8_t &p) {
+      return WITHIN(p.x, 0, GRID_MAX_POINTS_X - 1) && WITHIN(p.y, 0, GRID_MAX_POINTS_Y - 1) ? pz[p.x][p.y] : NAN;
+    };
+    auto same = [](const float p, const float q) { return ABS(p - q) <= G29_FAST_FLAT; };
+    const float a = at(m - in), a2 = at(m - in - in),   // Back along the row
+                b = at(m - out), b2 = at(m - out - out), // Back along the column
+                c = at(m - in - out);                    // Diagonal
+    flat = false;
+    if (!isnan(a) && !isnan(b) && !isnan(c)) { flat = same(a, c) && same(b, c); return a + b - c; }
+    if (!isnan(a) && !isnan(a2)) { flat = same(a, a2); return a * 2 - a2; }
+    if (!isnan(b) && !isnan(b2)) { flat = same(b, b2); return b * 2 - b2; }
+    return NAN;
+  }
+
+#endif
+
+#if ENABLED(G29_SWEEP_PROBING)
+
+  /**
+   * Fit each grid point to the sweep samples around it: least squares of a
+   * plane, weighted down to nothing at two touch spacings along the rows and
+   * one row pitch across them. Where the samples only make a line, fit that.
+   * Points with no samples near are left NAN for extrapolation.
+   */
+  static void g29_sweep_fit(const xyz_pos_t samples[], const uint16_t n, const xy_pos_t &lf, const xy_pos_t &rb, const xy_float_t &spacing, const float zoffset) {
+    const xy_float_t reach = { 2 * (G29_SWEEP_SPACING), (rb.y - lf.y) / (G29_SWEEP_ROWS - 1) };
+    GRID_LOOP(x, y) {
+      const xy_pos_t p = { lf.x + spacing.x * x, lf.y + spacing.y * y };
+      float sw = 0, su = 0, sv = 0, suu = 0, suv = 0, svv = 0, sz = 0, suz = 0, svz = 0;
+      LOOP_L_N(i, n) {
+        const xyz_pos_t &s = samples[i];
+        const float u = (s.x - p.x) / reach.x, v = (s.y - p.y) / reach.y;
+        if (ABS(u) >= 1 || ABS(v) >= 1) continue;
+        const float w = (1 - ABS(u)) * (1 - ABS(v));
+        sw += w; su += w * u; sv += w * v;
+        suu += w * u * u; suv += w * u * v; svv += w * v * v;
+        sz += w * s.z; suz += w * u * s.z; svz += w * v * s.z;
+      }
+      float z = NAN;
+      if (sw > 0) {
+        const float det3 = sw * (suu * svv - suv * suv) - su * (su * svv - suv * sv) + sv * (su * suv - suu * sv),
+                    det2 = sw * suu - su * su;
+        if (det3 > 1e-3f * sw * sw * sw)
+          z = (sz * (suu * svv - suv * suv) - su * (suz * svv - suv * svz) + sv * (suz * suv - suu * svz)) / det3;
+        else if (det2 > 1e-3f * sw * sw)
+          z = (sz * suu - su * suz) / det2;
+        else
+          z = sz / sw;
+        z += zoffset;
+      }
+      z_values[x][y] = z;
+      TERN_(EXTENSIBLE_UI, ExtUI::onMeshUpdate(x, y, z));
+    }
+  }
+
+#endif
+
 /**
  * G29: Detailed Z probe, probes the bed at 3 or more points.
  *      Will fail if the printer has not been homed with G28.
@@ -139,6 +211,14 @@
  *
  *  Z  Supply an additional Z probe offset
  *
+ *  A  Probe only the grid points around the print area, given by L R F B or H,
+ *     or found in the first layer of the SD file being printed. The rest of
+ *     the stored mesh moves by the change measured there. (G29_ADAPTIVE)
+ *
+ *  U  Sweep the probe over the bed in rows, touching down on the move, and
+ *     fit the grid to the touches. Several times faster, a little less precise.
+ *     (G29_SWEEP_PROBING, experimental)
+ *
  * Extra parameters with PROBE_MANUALLY:
  *
  *  To do manual probing simply repeat G29 until the procedure is complete.
@@ -218,6 +298,13 @@ G29_TYPE GcodeSuite::G29() {
     ABL_VAR xy_pos_t probe_position_lf, probe_position_rb;
     ABL_VAR xy_float_t gridSpacing = { 0, 0 };
 
+    #if ENABLED(G29_ADAPTIVE)
+      bool adaptive = false;
+      xy_int8_t area_lo, area_hi;   // Grid points around the print area
+      float area_shift = 0;         // Sum of the changes from the stored mesh
+      uint8_t area_shifted = 0;
+    #endif
+
     #if ENABLED(AUTO_BED_LEVELING_LINEAR)
       ABL_VAR bool do_topography_map;
       ABL_VAR xy_uint8_t abl_grid_points;
@@ -302,6 +389,7 @@ G29_TYPE GcodeSuite::G29() {
           set_bed_leveling_enabled(false);
           z_values[i][j] = rz;
           TERN_(ABL_BILINEAR_SUBDIVISION, bed_level_virt_interpolate());
+          TERN_(ABL_BICUBIC, bed_level_bicubic_patches());
           TERN_(EXTENSIBLE_UI, ExtUI::onMeshUpdate(i, j, rz));
           set_bed_leveling_enabled(abl_should_enable);
           if (abl_should_enable) report_current_position();
@@ -391,6 +479,41 @@ G29_TYPE GcodeSuite::G29() {
       gridSpacing.set((probe_position_rb.x - probe_position_lf.x) / (abl_grid_points.x - 1),
                       (probe_position_rb.y - probe_position_lf.y) / (abl_grid_points.y - 1));
 
+      #if ENABLED(G29_ADAPTIVE)
+        if (parser.boolval('A')) {
+          xy_pos_t area_lf, area_rb;
+          if (!leveling_is_valid())
+            SERIAL_ECHOLNPGM("No stored mesh. Probing the full grid.");
+          else if (parser.seen('L') || parser.seen('R') || parser.seen('F') || parser.seen('B') || parser.seen('H')) {
+            area_lf = probe_position_lf;
+            area_rb = probe_position_rb;
+            adaptive = true;
+          }
+          else if (TERN0(SDSUPPORT, print_area.get(area_lf, area_rb)))
+            adaptive = true;
+          else
+            SERIAL_ECHOLNPGM("Print area unknown. Probing the full grid.");
+
+          if (adaptive) {
+            // Keep the stored grid. Find its points around the area.
+            probe_position_lf = bilinear_start;
+            gridSpacing = bilinear_grid_spacing;
+            const xy_int8_t last = { GRID_MAX_POINTS_X - 1, GRID_MAX_POINTS_Y - 1 };
+            LOOP_S_LE_N(a, X_AXIS, Y_AXIS) {
+              const float lo = (area_lf[a] - (G29_ADAPTIVE_MARGIN) - bilinear_start[a]) / bilinear_grid_spacing[a],
+                          hi = (area_rb[a] + (G29_ADAPTIVE_MARGIN) - bilinear_start[a]) / bilinear_grid_spacing[a];
+              area_lo[a] = constrain(int(FLOOR(lo)), 0, last[a]);
+              area_hi[a] = constrain(int(CEIL(hi)), 0, last[a]);
+              while (area_hi[a] - area_lo[a] + 1 < G29_ADAPTIVE_MIN_POINTS) {
+                if (area_lo[a] > 0) area_lo[a]--;
+                if (area_hi[a] - area_lo[a] + 1 < G29_ADAPTIVE_MIN_POINTS && area_hi[a] < last[a]) area_hi[a]++;
+              }
+            }
+            SERIAL_ECHOLNPAIR("Probing grid points X", area_lo.x, "-", area_hi.x, " Y", area_lo.y, "-", area_hi.y);
+          }
+        }
+      #endif
+
     #endif // ABL_GRID
 
     if (verbose_level > 0) {
@@ -608,6 +731,39 @@ G29_TYPE GcodeSuite::G29() {
 
       xy_int8_t meshCount;
 
+      #if ENABLED(G29_SWEEP_PROBING)
+        const bool sweep = !faux && TERN1(G29_ADAPTIVE, !adaptive) && parser.boolval('U');
+      #endif
+
+      #if ENABLED(G29_FAST_PROBING)
+        // Sequence the points with low, blended travel unless stowing each time
+        const bool fast_seq = !faux && raise_after == PROBE_PT_RAISE && TERN1(G29_SWEEP_PROBING, !sweep);
+        g29_probed_t probed_z;
+        LOOP_L_N(x, GRID_MAX_POINTS_X) LOOP_L_N(y, GRID_MAX_POINTS_Y) probed_z[x][y] = NAN;
+        bool from_touch = false;
+        float last_miss = NAN;  // How far the last point was from its prediction
+        if (fast_seq) probe.fast_begin();
+      #endif
+
+      #if ENABLED(G29_SWEEP_PROBING)
+        if (sweep) {
+          // The samples are only needed for the fit, so take them from the heap
+          xyz_pos_t * const samples = (xyz_pos_t*)malloc(G29_SWEEP_MAX_SAMPLES * sizeof(xyz_pos_t));
+          const uint16_t n = samples ? probe.sweep(probe_position_lf, probe_position_rb, samples, G29_SWEEP_MAX_SAMPLES, verbose_level) : 0;
+          if (n) {
+            g29_sweep_fit(samples, n, probe_position_lf, probe_position_rb, gridSpacing, zoffset);
+            abl_should_enable = false;
+          }
+          else {
+            if (!samples) SERIAL_ERROR_MSG("No memory for the sweep.");
+            measured_z = NAN;
+            set_bed_leveling_enabled(abl_should_enable);
+          }
+          free(samples);
+        }
+        else
+      #endif
+
       // Outer loop is X with PROBE_Y_FIRST enabled
       // Outer loop is Y with PROBE_Y_FIRST disabled
       for (PR_OUTER_VAR = 0; PR_OUTER_VAR < PR_OUTER_END && !isnan(measured_z); PR_OUTER_VAR++) {
@@ -627,6 +783,11 @@ G29_TYPE GcodeSuite::G29() {
 
         zig ^= true; // zag
 
+        #if ENABLED(G29_FAST_PROBING)
+          const xy_int8_t in = { TERN(PROBE_Y_FIRST, 0, inInc), TERN(PROBE_Y_FIRST, inInc, 0) },
+                         out = { TERN(PROBE_Y_FIRST, 1, 0), TERN(PROBE_Y_FIRST, 0, 1) };
+        #endif
+
         // An index to print current state
         uint8_t pt_index = (PR_OUTER_VAR) * (PR_INNER_END) + 1;
 
@@ -642,9 +803,27 @@ G29_TYPE GcodeSuite::G29() {
           // Avoid probing outside the round or hexagonal area
           if (TERN0(IS_KINEMATIC, !probe.can_reach(probePos))) continue;
 
+          #if ENABLED(G29_ADAPTIVE)
+            if (adaptive && !(WITHIN(meshCount.x, area_lo.x, area_hi.x) && WITHIN(meshCount.y, area_lo.y, area_hi.y))) continue;
+          #endif
+
           if (verbose_level) SERIAL_ECHOLNPAIR("Probing mesh point ", int(pt_index), "/", abl_points, ".");
           TERN_(HAS_DISPLAY, ui.status_printf_P(0, PSTR(S_FMT " %i/%i"), GET_TEXT(MSG_PROBING_MESH), int(pt_index), int(abl_points)));
 
+          #if ENABLED(G29_FAST_PROBING)
+            if (fast_seq) {
+              // Travel low where the neighbors are flat, or the last prediction held
+              bool flat;
+              const float predicted_z = g29_predict(probed_z, meshCount, in, out, flat);
+              const ProbeTravel travel = !from_touch ? PROBE_TRAVEL_FIRST
+                : !isnan(predicted_z) && (flat || last_miss <= G29_FAST_FLAT) ? PROBE_TRAVEL_LOW : PROBE_TRAVEL_HIGH;
+              measured_z = probe.probe_at_point_fast(probePos, predicted_z, travel, verbose_level);
+              probed_z[meshCount.x][meshCount.y] = measured_z;
+              last_miss = ABS(measured_z - predicted_z);
+              from_touch = true;
+            }
+            else
+          #endif
           measured_z = faux ? 0.001f * random(-100, 101) : probe.probe_at_point(probePos, raise_after, verbose_level);
 
           if (isnan(measured_z)) {
@@ -671,6 +850,12 @@ G29_TYPE GcodeSuite::G29() {
           #elif ENABLED(AUTO_BED_LEVELING_BILINEAR)
 
             const float z = measured_z + zoffset;
+            #if ENABLED(G29_ADAPTIVE)
+              if (adaptive && !isnan(z_values[meshCount.x][meshCount.y])) {
+                area_shift += z - z_values[meshCount.x][meshCount.y];
+                area_shifted++;
+              }
+            #endif
             z_values[meshCount.x][meshCount.y] = z;
             TERN_(EXTENSIBLE_UI, ExtUI::onMeshUpdate(meshCount, z));
 
@@ -682,6 +867,21 @@ G29_TYPE GcodeSuite::G29() {
         } // inner
       } // outer
 
+      TERN_(G29_FAST_PROBING, if (fast_seq) probe.fast_end(!isnan(measured_z)));
+
+      #if ENABLED(G29_ADAPTIVE)
+        // Move the rest of the stored mesh by the mean change around the print area
+        if (adaptive && area_shifted && !isnan(measured_z)) {
+          const float shift = area_shift / area_shifted;
+          GRID_LOOP(x, y) {
+            if ((WITHIN(x, area_lo.x, area_hi.x) && WITHIN(y, area_lo.y, area_hi.y)) || isnan(z_values[x][y])) continue;
+            z_values[x][y] += shift;
+            TERN_(EXTENSIBLE_UI, ExtUI::onMeshUpdate(x, y, z_values[x][y]));
+          }
+          SERIAL_ECHOLNPAIR("Stored mesh moved by ", shift);
+        }
+      #endif
+
     #elif ENABLED(AUTO_BED_LEVELING_3POINT)
 
       // Probe at 3 arbitrary points
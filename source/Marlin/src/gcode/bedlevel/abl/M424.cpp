@@ -0,0 +1,170 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * M424.cpp - Named mesh slots
+ */
+
+#include "../../../inc/MarlinConfig.h"
+
+#if ENABLED(ABL_MESH_SLOTS)
+
+#include "../../gcode.h"
+#include "../../../feature/bedlevel/bedlevel.h"
+#include "../../../module/planner.h"
+#include "../../../module/settings.h"
+#include "../../../module/temperature.h"
+
+#if ENABLED(EXTENSIBLE_UI)
+  #include "../../../lcd/extui/ui_api.h"
+#endif
+
+// The bed target, or the bed temperature when there's no target
+static int16_t bed_temp_now() {
+  #if HAS_HEATED_BED
+    const int16_t target = thermalManager.degTargetBed();
+    return target ? target : int16_t(LROUND(thermalManager.degBed()));
+  #else
+    return 0;
+  #endif
+}
+
+// Swap in a slot's mesh with leveling off, then turn leveling on.
+// A failed load leaves the mesh and leveling as they were.
+static bool load_slot(const uint8_t slot) {
+  const bool was_active = planner.leveling_active;
+  set_bed_leveling_enabled(false);
+  if (!settings.load_mesh(slot)) {
+    set_bed_leveling_enabled(was_active);
+    return false;
+  }
+  set_bed_leveling_enabled(true);
+  SERIAL_ECHO_MSG("Mesh slot ", int(slot), " loaded");
+  return true;
+}
+
+/**
+ * M424: Named mesh slots
+ *
+ *   M424                     List the slots
+ *   M424 S<slot> [T<°C>] ["name"]
+ *                            Save the current mesh, with the bed temperature
+ *                            it was probed at (default: the bed target)
+ *   M424 L<slot>             Load a slot and enable leveling
+ *   M424 A [T<°C>] [G]       Load the slot probed nearest the bed target,
+ *                            within MESH_SLOT_TEMP_RANGE. With G, probe with
+ *                            G29 if none matches or it fails to load, and
+ *                            save it in a free slot.
+ *   M424 D<slot>             Delete a slot
+ *
+ * The parameters come first, then the slot name in double quotes.
+ */
+void GcodeSuite::M424() {
+  char op = 0;
+  int16_t slot = -1, bed_temp = bed_temp_now();
+  bool probe = false;
+
+  const char *name = "";
+  char *p = parser.string_arg;
+  while (p && *p) {
+    if (*p == '"') {              // The name, up to the closing quote
+      name = ++p;
+      char * const q = strchr(p, '"');
+      if (q) *q = '\0';
+      break;
+    }
+    // A letter and a number, or A or G alone, then a space or the end
+    const char c = p[0];
+    char *e;
+    const long v = strtol(p + 1, &e, 10);
+    if (!strchr("SLDATG", c) || (e == p + 1 && c != 'A' && c != 'G') || (*e && *e != ' ')) {
+      SERIAL_ECHOLNPGM("?Put the slot name in double quotes.");
+      return;
+    }
+    switch (c) {
+      case 'S': case 'L': case 'D': op = c; slot = v; break;
+      case 'A': op = c; break;
+      case 'T': bed_temp = v; break;
+      case 'G': probe = true; break;
+    }
+    p = e;
+    while (*p == ' ') ++p;
+  }
+
+  if (op != 0 && op != 'A' && !WITHIN(slot, 0, MESH_SLOTS_MAX - 1)) {
+    SERIAL_ECHOLNPAIR("?Use slot 0 to ", MESH_SLOTS_MAX - 1);
+    return;
+  }
+
+  switch (op) {
+    case 'S':
+      if (settings.store_mesh(slot, name, bed_temp)) SERIAL_ECHO_MSG("Mesh saved in slot ", slot);
+      break;
+
+    case 'L': (void)load_slot(slot); break;
+
+    case 'D':
+      if (settings.delete_mesh(slot)) SERIAL_ECHO_MSG("Mesh slot ", slot, " deleted");
+      break;
+
+    case 'A': {
+      const int8_t found = settings.find_mesh(bed_temp);
+      if (found >= 0 && load_slot(found)) break;
+      if (found < 0) SERIAL_ECHO_MSG("No mesh slot for bed ", bed_temp, "C");
+      if (!probe) break;
+
+      // Start from an empty grid so a failed G29 leaves nothing to save,
+      // and put the mesh in RAM back if it fails
+      const bool was_active = planner.leveling_active;
+      const xy_pos_t old_start = bilinear_start, old_spacing = bilinear_grid_spacing;
+      bed_mesh_t old_z;
+      COPY(old_z, z_values);
+
+      reset_bed_level();
+      process_subcommands_now_P(PSTR("G29"));
+      bool probed = leveling_is_valid();
+      GRID_LOOP(x, y) if (isnan(z_values[x][y])) probed = false;
+      if (!probed) {
+        set_bed_leveling_enabled(false);
+        bilinear_start = old_start;
+        bilinear_grid_spacing = old_spacing;
+        COPY(z_values, old_z);
+        #if ENABLED(EXTENSIBLE_UI)
+          GRID_LOOP(x, y) ExtUI::onMeshUpdate(x, y, z_values[x][y]);
+        #endif
+        refresh_bed_level();
+        set_bed_leveling_enabled(was_active);
+        SERIAL_ECHO_MSG("Probing failed. Mesh restored.");
+        break;
+      }
+      const int8_t free = settings.free_mesh();
+      if (free < 0) { SERIAL_ECHO_MSG("?Mesh slots full."); break; }
+      char auto_name[MESH_SLOT_NAME_LEN + 1];
+      sprintf_P(auto_name, PSTR("bed %i"), int(bed_temp));
+      if (settings.store_mesh(free, auto_name, bed_temp)) SERIAL_ECHO_MSG("Mesh saved in slot ", int(free));
+    } break;
+
+    default: settings.list_meshes(); break;
+  }
+}
+
+#endif // ABL_MESH_SLOTS
@@ -35,11 +35,28 @@
   #include "../../module/planner.h"
 #endif
 
+#include "../../module/temperature.h"
+
+// Least-squares line through (x, y) pairs, accumulated one sample at a time
+typedef struct {
+  uint8_t n;
+  float sx, sy, sxx, sxy, syy;
+  void add(const float x, const float y) { n++; sx += x; sy += y; sxx += x * x; sxy += x * y; syy += y * y; }
+  float spread_x() const { return n * sxx - sq(sx); }
+  float slope() const { return (n * sxy - sx * sy) / spread_x(); }
+  float intercept() const { return (sy - slope() * sx) / n; }
+  float r() const {
+    const float d = spread_x() * (n * syy - sq(sy));
+    return d > 0 ? (n * sxy - sx * sy) / SQRT(d) : 0;
+  }
+  bool usable(const float min_spread) const { return n > 2 && spread_x() > sq(n * min_spread); }
+} line_fit_t;
+
 /**
  * M48: Z probe repeatability measurement function.
  *
  * Usage:
- *   M48 <P#> <X#> <Y#> <V#> <E> <L#> <S>
+ *   M48 <P#> <X#> <Y#> <V#> <E> <L#> <S> <R#> <A#> <B#> <C>
  *     P = Number of sampled points (4-50, default 10)
  *     X = Sample X position
  *     Y = Sample Y position
@@ -47,6 +64,15 @@
  *     E = Engage Z probe for each reading
  *     L = Number of legs of movement before probe
  *     S = Schizoid (Or Star if you prefer)
+ *     R = Number of probing speeds to sweep (1-8, default 1)
+ *     A = Slowest speed, in percent of Z_PROBE_SPEED_FAST/SLOW (10-400, default 50 for a sweep, else 100)
+ *     B = Fastest speed, in percent (default 200 for a sweep)
+ *     C = Output CSV: one row per sample, then one per speed
+ *
+ * Each sample also reports its cycle time, tare time with PROBE_TARE, and the
+ * probe's trigger latency taken from the gap between its fast and slow touches. A single-speed
+ * test fits Z against time and temperatures to show drift. A sweep fits the
+ * mean Z of each speed against the speed.
  *
  * This function requires the machine to be homed before invocation.
  */
@@ -99,6 +125,21 @@ void GcodeSuite::M48() {
   const bool schizoid_flag = parser.boolval('S');
   if (schizoid_flag && !seen_L) n_legs = 7;
 
+  // Sweep the probing speeds from A to B percent in R steps
+  const uint8_t n_speeds = parser.byteval('R', 1);
+  if (!WITHIN(n_speeds, 1, 8)) {
+    SERIAL_ECHOLNPGM("?Speed count implausible (1-8).");
+    return;
+  }
+  const float speed_lo = parser.floatval('A', n_speeds > 1 ? 50 : 100),
+              speed_hi = n_speeds > 1 ? parser.floatval('B', 200) : speed_lo;
+  if (!WITHIN(speed_lo, 10, 400) || !WITHIN(speed_hi, speed_lo, 400)) {
+    SERIAL_ECHOLNPGM("?Speed range implausible (10-400%).");
+    return;
+  }
+
+  const bool csv = parser.boolval('C');
+
   if (verbose_level > 2)
     SERIAL_ECHOLNPGM("Positioning the probe...");
 
@@ -119,6 +160,28 @@ void GcodeSuite::M48() {
         max = -99999.9, // Largest value sampled so far
         sample_set[n_samples];  // Storage for sampled values
 
+  // Timing of the current speed
+  millis_t cycle_sum, cycle_min, cycle_max;
+  TERN_(PROBE_TARE, millis_t tare_sum);
+  float latency_sum, latency_sq;
+  uint8_t latency_n;
+
+  // Results of each speed
+  typedef struct { float pct, mean, sigma, min, max, cycle, latency; } speed_result_t;
+  speed_result_t result[n_speeds];
+
+  // Z against minutes, bed and hotend temperature, for a single speed
+  line_fit_t by_time{0}, by_bed{0}, by_hotend{0};
+
+  // Mean Z against the touch speed, for a sweep. The touches go into
+  // the result as run_z_probe weighs them.
+  line_fit_t by_speed{0};
+  #if TOTAL_PROBING == 2
+    constexpr float touch_mm_s = MMM_TO_MMS((Z_PROBE_SPEED_FAST) * 0.4f + (Z_PROBE_SPEED_SLOW) * 0.6f);
+  #else
+    constexpr float touch_mm_s = MMM_TO_MMS(Z_PROBE_SPEED_SLOW);
+  #endif
+
   auto dev_report = [](const bool verbose, const float &mean, const float &sigma, const float &min, const float &max, const bool final=false) {
     if (verbose) {
       SERIAL_ECHOPAIR_F("Mean: ", mean, 6);
@@ -141,123 +204,262 @@ void GcodeSuite::M48() {
   if (probing_good) {
 //    randomSeed(millis());
 
-    float sample_sum = 0.0;
-
-    LOOP_L_N(n, n_samples) {
-      #if HAS_WIRED_LCD
-        // Display M48 progress in the status bar
-        ui.status_printf_P(0, PSTR(S_FMT ": %d/%d"), GET_TEXT(MSG_M48_POINT), int(n + 1), int(n_samples));
-      #endif
-
-      // When there are "legs" of movement move around the point before probing
-      if (n_legs) {
-
-        // Pick a random direction, starting angle, and radius
-        const int dir = (random(0, 10) > 5.0) ? -1 : 1;  // clockwise or counter clockwise
-        float angle = random(0, 360);
-        const float radius = random(
-          #if ENABLED(DELTA)
-            int(0.1250000000 * (DELTA_PRINTABLE_RADIUS)),
-            int(0.3333333333 * (DELTA_PRINTABLE_RADIUS))
-          #else
-            int(5), int(0.125 * _MIN(X_BED_SIZE, Y_BED_SIZE))
-          #endif
-        );
-        if (verbose_level > 3) {
-          SERIAL_ECHOPAIR("Start radius:", radius, " angle:", angle, " dir:");
-          if (dir > 0) SERIAL_CHAR('C');
-          SERIAL_ECHOLNPGM("CW");
-        }
+    if (csv) SERIAL_ECHOLNPGM("sample,speed_pct,z,cycle_ms," TERN_(PROBE_TARE, "tare_ms,") "latency_ms,hotend,bed");
+
+    const millis_t start_ms = millis();
+    const float hotend_start = TERN0(HAS_HOTEND, thermalManager.degHotend(0)),
+                bed_start = TERN0(HAS_HEATED_BED, thermalManager.degBed());
+    uint8_t count = 0;
+
+    LOOP_L_N(s, n_speeds) {
+      const float pct = speed_lo + (n_speeds > 1 ? (speed_hi - speed_lo) * s / (n_speeds - 1) : 0);
+      probe.speed_scale = pct * 0.01f;
+      if (n_speeds > 1 && !csv && verbose_level > 0)
+        SERIAL_ECHOLNPAIR("Probe speed ", int(pct), "%: ", z_probe_fast_mm_s * probe.speed_scale, "/", MMM_TO_MMS(Z_PROBE_SPEED_SLOW) * probe.speed_scale, " mm/s");
+
+      float sample_sum = 0.0;
+      mean = sigma = 0.0;
+      min = 99999.9;
+      max = -99999.9;
+      cycle_sum = cycle_max = 0;
+      TERN_(PROBE_TARE, tare_sum = 0);
+      cycle_min = 999999;
+      latency_sum = latency_sq = 0;
+      latency_n = 0;
+
+      LOOP_L_N(n, n_samples) {
+        #if HAS_WIRED_LCD
+          // Display M48 progress in the status bar
+          ui.status_printf_P(0, PSTR(S_FMT ": %d/%d"), GET_TEXT(MSG_M48_POINT), int(count + 1), int(n_samples * n_speeds));
+        #endif
+
+        const millis_t cycle_start = millis();
+
+        // When there are "legs" of movement move around the point before probing
+        if (n_legs) {
+
+          // Pick a random direction, starting angle, and radius
+          const int dir = (random(0, 10) > 5.0) ? -1 : 1;  // clockwise or counter clockwise
+          float angle = random(0, 360);
+          const float radius = random(
+            #if ENABLED(DELTA)
+              int(0.1250000000 * (DELTA_PRINTABLE_RADIUS)),
+              int(0.3333333333 * (DELTA_PRINTABLE_RADIUS))
+            #else
+              int(5), int(0.125 * _MIN(X_BED_SIZE, Y_BED_SIZE))
+            #endif
+          );
+          if (verbose_level > 3) {
+            SERIAL_ECHOPAIR("Start radius:", radius, " angle:", angle, " dir:");
+            if (dir > 0) SERIAL_CHAR('C');
+            SERIAL_ECHOLNPGM("CW");
+          }
 
-        // Move from leg to leg in rapid succession
-        LOOP_L_N(l, n_legs - 1) {
+          // Move from leg to leg in rapid succession
+          LOOP_L_N(l, n_legs - 1) {
 
-          // Move some distance around the perimeter
-          float delta_angle;
-          if (schizoid_flag) {
-            // The points of a 5 point star are 72 degrees apart.
-            // Skip a point and go to the next one on the star.
-            delta_angle = dir * 2.0 * 72.0;
-          }
-          else {
-            // Just move further along the perimeter.
-            delta_angle = dir * (float)random(25, 45);
-          }
-          angle += delta_angle;
-
-          // Trig functions work without clamping, but just to be safe...
-          while (angle > 360.0f) angle -= 360.0f;
-          while (angle < 0.0f) angle += 360.0f;
-
-          // Choose the next position as an offset to chosen test position
-          const xy_pos_t noz_pos = test_position - probe.offset_xy;
-          xy_pos_t next_pos = {
-            noz_pos.x + float(cos(RADIANS(angle))) * radius,
-            noz_pos.y + float(sin(RADIANS(angle))) * radius
-          };
-
-          #if ENABLED(DELTA)
-            // If the probe can't reach the point on a round bed...
-            // Simply scale the numbers to bring them closer to origin.
-            while (!probe.can_reach(next_pos)) {
-              next_pos *= 0.8f;
-              if (verbose_level > 3)
-                SERIAL_ECHOLNPAIR_P(PSTR("Moving inward: X"), next_pos.x, SP_Y_STR, next_pos.y);
+            // Move some distance around the perimeter
+            float delta_angle;
+            if (schizoid_flag) {
+              // The points of a 5 point star are 72 degrees apart.
+              // Skip a point and go to the next one on the star.
+              delta_angle = dir * 2.0 * 72.0;
             }
-          #else
-            // For a rectangular bed just keep the probe in bounds
-            LIMIT(next_pos.x, X_MIN_POS, X_MAX_POS);
-            LIMIT(next_pos.y, Y_MIN_POS, Y_MAX_POS);
-          #endif
+            else {
+              // Just move further along the perimeter.
+              delta_angle = dir * (float)random(25, 45);
+            }
+            angle += delta_angle;
+
+            // Trig functions work without clamping, but just to be safe...
+            while (angle > 360.0f) angle -= 360.0f;
+            while (angle < 0.0f) angle += 360.0f;
+
+            // Choose the next position as an offset to chosen test position
+            const xy_pos_t noz_pos = test_position - probe.offset_xy;
+            xy_pos_t next_pos = {
+              noz_pos.x + float(cos(RADIANS(angle))) * radius,
+              noz_pos.y + float(sin(RADIANS(angle))) * radius
+            };
+
+            #if ENABLED(DELTA)
+              // If the probe can't reach the point on a round bed...
+              // Simply scale the numbers to bring them closer to origin.
+              while (!probe.can_reach(next_pos)) {
+                next_pos *= 0.8f;
+                if (verbose_level > 3)
+                  SERIAL_ECHOLNPAIR_P(PSTR("Moving inward: X"), next_pos.x, SP_Y_STR, next_pos.y);
+              }
+            #else
+              // For a rectangular bed just keep the probe in bounds
+              LIMIT(next_pos.x, X_MIN_POS, X_MAX_POS);
+              LIMIT(next_pos.y, Y_MIN_POS, Y_MAX_POS);
+            #endif
+
+            if (verbose_level > 3)
+              SERIAL_ECHOLNPAIR_P(PSTR("Going to: X"), next_pos.x, SP_Y_STR, next_pos.y);
+
+            do_blocking_move_to_xy(next_pos);
+          } // n_legs loop
+        } // n_legs
+
+        // Probe a single point
+        const float pz = probe.probe_at_point(test_position, raise_after, 0);
+
+        // Break the loop if the probe fails
+        probing_good = !isnan(pz);
+        if (!probing_good) break;
+
+        // Store the new sample
+        sample_set[n] = pz;
+
+        // Keep track of the largest and smallest samples
+        NOMORE(min, pz);
+        NOLESS(max, pz);
+
+        // Get the mean value of all samples thus far
+        sample_sum += pz;
+        mean = sample_sum / (n + 1);
+
+        // Calculate the standard deviation so far.
+        // The value after the last sample will be the final output.
+        float dev_sum = 0.0;
+        LOOP_LE_N(j, n) dev_sum += sq(sample_set[j] - mean);
+        sigma = SQRT(dev_sum / (n + 1));
+
+        // Time from the start of the legs to the end of the probe
+        const millis_t cycle_ms = millis() - cycle_start;
+        cycle_sum += cycle_ms;
+        NOMORE(cycle_min, cycle_ms);
+        NOLESS(cycle_max, cycle_ms);
+
+        #if ENABLED(PROBE_TARE)
+          const millis_t tare_ms = probe.tare_ms;
+          tare_sum += tare_ms;
+        #endif
+
+        const float latency_ms = probe.trigger_latency * 1000;
+        if (!isnan(latency_ms)) {
+          latency_sum += latency_ms;
+          latency_sq += sq(latency_ms);
+          latency_n++;
+        }
 
-          if (verbose_level > 3)
-            SERIAL_ECHOLNPAIR_P(PSTR("Going to: X"), next_pos.x, SP_Y_STR, next_pos.y);
+        const float hotend_temp = TERN0(HAS_HOTEND, thermalManager.degHotend(0)),
+                    bed_temp = TERN0(HAS_HEATED_BED, thermalManager.degBed());
+        if (n_speeds == 1) {
+          by_time.add((millis() - start_ms) / 60000.0f, pz - t);
+          by_hotend.add(hotend_temp - hotend_start, pz - t);
+          by_bed.add(bed_temp - bed_start, pz - t);
+        }
 
-          do_blocking_move_to_xy(next_pos);
-        } // n_legs loop
-      } // n_legs
+        count++;
 
-      // Probe a single point
-      const float pz = probe.probe_at_point(test_position, raise_after, 0);
+        if (csv) {
+          SERIAL_ECHO(int(count));
+          SERIAL_ECHOPAIR(",", int(pct));
+          SERIAL_ECHOPAIR_F(",", pz, 4);
+          SERIAL_ECHOPAIR(",", cycle_ms, ",");
+          #if ENABLED(PROBE_TARE)
+            SERIAL_ECHO(tare_ms);
+            SERIAL_CHAR(',');
+          #endif
+          if (!isnan(latency_ms)) SERIAL_DECIMAL(latency_ms);
+          SERIAL_ECHOPAIR_F(",", hotend_temp, 2);
+          SERIAL_ECHOLNPAIR_F(",", bed_temp, 2);
+        }
+        else if (verbose_level > 1) {
+          SERIAL_ECHO(n + 1);
+          SERIAL_ECHOPAIR(" of ", int(n_samples));
+          SERIAL_ECHOPAIR_F(": z: ", pz, 3);
+          SERIAL_CHAR(' ');
+          dev_report(verbose_level > 2, mean, sigma, min, max);
+          SERIAL_ECHOPAIR(" Cycle: ", cycle_ms, "ms");
+          TERN_(PROBE_TARE, SERIAL_ECHOPAIR(" Tare: ", tare_ms, "ms"));
+          if (!isnan(latency_ms)) SERIAL_ECHOPAIR(" Latency: ", latency_ms, "ms");
+          SERIAL_EOL();
+        }
+
+      } // n_samples loop
 
-      // Break the loop if the probe fails
-      probing_good = !isnan(pz);
       if (!probing_good) break;
 
-      // Store the new sample
-      sample_set[n] = pz;
-
-      // Keep track of the largest and smallest samples
-      NOMORE(min, pz);
-      NOLESS(max, pz);
-
-      // Get the mean value of all samples thus far
-      sample_sum += pz;
-      mean = sample_sum / (n + 1);
-
-      // Calculate the standard deviation so far.
-      // The value after the last sample will be the final output.
-      float dev_sum = 0.0;
-      LOOP_LE_N(j, n) dev_sum += sq(sample_set[j] - mean);
-      sigma = SQRT(dev_sum / (n + 1));
-
-      if (verbose_level > 1) {
-        SERIAL_ECHO(n + 1);
-        SERIAL_ECHOPAIR(" of ", int(n_samples));
-        SERIAL_ECHOPAIR_F(": z: ", pz, 3);
-        SERIAL_CHAR(' ');
-        dev_report(verbose_level > 2, mean, sigma, min, max);
-        SERIAL_EOL();
-      }
+      speed_result_t &r = result[s];
+      r.pct = pct;
+      r.mean = mean;
+      r.sigma = sigma;
+      r.min = min;
+      r.max = max;
+      r.cycle = float(cycle_sum) / n_samples;
+      r.latency = latency_n ? latency_sum / latency_n : NAN;
 
-    } // n_samples loop
+      by_speed.add(touch_mm_s * probe.speed_scale, mean - t);
+
+    } // n_speeds loop
   }
 
+  probe.speed_scale = 1;
   probe.stow();
 
   if (probing_good) {
     SERIAL_ECHOLNPGM("Finished!");
-    dev_report(verbose_level > 0, mean, sigma, min, max, true);
+
+    auto fit_report = [](PGM_P const name, const line_fit_t &fit, PGM_P const unit) {
+      serialprintPGM(name);
+      SERIAL_ECHOPAIR_F(": ", fit.slope(), 5);
+      serialprintPGM(unit);
+      SERIAL_ECHOLNPAIR_F(" r: ", fit.r(), 2);
+    };
+
+    if (csv) {
+      SERIAL_ECHOLNPGM("speed_pct,mean,sigma,min,max,cycle_ms,latency_ms");
+      LOOP_L_N(s, n_speeds) {
+        const speed_result_t &r = result[s];
+        SERIAL_ECHO(int(r.pct));
+        SERIAL_ECHOPAIR_F(",", r.mean, 4);
+        SERIAL_ECHOPAIR_F(",", r.sigma, 4);
+        SERIAL_ECHOPAIR_F(",", r.min, 4);
+        SERIAL_ECHOPAIR_F(",", r.max, 4);
+        SERIAL_ECHOPAIR_F(",", r.cycle, 0);
+        SERIAL_CHAR(',');
+        if (!isnan(r.latency)) SERIAL_DECIMAL(r.latency);
+        SERIAL_EOL();
+      }
+    }
+    else if (n_speeds > 1) {
+      LOOP_L_N(s, n_speeds) {
+        const speed_result_t &r = result[s];
+        SERIAL_ECHOPAIR("Speed ", int(r.pct), "%: ");
+        dev_report(true, r.mean, r.sigma, r.min, r.max);
+        SERIAL_ECHOPAIR_F(" Cycle: ", r.cycle, 0);
+        SERIAL_ECHOPGM("ms");
+        if (!isnan(r.latency)) SERIAL_ECHOPAIR(" Latency: ", r.latency, "ms");
+        SERIAL_EOL();
+      }
+    }
+    else {
+      dev_report(verbose_level > 0, mean, sigma, min, max, true);
+
+      SERIAL_ECHOPAIR("Cycle ms: Mean: ", cycle_sum / n_samples, " Min: ", cycle_min, " Max: ", cycle_max);
+      TERN_(PROBE_TARE, SERIAL_ECHOPAIR(" Tare: ", tare_sum / n_samples));
+      SERIAL_EOL();
+      if (latency_n) {
+        const float latency_mean = latency_sum / latency_n;
+        SERIAL_ECHOPAIR("Trigger latency ms: Mean: ", latency_mean);
+        SERIAL_ECHOLNPAIR(" Sigma: ", SQRT(_MAX(0, latency_sq / latency_n - sq(latency_mean))));
+      }
+
+      // Drift, where there was enough time or temperature change to fit it
+      if (by_time.usable(0.1f)) fit_report(PSTR("Drift"), by_time, PSTR("mm/min"));
+      if (by_bed.usable(0.2f)) fit_report(PSTR("Bed drift"), by_bed, PSTR("mm/C"));
+      if (by_hotend.usable(0.2f)) fit_report(PSTR("Hotend drift"), by_hotend, PSTR("mm/C"));
+    }
+
+    // Z = Z at rest - speed * latency
+    if (n_speeds > 1) {
+      SERIAL_ECHOPAIR_F("Speed fit: Z at rest: ", t + by_speed.intercept(), 4);
+      SERIAL_ECHOLNPAIR(" Latency: ", -1000 * by_speed.slope(), "ms");
+    }
 
     #if HAS_WIRED_LCD
       // Display M48 results in the status bar
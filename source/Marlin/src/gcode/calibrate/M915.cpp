@@ -0,0 +1,137 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "../../inc/MarlinConfig.h"
+
+#if ENABLED(SENSORLESS_FAST_HOMING)
+
+#include "../gcode.h"
+#include "../../module/motion.h"
+
+extern const char SP_X_STR[], SP_Y_STR[];
+
+void M915_report(const bool eeprom=false) {
+  serialprintPGM(eeprom ? PSTR("  M915") : PSTR("M915"));
+  if (isnan(stall_offset.x) && isnan(stall_offset.y)) SERIAL_ECHOPGM(" S0");
+  #if X_SENSORLESS
+    if (!isnan(stall_offset.x)) SERIAL_ECHOPAIR_P(SP_X_STR, LINEAR_UNIT(stall_offset.x));
+  #endif
+  #if Y_SENSORLESS
+    if (!isnan(stall_offset.y)) SERIAL_ECHOPAIR_P(SP_Y_STR, LINEAR_UNIT(stall_offset.y));
+  #endif
+  SERIAL_EOL();
+}
+
+/**
+ * M915: Sensorless fast homing
+ *
+ * Calibrated axes home in a single approach at SENSORLESS_FAST_HOMING_FEEDRATE_MM_M
+ * and no bump, then take off the stall offset. Others home the normal way.
+ *
+ * Usage:
+ *   M915 C [X] [Y] [P#]  Calibrate: home the normal way, then pair each fast
+ *                        approach with a bumped one and keep the mean offset
+ *   M915 R [X] [Y] [P#]  Report where the fast home lands against the bumped home
+ *   M915 X# Y#           Set the stall offsets (mm)
+ *   M915 S0              Forget the offsets and home the normal way
+ *   M915                 Report the offsets
+ *
+ *     P = Approaches per axis (2-50, default SENSORLESS_FAST_HOMING_SAMPLES)
+ *
+ * Use M500 to save the offsets. Recalibrate after changing M914.
+ */
+void GcodeSuite::M915() {
+
+  const bool calibrate = parser.seen('C'), check = !calibrate && parser.seen('R');
+
+  if (calibrate || check) {
+    const uint8_t n_samples = parser.byteval('P', SENSORLESS_FAST_HOMING_SAMPLES);
+    if (!WITHIN(n_samples, 2, 50)) {
+      SERIAL_ECHOLNPGM("?Sample size not plausible (2-50).");
+      return;
+    }
+
+    bool axis_on[XY] = { TERN0(X_SENSORLESS, parser.seen('X')), TERN0(Y_SENSORLESS, parser.seen('Y')) };
+    if (!axis_on[X_AXIS] && !axis_on[Y_AXIS]) {
+      axis_on[X_AXIS] = ENABLED(X_SENSORLESS);
+      axis_on[Y_AXIS] = ENABLED(Y_SENSORLESS);
+    }
+
+    if (check) LOOP_L_N(a, XY) if (axis_on[a] && isnan(stall_offset[a])) {
+      SERIAL_CHAR(axis_codes[a]);
+      SERIAL_ECHOLNPGM(" not calibrated. Use M915 C.");
+      return;
+    }
+
+    // Samples are taken in G28, after the normal home of each axis
+    const xy_float_t saved_offset = stall_offset;
+    stall_offset.set(NAN, NAN);
+    stall_sample_count = n_samples;
+    process_subcommands_now_P(
+      axis_on[X_AXIS] && axis_on[Y_AXIS] ? PSTR("G28XY") : axis_on[X_AXIS] ? PSTR("G28X") : PSTR("G28Y")
+    );
+    stall_sample_count = 0;
+    stall_offset = saved_offset;
+
+    LOOP_L_N(a, XY) if (axis_on[a]) {
+      const stall_stats_t &stats = stall_stats[a];
+      if (stats.n < n_samples) {
+        SERIAL_CHAR(axis_codes[a]);
+        SERIAL_ECHOLNPGM(" sampling failed.");
+        continue;
+      }
+
+      SERIAL_CHAR(axis_codes[a]);
+      if (calibrate) {
+        stall_offset[a] = stats.mean;
+        SERIAL_ECHOPAIR_F(" Stall offset: ", stats.mean, 4);
+      }
+      else {
+        // The fast home reads the bumped home as stall_offset minus each sample
+        SERIAL_ECHOPAIR_F(" Mean: ", stall_offset[a] - stats.mean, 4);
+        SERIAL_ECHOPAIR_F(" Min: ", stall_offset[a] - stats.max, 4);
+        SERIAL_ECHOPAIR_F(" Max: ", stall_offset[a] - stats.min, 4);
+      }
+      SERIAL_ECHOPAIR_F(" Range: ", stats.max - stats.min, 4);
+      SERIAL_ECHOLNPAIR_F(" Standard Deviation: ", stats.sigma(), 4);
+    }
+
+    return;
+  }
+
+  bool report = true;
+  if (parser.seen('S') && !parser.value_bool()) {
+    stall_offset.set(NAN, NAN);
+    report = false;
+  }
+  #if X_SENSORLESS
+    if (parser.seenval('X')) { stall_offset.x = parser.value_linear_units(); report = false; }
+  #endif
+  #if Y_SENSORLESS
+    if (parser.seenval('Y')) { stall_offset.y = parser.value_linear_units(); report = false; }
+  #endif
+
+  if (report) M915_report();
+}
+
+#endif // SENSORLESS_FAST_HOMING
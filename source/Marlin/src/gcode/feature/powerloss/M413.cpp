@@ -29,12 +29,16 @@
 #include "../../../module/motion.h"
 #include "../../../lcd/marlinui.h"
 
+#if ENABLED(POWER_LOSS_JOURNAL)
+  #include "../../../feature/plr_journal.h"
+#endif
+
 /**
  * M413: Enable / Disable power-loss recovery
  *
  * Parameters
  *   S[bool] - Flag to enable / disable.
- *             If omitted, report current state.
+ *             If omitted, report current state (and journal usage with POWER_LOSS_JOURNAL).
  */
 void GcodeSuite::M413() {
 
@@ -44,6 +48,10 @@ void GcodeSuite::M413() {
     SERIAL_ECHO_START();
     SERIAL_ECHOPGM("Power-loss recovery ");
     serialprintln_onoff(recovery.enabled);
+    TERN_(POWER_LOSS_JOURNAL, plr_journal.report());
+    #if ENABLED(POWER_LOSS_BROWNOUT)
+      SERIAL_ECHOLNPAIR("Brown-out checkpoint cycles:", recovery.brownout_cycles);
+    #endif
   }
 
   #if ENABLED(DEBUG_POWER_LOSS_RECOVERY)
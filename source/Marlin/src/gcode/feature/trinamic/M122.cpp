@@ -55,6 +55,8 @@ void GcodeSuite::M122() {
   #endif
 
   test_tmc_connection(print_axis.x, print_axis.y, print_axis.z, print_axis.e);
+
+  TERN_(TMC_UART_ASYNC, tmc_bus.report());
 }
 
 #endif // HAS_TRINAMIC_CONFIG
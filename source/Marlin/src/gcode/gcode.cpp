@@ -165,7 +165,7 @@ void GcodeSuite::get_destination_from_command() {
   else
     destination.e = current_position.e;
 
-  #if ENABLED(POWER_LOSS_RECOVERY) && !PIN_EXISTS(POWER_LOSS)
+  #if ENABLED(POWER_LOSS_RECOVERY) && (ENABLED(POWER_LOSS_JOURNAL) || !PIN_EXISTS(POWER_LOSS))
     // Only update power loss recovery on moves with E
     if (recovery.enabled && IS_SD_PRINTING() && seen.e && (seen.x || seen.y))
       recovery.save();
@@ -521,10 +521,18 @@ void GcodeSuite::process_parsed_command(const bool no_ok/*=false*/) {
         case 191: M191(); break;                                  // M191: Wait for chamber temperature to reach target
       #endif
 
+      #if ENABLED(PREHEAT_SCHEDULER)
+        case 193: M193(); break;                                  // M193: Heat hotend and bed together and wait
+      #endif
+
       #if BOTH(AUTO_REPORT_TEMPERATURES, HAS_TEMP_SENSOR)
         case 155: M155(); break;                                  // M155: Set temperature auto-report interval
       #endif
 
+      #if ENABLED(TEMP_TELEMETRY)
+        case 156: M156(); break;                                  // M156: Stream temperature telemetry
+      #endif
+
       #if ENABLED(PARK_HEAD_ON_PAUSE)
         case 125: M125(); break;                                  // M125: Store current position and move to filament change position
       #endif
@@ -634,6 +642,10 @@ void GcodeSuite::process_parsed_command(const bool no_ok/*=false*/) {
         case 226: M226(); break;                                  // M226: Wait until a pin reaches a state
       #endif
 
+      #if ANY(TEMP_ISR_STATS, ANYCUBIC_DGUS_LOAD_STATS, ANYCUBIC_DGUS_TX_QUEUE)
+        case 270: M270(); break;                                  // M270: Report temperature ISR and LCD load
+      #endif
+
       #if HAS_SERVOS
         case 280: M280(); break;                                  // M280: Set servo position absolute
         #if ENABLED(EDITABLE_SERVO_ANGLES)
@@ -729,6 +741,10 @@ void GcodeSuite::process_parsed_command(const bool no_ok/*=false*/) {
         case 421: M421(); break;                                  // M421: Set a Mesh Bed Leveling Z coordinate
       #endif
 
+      #if ENABLED(ABL_MESH_SLOTS)
+        case 424: M424(); break;                                  // M424: Named mesh slots
+      #endif
+
       #if ENABLED(BACKLASH_GCODE)
         case 425: M425(); break;                                  // M425: Tune backlash compensation
       #endif
@@ -863,6 +879,9 @@ void GcodeSuite::process_parsed_command(const bool no_ok/*=false*/) {
         #if USE_SENSORLESS
           case 914: M914(); break;                                // M914: Set StallGuard sensitivity.
         #endif
+        #if ENABLED(SENSORLESS_FAST_HOMING)
+          case 915: M915(); break;                                // M915: Sensorless fast homing calibration
+        #endif
       #endif
 
       #if HAS_L64XX
@@ -111,7 +111,7 @@
  * M34  - Set SD Card sorting options. (Requires SDCARD_SORT_ALPHA)
  * M42  - Change pin status via gcode: M42 P<pin> S<value>. LED pin assumed if P is omitted. (Requires DIRECT_PIN_CONTROL)
  * M43  - Display pin status, watch pins for changes, watch endstops & toggle LED, Z servo probe test, toggle pins
- * M48  - Measure Z Probe repeatability: M48 P<points> X<pos> Y<pos> V<level> E<engage> L<legs> S<chizoid>. (Requires Z_MIN_PROBE_REPEATABILITY_TEST)
+ * M48  - Measure Z Probe repeatability: M48 P<points> X<pos> Y<pos> V<level> E<engage> L<legs> S<chizoid> R<speeds> A<slow%> B<fast%> C<csv>. (Requires Z_MIN_PROBE_REPEATABILITY_TEST)
  * M73  - Set the progress percentage. (Requires LCD_SET_PROGRESS_MANUALLY)
  * M75  - Start the print job timer.
  * M76  - Pause the print job timer.
@@ -157,12 +157,14 @@
  * M149 - Set temperature units. (Requires TEMPERATURE_UNITS_SUPPORT)
  * M150 - Set Status LED Color as R<red> U<green> B<blue> W<white> P<bright>. Values 0-255. (Requires BLINKM, RGB_LED, RGBW_LED, NEOPIXEL_LED, PCA9533, or PCA9632).
  * M155 - Auto-report temperatures with interval of S<seconds>. (Requires AUTO_REPORT_TEMPERATURES)
+ * M156 - Stream temperature telemetry at S<hz>, B1 for binary frames. (Requires TEMP_TELEMETRY)
  * M163 - Set a single proportion for a mixing extruder. (Requires MIXING_EXTRUDER)
  * M164 - Commit the mix and save to a virtual tool (current, or as specified by 'S'). (Requires MIXING_EXTRUDER)
  * M165 - Set the mix for the mixing extruder (and current virtual tool) with parameters ABCDHI. (Requires MIXING_EXTRUDER and DIRECT_MIXING_IN_G1)
  * M166 - Set the Gradient Mix for the mixing extruder. (Requires GRADIENT_MIX)
  * M190 - S<temp> Wait for bed current temp to reach target temp. ** Wait only when heating! **
  *        R<temp> Wait for bed current temp to reach target temp. ** Wait for heating or cooling. **
+ * M193 - Heat hotend and bed together and wait: S<hotend> B<bed>. (Requires PREHEAT_SCHEDULER)
  * M200 - Set filament diameter, D<diameter>, setting E axis units to cubic. (Use S0 to revert to linear units.)
  * M201 - Set max acceleration in units/s^2 for print moves: "M201 X<accel> Y<accel> Z<accel> E<accel>"
  * M202 - Set max acceleration in units/s^2 for travel moves: "M202 X<accel> Y<accel> Z<accel> E<accel>" ** UNUSED IN MARLIN! **
@@ -188,6 +190,7 @@
  * M250 - Set LCD contrast: "M250 C<contrast>" (0-63). (Requires LCD support)
  * M260 - i2c Send Data (Requires EXPERIMENTAL_I2CBUS)
  * M261 - i2c Request Data (Requires EXPERIMENTAL_I2CBUS)
+ * M270 - Report temperature ISR and LCD cycles, CPU load and LCD TX queue. R to reset. (Requires TEMP_ISR_STATS, ANYCUBIC_DGUS_LOAD_STATS or ANYCUBIC_DGUS_TX_QUEUE)
  * M280 - Set servo position absolute: "M280 P<index> S<angle|µs>". (Requires servos)
  * M281 - Set servo min|max position: "M281 P<index> L<min> U<max>". (Requires EDITABLE_SERVO_ANGLES)
  * M290 - Babystepping (Requires BABYSTEPPING)
@@ -216,6 +219,7 @@
  * M420 - Enable/Disable Leveling (with current values) S1=enable S0=disable (Requires MESH_BED_LEVELING or ABL)
  * M421 - Set a single Z coordinate in the Mesh Leveling grid. X<units> Y<units> Z<units> (Requires MESH_BED_LEVELING, AUTO_BED_LEVELING_BILINEAR, or AUTO_BED_LEVELING_UBL)
  * M422 - Set Z Stepper automatic alignment position using probe. X<units> Y<units> A<axis> (Requires Z_STEPPER_AUTO_ALIGN)
+ * M424 - Save, load, list or delete named mesh slots. Load the slot for the bed temperature with A. (Requires ABL_MESH_SLOTS)
  * M425 - Enable/Disable and tune backlash correction. (Requires BACKLASH_COMPENSATION and BACKLASH_GCODE)
  * M428 - Set the home_offset based on the current_position. Nearest edge applies. (Disabled by NO_WORKSPACE_OFFSETS or DELTA)
  * M430 - Read the system current, voltage, and power (Requires POWER_MONITOR_CURRENT, POWER_MONITOR_VOLTAGE, or POWER_MONITOR_FIXED_VOLTAGE)
@@ -269,6 +273,7 @@
  * M912 - Clear stepper driver overtemperature pre-warn condition flag. (Requires at least one _DRIVER_TYPE defined as TMC2130/2160/5130/5160/2208/2209/2660)
  * M913 - Set HYBRID_THRESHOLD speed. (Requires HYBRID_THRESHOLD)
  * M914 - Set StallGuard sensitivity. (Requires SENSORLESS_HOMING or SENSORLESS_PROBING)
+ * M915 - Calibrate, check or set sensorless fast homing. (Requires SENSORLESS_FAST_HOMING)
  * M916 - L6470 tuning: Increase KVAL_HOLD until thermal warning. (Requires at least one _DRIVER_TYPE L6470)
  * M917 - L6470 tuning: Find minimum current thresholds. (Requires at least one _DRIVER_TYPE L6470)
  * M918 - L6470 tuning: Increase speed until max or error. (Requires at least one _DRIVER_TYPE L6470)
@@ -693,6 +698,10 @@ static void D(const int16_t dcode);
     static void M191();
   #endif
 
+  #if ENABLED(PREHEAT_SCHEDULER)
+    static void M193();
+  #endif
+
   #if PREHEAT_COUNT
     static void M145();
   #endif
@@ -709,6 +718,10 @@ static void D(const int16_t dcode);
     static void M155();
   #endif
 
+  #if ENABLED(TEMP_TELEMETRY)
+    static void M156();
+  #endif
+
   #if ENABLED(MIXING_EXTRUDER)
     static void M163();
     static void M164();
@@ -774,6 +787,10 @@ static void M217();
     static void M261();
   #endif
 
+  #if ANY(TEMP_ISR_STATS, ANYCUBIC_DGUS_LOAD_STATS, ANYCUBIC_DGUS_TX_QUEUE)
+    static void M270();
+  #endif
+
   #if HAS_SERVOS
     static void M280();
     #if ENABLED(EDITABLE_SERVO_ANGLES)
@@ -861,6 +878,10 @@ static void M217();
     static void M421();
   #endif
 
+  #if ENABLED(ABL_MESH_SLOTS)
+    static void M424();
+  #endif
+
   #if ENABLED(BACKLASH_GCODE)
     static void M425();
   #endif
@@ -990,6 +1011,9 @@ static void M808();
     #if USE_SENSORLESS
       static void M914();
     #endif
+    #if ENABLED(SENSORLESS_FAST_HOMING)
+      static void M915();
+    #endif
   #endif
 
   #if HAS_L64XX
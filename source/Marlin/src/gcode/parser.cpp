@@ -244,6 +244,11 @@ void GCodeParser::parse(char *p) {
     #if ENABLED(EXPECTED_PRINTER_CHECK)
       case 16:
     #endif
+    #if ENABLED(ABL_MESH_SLOTS)
+      case 424:                                 // Parameters, then the quoted slot name. M424 unquotes it.
+        string_arg = p;
+        return;
+    #endif
     case 23: case 28: case 30: case 117 ... 118: case 928:
       string_arg = unescape_string(p);
       return;
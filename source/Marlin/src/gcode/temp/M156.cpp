@@ -0,0 +1,49 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "../../inc/MarlinConfig.h"
+
+#if ENABLED(TEMP_TELEMETRY)
+
+#include "../gcode.h"
+#include "../../feature/temp_telemetry.h"
+
+/**
+ * M156: Stream temperature telemetry
+ *
+ *   S<hz>   Frames per second, up to TEMP_TELEMETRY_MAX_HZ and one per PID_dT. S0 to stop.
+ *   B<bool> Send binary frames instead of fixed-field text
+ *
+ * Echo the stream state, with the frame interval actually used, and the dropped frames.
+ */
+void GcodeSuite::M156() {
+  if (parser.seenval('S')) {
+    const uint8_t hz = parser.value_byte();
+    if (hz)
+      temp_telemetry.start(hz, parser.boolval('B'));
+    else
+      temp_telemetry.stop();
+  }
+  temp_telemetry.report();
+}
+
+#endif // TEMP_TELEMETRY
@@ -0,0 +1,88 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * gcode/temp/M193.cpp
+ *
+ * Concurrent hotend and bed preheat
+ */
+
+#include "../../inc/MarlinConfig.h"
+
+#if ENABLED(PREHEAT_SCHEDULER)
+
+#include "../gcode.h"
+#include "../../module/temperature.h"
+#include "../../feature/preheat.h"
+#include "../../lcd/marlinui.h"
+
+#if ENABLED(PRINTJOB_TIMER_AUTOSTART)
+  #include "../../module/printcounter.h"
+#endif
+
+/**
+ * M193: Heat the hotend and bed together and wait for both
+ *
+ * The slower heater starts first and the other is held back so both arrive
+ * at about the same time, within PREHEAT_POWER_BUDGET.
+ *
+ * Parameters:
+ *  I<index>  : Preset index (if material presets are defined)
+ *  T<index>  : Tool index. If omitted, applies to the active tool
+ *  S<target> : Hotend target temperature in current units
+ *  B<target> : Bed target temperature in current units
+ *
+ * Example:
+ *  M193 S210 B60 : Replaces "M190 S60" followed by "M109 S210"
+ */
+void GcodeSuite::M193() {
+  if (DEBUGGING(DRYRUN)) return;
+
+  const int8_t target_extruder = get_target_extruder_from_command();
+  if (target_extruder < 0) return;
+
+  int16_t hotend_temp = 0, bed_temp = 0;
+
+  // Accept 'I' if temperature presets are defined
+  #if PREHEAT_COUNT
+    if (parser.seenval('I')) {
+      const uint8_t index = _MIN(parser.value_byte(), PREHEAT_COUNT - 1);
+      hotend_temp = ui.material_preset[index].hotend_temp;
+      bed_temp = ui.material_preset[index].bed_temp;
+    }
+  #endif
+
+  if (parser.seenval('S')) hotend_temp = int16_t(parser.value_celsius());
+  if (parser.seenval('B')) bed_temp = int16_t(parser.value_celsius());
+
+  if (!hotend_temp && !bed_temp) return;
+
+  TERN_(PRINTJOB_TIMER_AUTOSTART, thermalManager.auto_job_check_timer(true, false));
+
+  if (!preheat.run(hotend_temp, bed_temp, target_extruder)) return;
+
+  // Both are close to target. Let the usual loops handle residency.
+  if (bed_temp && !thermalManager.wait_for_bed(true)) return;
+  if (hotend_temp) (void)thermalManager.wait_for_hotend(target_extruder, true);
+}
+
+#endif // PREHEAT_SCHEDULER
@@ -0,0 +1,67 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "../../inc/MarlinConfig.h"
+
+#if ANY(TEMP_ISR_STATS, ANYCUBIC_DGUS_LOAD_STATS, ANYCUBIC_DGUS_TX_QUEUE)
+
+#include "../gcode.h"
+
+#if ENABLED(TEMP_ISR_STATS)
+  #include "../../module/temperature.h"
+#endif
+
+#if ENABLED(ANYCUBIC_DGUS_LOAD_STATS)
+  #include "../../lcd/extui/lib/anycubic_dgus/dgus_tft.h"
+#endif
+
+#if ENABLED(ANYCUBIC_DGUS_TX_QUEUE)
+  #include "../../lcd/extui/lib/anycubic_dgus/dgus_TxQueue.h"
+#endif
+
+/**
+ * M270: Report the cycles spent in the temperature ISRs and in the LCD
+ *       update, and their CPU load since the last reset. Also report the
+ *       LCD transmit queue depth and its merged, superseded and stalled writes.
+ *
+ *   R  Reset the counters after reporting
+ */
+void GcodeSuite::M270() {
+  const bool reset = parser.seen('R');
+
+  #if ENABLED(TEMP_ISR_STATS)
+    thermalManager.report_isr_stats();
+    if (reset) thermalManager.reset_isr_stats();
+  #endif
+
+  #if ENABLED(ANYCUBIC_DGUS_LOAD_STATS)
+    Anycubic::DgusTFT::ReportLoad();
+    if (reset) Anycubic::DgusTFT::ResetLoad();
+  #endif
+
+  #if ENABLED(ANYCUBIC_DGUS_TX_QUEUE)
+    Anycubic::TxQueue::reportStats();
+    if (reset) Anycubic::TxQueue::resetStats();
+  #endif
+}
+
+#endif // TEMP_ISR_STATS || ANYCUBIC_DGUS_LOAD_STATS || ANYCUBIC_DGUS_TX_QUEUE
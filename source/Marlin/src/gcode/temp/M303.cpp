@@ -40,6 +40,10 @@
  *  C<cycles>       Number of times to repeat the procedure. (Minimum: 3, Default: 5)
  *  U<bool>         Flag to apply the result to the current PID values
  *
+ * With PID_AUTOTUNE_FAST:
+ *  F<bool>         Tune from one heating step with a model fit. C is ignored.
+ *                  With M111 S8 (dry run) fit a simulated heater instead.
+ *
  * With PID_DEBUG:
  *  D               Toggle PID debugging and EXIT without further action.
  */
@@ -78,7 +82,12 @@ void GcodeSuite::M303() {
   #endif
 
   LCD_MESSAGEPGM(MSG_PID_AUTOTUNE);
-  thermalManager.PID_autotune(temp, e, c, u);
+  #if ENABLED(PID_AUTOTUNE_FAST)
+    if (parser.boolval('F'))
+      thermalManager.PID_autotune_fast(temp, e, u);
+    else
+  #endif
+      thermalManager.PID_autotune(temp, e, c, u);
   ui.reset_status();
 }
 
@@ -158,6 +158,11 @@
   #define HAS_PRINT_PROGRESS_PERMYRIAD 1
 #endif
 
+// The planner keeps a running total of the time held in its buffer
+#if HAS_WIRED_LCD || ENABLED(PRINT_ETA_ESTIMATOR)
+  #define HAS_BLOCK_RUNTIME 1
+#endif
+
 #if ANY(MARLIN_BRICKOUT, MARLIN_INVADERS, MARLIN_SNAKE, MARLIN_MAZE)
   #define HAS_GAMES 1
   #if MANY(MARLIN_BRICKOUT, MARLIN_INVADERS, MARLIN_SNAKE, MARLIN_MAZE)
@@ -496,6 +501,11 @@
   #define HAS_POWER_MONITOR_WATTS 1
 #endif
 
+// Features using the heater thermal models
+#if EITHER(PREHEAT_SCHEDULER, HEATER_HEALTH_CHECK)
+  #define HAS_HEATER_MODEL 1
+#endif
+
 // Flag if an EEPROM type is pre-selected
 #if ENABLED(EEPROM_SETTINGS) && NONE(I2C_EEPROM, SPI_EEPROM, QSPI_EEPROM, FLASH_EEPROM_EMULATION, SRAM_EEPROM_EMULATION, SDCARD_EEPROM_EMULATION)
   #define NO_EEPROM_SELECTED 1
@@ -2627,6 +2627,9 @@
   #if ENABLED(BLTOUCH) && !defined(BLTOUCH_DELAY)
     #define BLTOUCH_DELAY 500
   #endif
+  #if ENABLED(PROBE_TARE) && !defined(PROBE_TARE_SETTLE)
+    #define PROBE_TARE_SETTLE PROBE_TARE_DELAY  // Fixed delay, as before
+  #endif
 #endif
 
 #if !defined(MANUAL_PROBE_START_Z) && defined(Z_CLEARANCE_BETWEEN_PROBES)
@@ -756,6 +756,24 @@ static_assert(Y_MAX_LENGTH >= Y_BED_SIZE, "Movement bounds (Y_MIN_POS, Y_MAX_POS
   #endif
 #endif
 
+#if ENABLED(PRINT_ETA_ESTIMATOR)
+  #if DISABLED(SDSUPPORT)
+    #error "PRINT_ETA_ESTIMATOR requires SDSUPPORT."
+  #elif !WITHIN(PRINT_ETA_BINS, 8, 255)
+    #error "PRINT_ETA_BINS must be from 8 to 255."
+  #endif
+#endif
+
+#if ENABLED(SDCARD_DIR_INDEX)
+  #if SDCARD_DIR_INDEX_SIZE < 16
+    #error "SDCARD_DIR_INDEX_SIZE should be 16 or greater to be useful."
+  #elif SDCARD_DIR_INDEX_SIZE > 1024
+    #error "SDCARD_DIR_INDEX_SIZE must be 1024 or smaller."
+  #elif SDCARD_DIR_PREFETCH > 16
+    #error "SDCARD_DIR_PREFETCH must be 16 or smaller."
+  #endif
+#endif
+
 #if defined(EVENT_GCODE_SD_ABORT) && DISABLED(NOZZLE_PARK_FEATURE)
   static_assert(nullptr == strstr(EVENT_GCODE_SD_ABORT, "G27"), "NOZZLE_PARK_FEATURE is required to use G27 in EVENT_GCODE_SD_ABORT.");
 #endif
@@ -1414,6 +1432,49 @@ static_assert(Y_MAX_LENGTH >= Y_BED_SIZE, "Movement bounds (Y_MIN_POS, Y_MAX_POS
     #endif
   #endif
 
+  #if ENABLED(G29_FAST_PROBING)
+    #if MULTIPLE_PROBING != 2
+      #error "G29_FAST_PROBING requires MULTIPLE_PROBING 2."
+    #elif EXTRA_PROBING
+      #error "G29_FAST_PROBING is incompatible with EXTRA_PROBING."
+    #elif IS_KINEMATIC
+      #error "G29_FAST_PROBING is not supported on DELTA or SCARA."
+    #elif DISABLED(AUTO_BED_LEVELING_LINEAR) && DISABLED(AUTO_BED_LEVELING_BILINEAR)
+      #error "G29_FAST_PROBING requires AUTO_BED_LEVELING_LINEAR or AUTO_BED_LEVELING_BILINEAR."
+    #endif
+    static_assert(G29_FAST_CLEARANCE > 0, "G29_FAST_CLEARANCE must be greater than 0.");
+  #endif
+
+  #if ENABLED(G29_ADAPTIVE)
+    #if DISABLED(AUTO_BED_LEVELING_BILINEAR)
+      #error "G29_ADAPTIVE requires AUTO_BED_LEVELING_BILINEAR."
+    #elif !WITHIN(G29_ADAPTIVE_MIN_POINTS, 2, GRID_MAX_POINTS_X) || !WITHIN(G29_ADAPTIVE_MIN_POINTS, 2, GRID_MAX_POINTS_Y)
+      #error "G29_ADAPTIVE_MIN_POINTS must be from 2 to GRID_MAX_POINTS_X and GRID_MAX_POINTS_Y."
+    #endif
+  #endif
+
+  #if ENABLED(G29_SWEEP_PROBING)
+    #if DISABLED(AUTO_BED_LEVELING_BILINEAR)
+      #error "G29_SWEEP_PROBING requires AUTO_BED_LEVELING_BILINEAR."
+    #elif NONE(FIX_MOUNTED_PROBE, NOZZLE_AS_PROBE)
+      #error "G29_SWEEP_PROBING requires a FIX_MOUNTED_PROBE or NOZZLE_AS_PROBE that triggers on contact."
+    #elif IS_KINEMATIC
+      #error "G29_SWEEP_PROBING is not supported on DELTA or SCARA."
+    #elif G29_SWEEP_ROWS < 2
+      #error "G29_SWEEP_ROWS must be at least 2."
+    #endif
+    static_assert(G29_SWEEP_SPACING > 0 && G29_SWEEP_FEEDRATE > 0, "G29_SWEEP_SPACING and G29_SWEEP_FEEDRATE must be greater than 0.");
+    static_assert(G29_SWEEP_LIFT > 0 && G29_SWEEP_DEPTH > 0, "G29_SWEEP_LIFT and G29_SWEEP_DEPTH must be greater than 0.");
+  #endif
+
+  #if ENABLED(PROBE_TARE)
+    #if !PIN_EXISTS(PROBE_TARE)
+      #error "A PROBE_TARE_PIN is required for PROBE_TARE."
+    #elif PROBE_TARE_SETTLE > PROBE_TARE_DELAY
+      #error "PROBE_TARE_SETTLE must be less than or equal to PROBE_TARE_DELAY."
+    #endif
+  #endif
+
 #else
 
   /**
@@ -1467,6 +1528,16 @@ static_assert(Y_MAX_LENGTH >= Y_BED_SIZE, "Movement bounds (Y_MIN_POS, Y_MAX_POS
     #error "SCARA machines can only use the AUTO_BED_LEVELING_BILINEAR leveling option."
   #endif
 
+  #if ENABLED(ABL_BICUBIC)
+    #if DISABLED(AUTO_BED_LEVELING_BILINEAR)
+      #error "ABL_BICUBIC requires AUTO_BED_LEVELING_BILINEAR."
+    #elif ENABLED(ABL_BILINEAR_SUBDIVISION)
+      #error "ABL_BICUBIC and ABL_BILINEAR_SUBDIVISION can't be used together."
+    #elif ENABLED(EXTRAPOLATE_BEYOND_GRID)
+      #error "ABL_BICUBIC keeps the grid edge height beyond the grid and can't be used with EXTRAPOLATE_BEYOND_GRID."
+    #endif
+  #endif
+
 #elif ENABLED(MESH_BED_LEVELING)
 
   // Mesh Bed Leveling
@@ -1494,6 +1565,19 @@ static_assert(Y_MAX_LENGTH >= Y_BED_SIZE, "Movement bounds (Y_MIN_POS, Y_MAX_POS
   #endif
 #endif
 
+#if ENABLED(ABL_MESH_SLOTS)
+  #if DISABLED(AUTO_BED_LEVELING_BILINEAR)
+    #error "ABL_MESH_SLOTS requires AUTO_BED_LEVELING_BILINEAR."
+  #elif DISABLED(EEPROM_SETTINGS)
+    #error "ABL_MESH_SLOTS requires EEPROM_SETTINGS."
+  #elif !defined(MESH_SLOTS_SIZE) || !defined(MESH_SLOTS_MAX) || !defined(MESH_SLOT_TEMP_RANGE)
+    #error "ABL_MESH_SLOTS requires MESH_SLOTS_SIZE, MESH_SLOTS_MAX, and MESH_SLOT_TEMP_RANGE."
+  #endif
+  static_assert(WITHIN(MESH_SLOTS_MAX, 1, 100), "MESH_SLOTS_MAX must be from 1 to 100.");
+  static_assert(MESH_SLOTS_SIZE >= 26 + (GRID_MAX_POINTS), "MESH_SLOTS_SIZE is too small to hold one mesh.");
+  static_assert(MESH_SLOT_TEMP_RANGE >= 0, "MESH_SLOT_TEMP_RANGE can't be negative.");
+#endif
+
 #if ENABLED(MESH_EDIT_GFX_OVERLAY) && !BOTH(AUTO_BED_LEVELING_UBL, HAS_MARLINUI_U8GLIB)
   #error "MESH_EDIT_GFX_OVERLAY requires AUTO_BED_LEVELING_UBL and a Graphical LCD."
 #endif
@@ -1577,6 +1661,67 @@ static_assert(hbm[Z_AXIS] >= 0, "HOMING_BUMP_MM.Z must be greater than or equal
   #error "POWER_MONITOR_CURRENT_PIN and POWER_MONITOR_VOLTAGE_PIN must be different."
 #endif
 
+/**
+ * Fast PID Autotune
+ */
+#if ENABLED(PID_AUTOTUNE_FAST) && !HAS_PID_HEATING
+  #error "PID_AUTOTUNE_FAST requires PIDTEMP or PIDTEMPBED."
+#endif
+
+/**
+ * Preheat Scheduler
+ */
+#if ENABLED(PREHEAT_SCHEDULER)
+  #if !(HAS_HOTEND && HAS_HEATED_BED)
+    #error "PREHEAT_SCHEDULER requires a hotend and a heated bed."
+  #elif !defined(PREHEAT_POWER_BUDGET)
+    #error "PREHEAT_SCHEDULER requires PREHEAT_POWER_BUDGET."
+  #endif
+#endif
+
+/**
+ * Heater Health Check
+ */
+#if ENABLED(HEATER_HEALTH_CHECK)
+  #if !HAS_HOTEND
+    #error "HEATER_HEALTH_CHECK requires a hotend."
+  #elif !defined(HEATER_HEALTH_WINDOW) || !defined(HEATER_HEALTH_STRIKES) || !defined(HEATER_HEALTH_MISSING) || !defined(HEATER_HEALTH_EXCESS)
+    #error "HEATER_HEALTH_CHECK requires HEATER_HEALTH_WINDOW, HEATER_HEALTH_STRIKES, HEATER_HEALTH_MISSING, and HEATER_HEALTH_EXCESS."
+  #elif HAS_HEATED_BED && !defined(HEATER_HEALTH_BED_WINDOW)
+    #error "HEATER_HEALTH_CHECK requires HEATER_HEALTH_BED_WINDOW."
+  #endif
+#endif
+
+#if HAS_HEATER_MODEL
+  #if !defined(HEATER_NOMINAL_VOLTAGE) || !defined(HOTEND_THERMAL_MODEL)
+    #error "PREHEAT_SCHEDULER and HEATER_HEALTH_CHECK require HEATER_NOMINAL_VOLTAGE and HOTEND_THERMAL_MODEL."
+  #elif HAS_HEATED_BED && !defined(BED_THERMAL_MODEL)
+    #error "PREHEAT_SCHEDULER and HEATER_HEALTH_CHECK require BED_THERMAL_MODEL."
+  #endif
+#endif
+
+/**
+ * Temperature telemetry
+ */
+#if ENABLED(TEMP_TELEMETRY)
+  #if !HAS_TEMP_SENSOR
+    #error "TEMP_TELEMETRY requires a temperature sensor."
+  #elif !WITHIN(TEMP_TELEMETRY_MAX_HZ, 1, 100)
+    #error "TEMP_TELEMETRY_MAX_HZ must be from 1 to 100."
+  #endif
+#endif
+
+/**
+ * Event-driven temperature sampling
+ */
+#if ENABLED(TEMP_SENSOR_EVENT_ISR)
+  #if !defined(TEMP_SENSOR_FREQUENCY) || TEMP_SENSOR_FREQUENCY < 10 || TEMP_SENSOR_FREQUENCY > 1000
+    #error "TEMP_SENSOR_EVENT_ISR requires a TEMP_SENSOR_FREQUENCY from 10 to 1000 (Hz)."
+  #elif HOTENDS > 1 || ANY(HAS_TEMP_ADC_CHAMBER, HAS_TEMP_ADC_PROBE, HAS_ADC_BUTTONS, HAS_FILAMENT_WIDTH_SENSOR, JOYSTICK, POWER_MONITOR_CURRENT)
+    #error "TEMP_SENSOR_EVENT_ISR only samples TEMP_0, TEMP_BED, and POWER_MONITOR_VOLTAGE."
+  #endif
+#endif
+
 /**
  * Volumetric Extruder Limit
  */
@@ -2424,6 +2569,28 @@ static_assert(hbm[Z_AXIS] >= 0, "HOMING_BUMP_MM.Z must be greater than or equal
   #endif
 #endif
 
+/**
+ * Anycubic DGUS shadow state
+ */
+#if ENABLED(ANYCUBIC_DGUS_SHADOW_STATE)
+  #if !WITHIN(DGUS_SHADOW_VP_COUNT, 8, 255)
+    #error "DGUS_SHADOW_VP_COUNT must be from 8 to 255."
+  #elif DGUS_SHADOW_TX_BUDGET < 8
+    #error "DGUS_SHADOW_TX_BUDGET must be at least 8 bytes (one VP write)."
+  #endif
+#endif
+
+/**
+ * Anycubic DGUS transmit queue
+ */
+#if ENABLED(ANYCUBIC_DGUS_TX_QUEUE)
+  #if DGUS_TX_QUEUE_SIZE < 256
+    #error "DGUS_TX_QUEUE_SIZE must be at least 256 bytes."
+  #elif !WITHIN(DGUS_TX_QUEUE_FRAMES, 4, 255)
+    #error "DGUS_TX_QUEUE_FRAMES must be from 4 to 255."
+  #endif
+#endif
+
 /**
  * FYSETC Mini 12864 RGB backlighting required
  */
@@ -2675,6 +2842,20 @@ static_assert(hbm[Z_AXIS] >= 0, "HOMING_BUMP_MM.Z must be greater than or equal
     #error "SENSORLESS_HOMING requires a TMC stepper driver with StallGuard on X, Y, or Z axes."
   #endif
 
+  #if ENABLED(SENSORLESS_FAST_HOMING)
+    #if !(X_SENSORLESS || Y_SENSORLESS)
+      #error "SENSORLESS_FAST_HOMING requires sensorless homing on X or Y."
+    #elif IS_KINEMATIC || ANY(IS_CORE, MARKFORGED_XY, DUAL_X_CARRIAGE)
+      #error "SENSORLESS_FAST_HOMING requires a Cartesian machine with one X carriage."
+    #elif EITHER(X_DUAL_ENDSTOPS, Y_DUAL_ENDSTOPS)
+      #error "SENSORLESS_FAST_HOMING is incompatible with X_DUAL_ENDSTOPS and Y_DUAL_ENDSTOPS."
+    #elif !defined(SENSORLESS_FAST_HOMING_FEEDRATE_MM_M)
+      #error "SENSORLESS_FAST_HOMING requires SENSORLESS_FAST_HOMING_FEEDRATE_MM_M."
+    #endif
+    static_assert(SENSORLESS_FAST_HOMING_TRAVEL > 0, "SENSORLESS_FAST_HOMING_TRAVEL must be greater than 0.");
+    static_assert(WITHIN(SENSORLESS_FAST_HOMING_SAMPLES, 2, 50), "SENSORLESS_FAST_HOMING_SAMPLES must be from 2 to 50.");
+  #endif
+
   #undef X_ENDSTOP_INVERTING
   #undef Y_ENDSTOP_INVERTING
   #undef Z_ENDSTOP_INVERTING
@@ -2889,6 +3070,22 @@ static_assert(   _ARR_TEST(3,0) && _ARR_TEST(3,1) && _ARR_TEST(3,2)
   #error "You can't enable POWER_LOSS_PULLUP and POWER_LOSS_PULLDOWN at the same time."
 #endif
 
+#if ENABLED(POWER_LOSS_JOURNAL) && !WITHIN(POWER_LOSS_JOURNAL_CMDS, 0, 60000)
+  #error "POWER_LOSS_JOURNAL_CMDS must be from 0 to 60000."
+#endif
+
+#if ENABLED(POWER_LOSS_BROWNOUT)
+  #if DISABLED(POWER_LOSS_JOURNAL)
+    #error "POWER_LOSS_BROWNOUT requires POWER_LOSS_JOURNAL."
+  #elif DISABLED(POWER_MONITOR_VOLTAGE)
+    #error "POWER_LOSS_BROWNOUT requires POWER_MONITOR_VOLTAGE."
+  #elif !WITHIN(POWER_LOSS_BROWNOUT_FREQUENCY, 1000, 20000)
+    #error "POWER_LOSS_BROWNOUT_FREQUENCY must be from 1000 to 20000 (Hz)."
+  #elif !WITHIN(POWER_LOSS_ADC_THRESHOLD, 1, 3900)
+    #error "POWER_LOSS_ADC_THRESHOLD must be from 1 to 3900."
+  #endif
+#endif
+
 #if ENABLED(Z_STEPPER_AUTO_ALIGN)
   #if NUM_Z_STEPPER_DRIVERS <= 1
     #error "Z_STEPPER_AUTO_ALIGN requires NUM_Z_STEPPER_DRIVERS greater than 1."
@@ -3243,6 +3440,24 @@ static_assert(   _ARR_TEST(3,0) && _ARR_TEST(3,1) && _ARR_TEST(3,2)
   #error "MONITOR_DRIVER_STATUS and SDSUPPORT cannot be used together on boards with shared SPI."
 #endif
 
+/**
+ * TMC_UART_ASYNC owns the hardware UART shared by the drivers
+ */
+#if ENABLED(TMC_UART_ASYNC)
+  #if !HAS_TMC_UART
+    #error "TMC_UART_ASYNC requires TMC2208 or TMC2209 drivers in UART mode."
+  #elif HAS_TMC_SW_SERIAL
+    #error "TMC_UART_ASYNC requires all TMC drivers on a hardware serial port."
+  #elif HAS_TMC_SPI
+    #error "TMC_UART_ASYNC can't be used with SPI TMC drivers."
+  #elif ENABLED(TMC_SERIAL_MULTIPLEXER)
+    #error "TMC_UART_ASYNC can't be used with TMC_SERIAL_MULTIPLEXER."
+  #endif
+#endif
+#if ENABLED(TMC_SHADOW_REGISTERS) && DISABLED(TMC_UART_ASYNC)
+  #error "TMC_SHADOW_REGISTERS requires TMC_UART_ASYNC."
+#endif
+
 // G60/G61 Position Save
 #if SAVED_POSITIONS > 256
   #error "SAVED_POSITIONS must be an integer from 0 to 256."
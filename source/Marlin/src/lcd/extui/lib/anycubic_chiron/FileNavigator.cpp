@@ -98,6 +98,8 @@ namespace Anycubic {
         #endif
       }
     }
+
+    filelist.prefetch(currentindex + 4, 4);   // Next page, while this one is viewed
   }
 
   void FileNavigator::sendFile() {
@@ -112,6 +112,8 @@ namespace Anycubic {
 
       file_num++;
     }
+
+    filelist.prefetch(currentindex + files, files);   // Next page, while this one is viewed
   }
 
   void FileNavigator::sendFile() {
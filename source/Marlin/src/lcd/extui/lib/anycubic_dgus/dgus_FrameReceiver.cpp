@@ -0,0 +1,122 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * lcd/extui/lib/dgus_FrameReceiver.cpp
+ */
+
+#include "../../../../inc/MarlinConfigPre.h"
+
+#if ENABLED(ANYCUBIC_LCD_DGUS)
+
+#include "dgus_FrameReceiver.h"
+#include "../../../../MarlinCore.h"
+
+namespace Anycubic {
+
+  FrameReceiver::rx_state_t FrameReceiver::state;
+  millis_t FrameReceiver::last_ms;
+  uint8_t  FrameReceiver::rx_len,
+           FrameReceiver::rx_count,
+           FrameReceiver::rx_buf[AC_RX_FRAME_MAX];
+
+  uint8_t  FrameReceiver::queue_len[AC_RX_FRAME_QUEUE],
+           FrameReceiver::queue_buf[AC_RX_FRAME_QUEUE][AC_RX_FRAME_MAX],
+           FrameReceiver::head,
+           FrameReceiver::count;
+
+  void FrameReceiver::reset() {
+    state = RX_IDLE;
+    head = count = 0;
+  }
+
+  // Take everything the UART has buffered
+  void FrameReceiver::poll() {
+    const millis_t ms = millis();
+    for (int c; (c = TFTSer.read()) >= 0;) parse(uint8_t(c), ms);
+  }
+
+  void FrameReceiver::parse(const uint8_t c, const millis_t ms) {
+    // A frame that stalled mid-way is abandoned; this byte may start a new one
+    if (state != RX_IDLE && ms - last_ms > AC_RX_FRAME_TIMEOUT) {
+      state = RX_IDLE;
+      #if ACDEBUG(AC_MARLIN)
+        SERIAL_ECHOLNPGM("lcd frame timeout");
+      #endif
+    }
+    last_ms = ms;
+
+    switch (state) {
+      case RX_IDLE:
+        if (c == 0x5A) state = RX_HEADER;
+        break;
+
+      case RX_HEADER:
+        if (c == 0xA5) state = RX_LENGTH;
+        else if (c != 0x5A) state = RX_IDLE;
+        break;
+
+      case RX_LENGTH:
+        if (WITHIN(c, 1, AC_RX_FRAME_MAX)) {
+          rx_len = c;
+          rx_count = 0;
+          state = RX_PAYLOAD;
+        }
+        else {
+          state = c == 0x5A ? RX_HEADER : RX_IDLE;
+          #if ACDEBUG(AC_MARLIN)
+            SERIAL_ECHOLNPAIR("lcd frame length error: ", c);
+          #endif
+        }
+        break;
+
+      case RX_PAYLOAD:
+        rx_buf[rx_count++] = c;
+        if (rx_count < rx_len) break;
+        state = RX_IDLE;
+        if (count >= AC_RX_FRAME_QUEUE) {
+          #if ACDEBUG(AC_MARLIN)
+            SERIAL_ECHOLNPGM("lcd frame queue full");
+          #endif
+          break;
+        }
+        const uint8_t slot = (head + count) % (AC_RX_FRAME_QUEUE);
+        queue_len[slot] = rx_len;
+        memcpy(queue_buf[slot], rx_buf, rx_len);
+        count++;
+        break;
+    }
+  }
+
+  // Copy the oldest frame's payload to buf. Returns its length, 0 if none.
+  uint8_t FrameReceiver::pop(uint8_t *buf) {
+    if (!count) return 0;
+    const uint8_t len = queue_len[head];
+    memcpy(buf, queue_buf[head], len);
+    head = (head + 1) % (AC_RX_FRAME_QUEUE);
+    count--;
+    return len;
+  }
+
+} // namespace Anycubic
+
+#endif // ANYCUBIC_LCD_DGUS
@@ -0,0 +1,56 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * lcd/extui/lib/dgus_FrameReceiver.h
+ *
+ * Incremental parser for frames sent by the DGUS panel:
+ *   5A A5 <len> <len bytes: cmd, VP, data...>
+ * Bytes are taken as they arrive and complete frames are queued, so a
+ * stalled or garbled frame never blocks the main loop.
+ */
+
+#include "dgus_tft_defs.h"
+#include "../../../../core/millis_t.h"
+
+namespace Anycubic {
+  class FrameReceiver {
+    public:
+      static void reset();
+      static void poll();
+      static void parse(const uint8_t c, const millis_t ms);
+      static uint8_t pop(uint8_t *buf);
+
+    private:
+      enum rx_state_t : uint8_t { RX_IDLE, RX_HEADER, RX_LENGTH, RX_PAYLOAD };
+
+      static rx_state_t state;
+      static millis_t   last_ms;
+      static uint8_t    rx_len, rx_count;
+      static uint8_t    rx_buf[AC_RX_FRAME_MAX];
+
+      static uint8_t    queue_len[AC_RX_FRAME_QUEUE];
+      static uint8_t    queue_buf[AC_RX_FRAME_QUEUE][AC_RX_FRAME_MAX];
+      static uint8_t    head, count;
+  };
+}
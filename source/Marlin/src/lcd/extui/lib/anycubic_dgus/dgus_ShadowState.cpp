@@ -0,0 +1,174 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * lcd/extui/lib/dgus_ShadowState.cpp
+ *
+ * The panel keeps every VP until it is overwritten, so a VP only needs to be
+ * sent when its value differs from the last one sent. The table is kept
+ * sorted by VP so runs of adjacent dirty VPs can share one 0x82 frame.
+ */
+
+#include "../../../../inc/MarlinConfigPre.h"
+
+#if BOTH(ANYCUBIC_LCD_DGUS, ANYCUBIC_DGUS_SHADOW_STATE)
+
+#include "dgus_ShadowState.h"
+#include "dgus_tft.h"
+#if ENABLED(ANYCUBIC_DGUS_TX_QUEUE)
+  #include "dgus_TxQueue.h"
+#endif
+#include "../../../../MarlinCore.h"
+
+#define DGUS_SHADOW_MAX_RUN 32   // VPs per coalesced frame
+
+namespace Anycubic {
+
+  ShadowState::vp_shadow_t ShadowState::table[DGUS_SHADOW_VP_COUNT];
+  uint8_t ShadowState::used;
+  bool ShadowState::sending;
+
+  void ShadowState::reset() { used = 0; }
+
+  // Forget what the panel shows. Pending writes are kept.
+  void ShadowState::invalidate() {
+    for (uint8_t i = 0; i < used; i++)
+      if (!(table[i].flags & VP_DIRTY)) table[i].flags &= ~VP_VALID;
+  }
+
+  void ShadowState::invalidate(const uint16_t vp) {
+    vp_shadow_t *s = find(vp, false);
+    if (s && !(s->flags & VP_DIRTY)) s->flags &= ~VP_VALID;
+  }
+
+  // Binary search; optionally insert a new slot, evicting a clean one when full
+  ShadowState::vp_shadow_t* ShadowState::find(const uint16_t vp, const bool create) {
+    uint8_t lo = 0, hi = used;
+    while (lo < hi) {
+      const uint8_t mid = (lo + hi) >> 1;
+      if (table[mid].vp < vp) lo = mid + 1; else hi = mid;
+    }
+    if (lo < used && table[lo].vp == vp) return &table[lo];
+    if (!create) return nullptr;
+
+    if (used >= DGUS_SHADOW_VP_COUNT) {
+      uint8_t victim = 0;
+      while (victim < used && (table[victim].flags & VP_DIRTY)) victim++;
+      if (victim >= used) return nullptr;
+      memmove(&table[victim], &table[victim + 1], (used - victim - 1) * sizeof(vp_shadow_t));
+      used--;
+      if (victim < lo) lo--;
+    }
+
+    memmove(&table[lo + 1], &table[lo], (used - lo) * sizeof(vp_shadow_t));
+    used++;
+    table[lo].vp = vp;
+    table[lo].flags = 0;
+    table[lo].value = 0;
+    return &table[lo];
+  }
+
+  void ShadowState::setValue(const uint16_t vp, const uint16_t value) {
+    vp_shadow_t *s = find(vp, true);
+
+    if (!s) {   // Every slot is waiting to be sent; bypass the table
+      const uint8_t data_buf[8] = { 0x5A, 0xA5, 0x05, 0x82, uint8_t(vp >> 8), uint8_t(vp), uint8_t(value >> 8), uint8_t(value) };
+      DgusTFT::SendFrameToTFT(data_buf, 8, true);
+      return;
+    }
+
+    if ((s->flags & (VP_VALID | VP_DIRTY | VP_TEXT)) == VP_VALID && s->value == value) return;
+
+    s->value = value;
+    s->flags = VP_VALID | VP_DIRTY;
+  }
+
+  bool ShadowState::textChanged(const uint16_t vp, const char *text) {
+    uint32_t hash = 2166136261UL;   // FNV-1a
+    while (*text) hash = (hash ^ uint8_t(*text++)) * 16777619UL;
+
+    vp_shadow_t *s = find(vp, true);
+    if (!s) return true;
+    if ((s->flags & (VP_VALID | VP_DIRTY | VP_TEXT)) == (VP_VALID | VP_TEXT) && s->value == hash) return false;
+
+    s->value = hash;
+    s->flags = VP_VALID | VP_TEXT;
+    return true;
+  }
+
+  void ShadowState::sendFrame(const uint8_t first, const uint8_t count) {
+    uint8_t data_buf[6 + 2 * DGUS_SHADOW_MAX_RUN];
+    uint8_t data_index = 0;
+
+    data_buf[data_index++] = 0x5A;
+    data_buf[data_index++] = 0xA5;
+    data_buf[data_index++] = 3 + 2 * count;
+    data_buf[data_index++] = 0x82;
+    data_buf[data_index++] = table[first].vp >> 8;
+    data_buf[data_index++] = table[first].vp & 0xFF;
+
+    for (uint8_t i = first; i < first + count; i++) {
+      data_buf[data_index++] = (table[i].value >> 8) & 0xFF;
+      data_buf[data_index++] = table[i].value & 0xFF;
+      table[i].flags &= ~VP_DIRTY;
+    }
+
+    DgusTFT::SendFrameToTFT(data_buf, data_index, true);
+  }
+
+  // Send dirty VPs in address order, stopping when the byte budget runs out
+  void ShadowState::flush(uint16_t budget) {
+    NOMORE(budget, TERN(ANYCUBIC_DGUS_TX_QUEUE, TxQueue::space(), uint16_t(TFTSer.availableForWrite())));
+    send(budget);
+  }
+
+  // Send every pending write, waiting for room if need be
+  void ShadowState::sync() {
+    if (!sending) send(UINT16_MAX);
+  }
+
+  void ShadowState::send(uint16_t budget) {
+    sending = true;
+    for (uint8_t i = 0; i < used;) {
+      if (!(table[i].flags & VP_DIRTY)) { i++; continue; }
+
+      // Extend over adjacent known VPs, ending on the last dirty one
+      uint8_t n = 1, count = 1;
+      while (i + n < used && n < DGUS_SHADOW_MAX_RUN) {
+        const vp_shadow_t &s = table[i + n];
+        if (s.vp != table[i].vp + n || (s.flags & (VP_VALID | VP_TEXT)) != VP_VALID) break;
+        if (s.flags & VP_DIRTY) count = n + 1;
+        n++;
+      }
+
+      const uint16_t frame_len = 6 + 2 * count;
+      if (frame_len > budget) break;
+      sendFrame(i, count);
+      budget -= frame_len;
+      i += count;
+    }
+    sending = false;
+  }
+
+} // namespace Anycubic
+
+#endif // ANYCUBIC_LCD_DGUS && ANYCUBIC_DGUS_SHADOW_STATE
@@ -0,0 +1,68 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * lcd/extui/lib/dgus_ShadowState.h
+ *
+ * Shadow copy of the DGUS VP values last sent to the Anycubic panel.
+ * Value writes are parked in a dirty set and flushed from IdleLoop,
+ * coalescing adjacent VPs into one 0x82 frame; text writes are dropped
+ * when the text equals what the panel already shows.
+ */
+
+#include "dgus_tft_defs.h"
+
+namespace Anycubic {
+  class ShadowState {
+    public:
+      static void reset();
+      static void invalidate();
+      static void invalidate(const uint16_t vp);
+
+      static void setValue(const uint16_t vp, const uint16_t value);
+      static bool textChanged(const uint16_t vp, const char *text);
+
+      static void flush(uint16_t budget);
+
+      // Send all pending value writes now. Every immediate write (text, page
+      // switch, register) calls this first so the panel sees writes in order.
+      static void sync();
+
+    private:
+      enum : uint8_t { VP_VALID = 0x01, VP_DIRTY = 0x02, VP_TEXT = 0x04 };
+
+      typedef struct {
+        uint16_t vp;
+        uint8_t  flags;
+        uint32_t value;    // Last value or text hash
+      } vp_shadow_t;
+
+      static vp_shadow_t table[DGUS_SHADOW_VP_COUNT];
+      static uint8_t     used;
+      static bool        sending;   // Our own frames are going out
+
+      static vp_shadow_t* find(const uint16_t vp, const bool create);
+      static void         sendFrame(const uint8_t first, const uint8_t count);
+      static void         send(uint16_t budget);
+  };
+}
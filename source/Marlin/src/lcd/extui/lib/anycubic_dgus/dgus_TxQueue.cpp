@@ -0,0 +1,171 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * lcd/extui/lib/dgus_TxQueue.cpp
+ *
+ * Frames are packed back to back in buf[] in send order and frames[] holds
+ * the target and length of each. The queue is short, so frame offsets are
+ * summed on demand and sent frames are shifted out with memmove.
+ */
+
+#include "../../../../inc/MarlinConfigPre.h"
+
+#if BOTH(ANYCUBIC_LCD_DGUS, ANYCUBIC_DGUS_TX_QUEUE)
+
+#include "dgus_TxQueue.h"
+#include "../../../../MarlinCore.h"
+
+#define TX_FRAME_HEADER   6    // 5A A5 <len> <cmd> <VP>
+#define TX_FRAME_MAX    128    // Longest merged frame, well within the serial TX ring
+
+namespace Anycubic {
+
+  uint8_t  TxQueue::buf[DGUS_TX_QUEUE_SIZE];
+  uint16_t TxQueue::used;
+  TxQueue::frame_t TxQueue::frames[DGUS_TX_QUEUE_FRAMES];
+  uint8_t  TxQueue::count;
+
+  uint16_t TxQueue::peak;
+  uint32_t TxQueue::sent, TxQueue::merged, TxQueue::superseded, TxQueue::stalls;
+
+  void TxQueue::reset() { used = count = 0; }
+
+  uint16_t TxQueue::offset(const uint8_t n) {
+    uint16_t o = 0;
+    for (uint8_t i = 0; i < n; i++) o += frames[i].len;
+    return o;
+  }
+
+  void TxQueue::remove(const uint8_t n) {
+    const uint16_t o = offset(n), len = frames[n].len;
+    memmove(&buf[o], &buf[o + len], used - o - len);
+    used -= len;
+    memmove(&frames[n], &frames[n + 1], (count - n - 1) * sizeof(frame_t));
+    count--;
+  }
+
+  // Hand the oldest frame to the serial port, waiting if its TX ring is full
+  void TxQueue::sendFirst() {
+    for (uint8_t i = 0; i < frames[0].len; i++) TFTSer.write(buf[i]);
+    sent++;
+    remove(0);
+  }
+
+  void TxQueue::push(const uint8_t *frame, const uint8_t len, const bool words/*=false*/) {
+    const uint8_t cmd = frame[3];
+    const uint16_t vp = (frame[4] << 8) | frame[5];
+
+    if (cmd == 0x82 && words) {
+      const uint8_t data = len - TX_FRAME_HEADER;
+
+      // Overwrite the same VPs in the newest frame that hasn't gone out yet.
+      // A newer write that only partly covers them would land after the
+      // patch, so that ends the search.
+      const uint16_t end = vp + (data + 1) / 2;
+      for (uint8_t i = count; i--;) {
+        const frame_t &f = frames[i];
+        const uint16_t f_end = f.vp + (f.len - TX_FRAME_HEADER + 1) / 2;
+        if (f.cmd != 0x82 || vp >= f_end || end <= f.vp) continue;
+        if (!f.words || vp < f.vp || end > f_end) break;
+        memcpy(&buf[offset(i) + TX_FRAME_HEADER + 2 * (vp - f.vp)], &frame[TX_FRAME_HEADER], data);
+        superseded++;
+        return;
+      }
+
+      // Extend the last frame if this one continues its VP range
+      if (count) {
+        frame_t &f = frames[count - 1];
+        if (f.words && f.vp + (f.len - TX_FRAME_HEADER) / 2 == vp
+          && f.len + data <= TX_FRAME_MAX && used + data <= DGUS_TX_QUEUE_SIZE
+        ) {
+          memcpy(&buf[used], &frame[TX_FRAME_HEADER], data);
+          buf[used - f.len + 2] += data;    // Frame length byte
+          used += data;
+          f.len += data;
+          NOLESS(peak, used);
+          merged++;
+          return;
+        }
+      }
+    }
+    else if (cmd == 0x82) {
+      // A newer text or register write replaces the queued one
+      for (uint8_t i = 0; i < count; i++)
+        if (frames[i].cmd == 0x82 && !frames[i].words && frames[i].vp == vp) {
+          remove(i);
+          superseded++;
+          break;
+        }
+    }
+
+    append(frame, len, cmd, vp, words);
+  }
+
+  // Queue bytes that aren't a VP frame, e.g., text. Nothing merges with them.
+  void TxQueue::write(const uint8_t *data, const uint8_t len) {
+    append(data, len, 0, 0, false);
+  }
+
+  void TxQueue::append(const uint8_t *data, const uint8_t len, const uint8_t cmd, const uint16_t vp, const bool words) {
+    // Make room, waiting on the UART only when the queue is full
+    if (count >= DGUS_TX_QUEUE_FRAMES || used + len > DGUS_TX_QUEUE_SIZE) {
+      pump();
+      while (count && (count >= DGUS_TX_QUEUE_FRAMES || used + len > DGUS_TX_QUEUE_SIZE)) {
+        stalls++;
+        sendFirst();
+      }
+    }
+
+    memcpy(&buf[used], data, len);
+    used += len;
+    frame_t &f = frames[count++];
+    f.vp = vp;
+    f.cmd = cmd;
+    f.len = len;
+    f.words = words;
+    NOLESS(peak, used);
+  }
+
+  // Move whole frames to the serial TX ring while they fit
+  void TxQueue::pump() {
+    while (count && frames[0].len <= TFTSer.availableForWrite()) sendFirst();
+  }
+
+  // Send everything now, e.g., before the printer halts
+  void TxQueue::flush() {
+    while (count) sendFirst();
+  }
+
+  void TxQueue::resetStats() {
+    peak = used;
+    sent = merged = superseded = stalls = 0;
+  }
+
+  void TxQueue::reportStats() {
+    SERIAL_ECHOLNPAIR("LCD TX queue:", count, " frames ", used, "/", DGUS_TX_QUEUE_SIZE, " bytes peak:", peak);
+    SERIAL_ECHOLNPAIR("LCD TX sent:", sent, " merged:", merged, " superseded:", superseded, " stalls:", stalls);
+  }
+
+} // namespace Anycubic
+
+#endif // ANYCUBIC_LCD_DGUS && ANYCUBIC_DGUS_TX_QUEUE
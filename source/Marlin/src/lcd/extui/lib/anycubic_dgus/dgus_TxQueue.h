@@ -0,0 +1,70 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * lcd/extui/lib/dgus_TxQueue.h
+ *
+ * Whole-frame transmit queue for the Anycubic DGUS panel. Frames wait here
+ * until the serial TX ring (drained by the USART interrupt) can take all of
+ * a frame, so the main loop never waits on the UART. While queued, a write
+ * to a VP replaces an earlier write to the same VP, and VP value writes
+ * that continue the last frame are appended to it. Text and other raw
+ * bytes are queued in order with the frames and never merged.
+ */
+
+#include "dgus_tft_defs.h"
+
+namespace Anycubic {
+  class TxQueue {
+    public:
+      static void reset();
+      static void push(const uint8_t *frame, const uint8_t len, const bool words=false);
+      static void write(const uint8_t *data, const uint8_t len);
+      static void pump();
+      static void flush();
+      static uint16_t space() { return DGUS_TX_QUEUE_SIZE - used; }
+
+      static void resetStats();
+      static void reportStats();
+
+    private:
+      typedef struct {
+        uint16_t vp;
+        uint8_t  cmd, len;
+        bool     words;    // VP value writes only; may be extended
+      } frame_t;
+
+      static uint8_t  buf[DGUS_TX_QUEUE_SIZE];
+      static uint16_t used;
+      static frame_t  frames[DGUS_TX_QUEUE_FRAMES];
+      static uint8_t  count;
+
+      static uint16_t peak;
+      static uint32_t sent, merged, superseded, stalls;
+
+      static uint16_t offset(const uint8_t n);
+      static void     remove(const uint8_t n);
+      static void     sendFirst();
+      static void     append(const uint8_t *data, const uint8_t len, const uint8_t cmd, const uint16_t vp, const bool words);
+  };
+}
@@ -35,6 +35,13 @@
 #include "dgus_tft.h"
 #include "dgus_Tunes.h"
 #include "dgus_FileNavigator.h"
+#include "dgus_FrameReceiver.h"
+#if ENABLED(ANYCUBIC_DGUS_SHADOW_STATE)
+  #include "dgus_ShadowState.h"
+#endif
+#if ENABLED(ANYCUBIC_DGUS_TX_QUEUE)
+  #include "dgus_TxQueue.h"
+#endif
 
 #include "../../../../gcode/queue.h"
 #include "../../../../sd/cardreader.h"
@@ -62,42 +69,77 @@ namespace Anycubic {
 
   const char *p_mesage[]={MESSAGE_charu ,MESSAGE_bachu ,MESSAGE_wuka,MESSAGE_lianji ,MESSAGE_tuoji ,MESSAGE_zanting, MESSAGE_tingzhi ,MESSAGE_wancheng ,MESSAGE_hotend_heating, MESSAGE_hotend_over, MESSAGE_bed_heating, MESSAGE_bed_over, MESSAGE_ready, MESSAGE_cold};
 
-  DgusTFT::p_fun fun_array[] = {
-                         DgusTFT::page1_handle,
-                         DgusTFT::page2_handle,
-                         DgusTFT::page3_handle,
-                         DgusTFT::page4_handle,
-                         DgusTFT::page5_handle,
-                         DgusTFT::page6_handle,
-                         DgusTFT::page7_handle,
-                         DgusTFT::page8_handle,
-                         DgusTFT::page9_handle,
-                         DgusTFT::page10_handle,
-                         DgusTFT::page11_handle,
-                         DgusTFT::page12_handle,
-                         DgusTFT::page13_handle,
-                         DgusTFT::page14_handle,
-                         DgusTFT::page15_handle,
-                         DgusTFT::page16_handle,
-                         DgusTFT::page17_handle,
-                         DgusTFT::page18_handle,
-                         DgusTFT::page19_handle,
-                         DgusTFT::page20_handle,
-                         DgusTFT::page21_handle,
-                         DgusTFT::page22_handle,
-                         DgusTFT::page23_handle,
-                         DgusTFT::page24_handle,
-                         DgusTFT::page25_handle,
-                         DgusTFT::page26_handle,
-                         DgusTFT::page27_handle,
-                         DgusTFT::page28_handle,
-                         DgusTFT::page29_handle,
-                         DgusTFT::page30_handle,
-                         DgusTFT::page31_handle,
-                         DgusTFT::page32_handle,
-                         DgusTFT::page33_handle,
-                         DgusTFT::page34_handle
-                       };
+  // VPs each page shows, re-sent in full whenever the page is entered
+  static const uint16_t vps_main[]     = { TXT_MAIN_BED, TXT_MAIN_HOTEND, TXT_MAIN_MESSAGE, 0 };
+  static const uint16_t vps_file[]     = { TXT_FILE_0, TXT_FILE_1, TXT_FILE_2, TXT_FILE_3, TXT_FILE_4, 0 };
+  static const uint16_t vps_status[]   = { TXT_PRINT_NAME, TXT_PRINT_SPEED, TXT_PRINT_TIME, TXT_PRINT_PROGRESS, 0 };
+  static const uint16_t vps_adjust[]   = { TXT_ADJUST_HOTEND, TXT_ADJUST_BED, TXT_ADJUST_SPEED, TXT_FAN_SPEED_TARGET,
+                                           TXT_LEVEL_OFFSET, ADDRESS_PRINT_SETTING_LED_STATUS, 0 };
+  static const uint16_t vps_tool[]     = { ADDRESS_SYSTEM_LED_STATUS, 0 };
+  static const uint16_t vps_move[]     = { ADDRESS_MOVE_DISTANCE, 0 };
+  static const uint16_t vps_temp[]     = { TXT_BED_NOW, TXT_BED_TARGET, TXT_HOTNED_NOW, TXT_HOTEND_TARGET, 0 };
+  static const uint16_t vps_speed[]    = { TXT_FAN_SPEED_NOW, TXT_FAN_SPEED_TARGET, TXT_PRINT_SPEED_NOW, TXT_PRINT_SPEED_TARGET, 0 };
+  static const uint16_t vps_about[]    = { TXT_ABOUT_DEVICE_NAME, TXT_ABOUT_FW_VERSION, TXT_ABOUT_PRINT_VOLUMN, TXT_ABOUT_TECH_SUPPORT, 0 };
+  static const uint16_t vps_record[]   = { TXT_RECORT_0, TXT_RECORT_1, TXT_RECORT_2, TXT_RECORT_3, TXT_RECORT_4, TXT_RECORT_5, 0 };
+  static const uint16_t vps_offset[]   = { TXT_LEVEL_OFFSET, 0 };
+  static const uint16_t vps_preheat[]  = { TXT_PREHEAT_HOTEND, TXT_PREHEAT_BED, TXT_PREHEAT_HOTEND_INPUT, TXT_PREHEAT_BED_INPUT, 0 };
+  static const uint16_t vps_filament[] = { TXT_FILAMENT_TEMP, 0 };
+  static const uint16_t vps_finish[]   = { TXT_FINISH_TIME, 0 };
+  static const uint16_t vps_outage[]   = { TXT_OUTAGE_RECOVERY_FILE, TXT_OUTAGE_RECOVERY_PROGRESS, 0 };
+
+  // Handler, refresh period and VPs of each page. Pages 1-34 are given in CHS
+  // numbering; their ENG twins are 120 higher. A handler runs on page entry,
+  // on a key press and then every refresh_ms (never, if 0).
+  const DgusTFT::page_t page_table[] = {
+    {   1,   1, DgusTFT::page1_handle,            0, vps_main     },
+    {   2,   2, DgusTFT::page2_handle,            0, vps_file     },
+    {   3,   3, DgusTFT::page3_handle,         1500, vps_status   },
+    {   4,   4, DgusTFT::page4_handle,         1500, vps_status   },
+    {   5,   5, DgusTFT::page5_handle,            0, vps_adjust   },
+    {   6,   6, DgusTFT::page6_handle,            0, nullptr      },
+    {   7,   7, DgusTFT::page7_handle,            0, vps_tool     },
+    {   8,   8, DgusTFT::page8_handle,            0, vps_move     },
+    {   9,   9, DgusTFT::page9_handle,         1500, vps_temp     },
+    {  10,  10, DgusTFT::page10_handle,        1500, vps_speed    },
+    {  11,  11, DgusTFT::page11_handle,           0, nullptr      },
+    {  12,  12, DgusTFT::page12_handle,           0, nullptr      },
+    {  13,  13, DgusTFT::page13_handle,           0, vps_about    },
+    {  14,  14, DgusTFT::page14_handle,           0, vps_record   },
+    {  15,  15, DgusTFT::page15_handle,           0, nullptr      },
+    {  16,  16, DgusTFT::page16_handle,           0, nullptr      },
+    {  17,  17, DgusTFT::page17_handle,           0, vps_offset   },
+    {  18,  18, DgusTFT::page18_handle,        1500, vps_preheat  },
+    {  19,  19, DgusTFT::page19_handle,        1000, vps_filament },
+    {  20,  20, DgusTFT::page20_handle,           0, nullptr      },
+    {  21,  21, DgusTFT::page21_handle,           0, nullptr      },
+    {  22,  22, DgusTFT::page22_handle,           0, vps_finish   },
+    {  23,  23, DgusTFT::page23_handle,           0, nullptr      },
+    {  24,  24, DgusTFT::page24_handle,           0, nullptr      },
+    {  25,  25, DgusTFT::page25_handle,           0, nullptr      },
+    {  26,  26, DgusTFT::page26_handle,           0, nullptr      },
+    {  27,  27, DgusTFT::page27_handle,           0, nullptr      },
+    {  28,  28, DgusTFT::page28_handle,           0, nullptr      },
+    {  29,  29, DgusTFT::page29_handle,           0, nullptr      },
+    {  30,  30, DgusTFT::page30_handle,           0, nullptr      },
+    {  31,  31, DgusTFT::page31_handle,           0, nullptr      },
+    {  32,  32, DgusTFT::page32_handle,           0, nullptr      },
+    {  33,  33, DgusTFT::page33_handle,           0, nullptr      },
+    {  34,  34, DgusTFT::page34_handle,        1500, nullptr      },
+    { 115, 115, DgusTFT::page115_handle,          0, vps_offset   },
+    { 117, 117, DgusTFT::page117_handle,          0, nullptr      },
+    { 170, 170, DgusTFT::page170_handle,          0, nullptr      },
+    { 171, 171, DgusTFT::page171_handle,          0, vps_outage   },
+    { 173, 173, DgusTFT::page173_handle,          0, vps_outage   },
+    { 175, 175, DgusTFT::page175_handle,          0, nullptr      },
+    { 176, 176, DgusTFT::page176_handle,          0, nullptr      },
+    { 199, 200, DgusTFT::page199_to_200_handle,   0, nullptr      },
+    { 201, 201, DgusTFT::page201_handle,        100, nullptr      },
+    { 202, 202, DgusTFT::page202_handle,          0, nullptr      },
+    { 203, 203, DgusTFT::page203_handle,          0, nullptr      },
+    { 204, 204, DgusTFT::page201_handle,        100, nullptr      },
+    { 205, 205, DgusTFT::page202_handle,          0, nullptr      },
+    { 206, 206, DgusTFT::page203_handle,          0, nullptr      }
+  };
   
 
   printer_state_t  DgusTFT::printer_state;
@@ -112,8 +154,7 @@ namespace Anycubic {
   file_menu_t      DgusTFT::file_menu;
   
   bool             DgusTFT::data_received;
-  uint8_t          DgusTFT::data_buf[64];
-  uint8_t          DgusTFT::data_index;
+  uint8_t          DgusTFT::data_buf[AC_RX_FRAME_MAX];
   uint32_t         DgusTFT::page_index_last;
   uint32_t         DgusTFT::page_index_last_2;
   uint32_t         DgusTFT::page_index_now;
@@ -171,6 +212,13 @@ namespace Anycubic {
     // opt_enable FIL_RUNOUT_PULLUP
 
     TFTSer.begin(115200);
+#if ENABLED(ANYCUBIC_DGUS_LOAD_STATS)
+    HAL_cycle_counter_init();
+    ResetLoad();
+#endif
+    FrameReceiver::reset();
+    TERN_(ANYCUBIC_DGUS_SHADOW_STATE, ShadowState::reset());
+    TERN_(ANYCUBIC_DGUS_TX_QUEUE, TxQueue::reset());
 
     // Signal Board has reset
 //    SendtoTFTLN(AC_msg_main_board_has_reset);
@@ -217,6 +265,8 @@ namespace Anycubic {
   }
 
   void DgusTFT::IdleLoop()  {
+    TERN_(ANYCUBIC_DGUS_LOAD_STATS, const uint32_t cycles = HAL_cycle_count());
+
     if (ReadTFTCommand()) {
       ProcessPanelRequest();
       command_len = 0;
@@ -241,75 +291,92 @@ namespace Anycubic {
         SendTxtToTFT(str_buf, TXT_MAIN_BED);
     }
 
-    if(page_index_now == 115) {
-      page115_handle();
-    } else if(page_index_now == 117) {
-      page117_handle();
-    } else if(page_index_now == 170) {
-      page170_handle();
-    } else if(page_index_now == 171) {
-      page171_handle();
-    } else if(page_index_now == 173) {
-      page173_handle();
-    } else if(page_index_now == 175) {
-      page175_handle();
-    } else if(page_index_now == 176) {
-      page176_handle();
-    } else if(177 <= page_index_now && page_index_now <= 198) {
-#if 0 // ACDEBUG(AC_MARLIN)
-        SERIAL_ECHOLNPAIR("line: ", __LINE__);
-        SERIAL_ECHOLNPAIR("func: ", page_index_now);
-#endif
-//      page177_to_198_handle();
-    } else if(199 == page_index_now || page_index_now == 200) {
-#if 0 // ACDEBUG(AC_MARLIN)
-        SERIAL_ECHOLNPAIR("line: ", __LINE__);
-        SERIAL_ECHOLNPAIR("func: ", page_index_now);
-#endif
-      page199_to_200_handle();
-    } else if(page_index_now == 201 || page_index_now == 204) {
+    DispatchPage();
 
-      page201_handle();
+    pop_up_manager();
+    key_value = 0;
 
-    } else if(page_index_now == 202 || page_index_now == 205) {
+    CheckHeaters();
 
-      page202_handle();
+    TERN_(ANYCUBIC_DGUS_SHADOW_STATE, ShadowState::flush(DGUS_SHADOW_TX_BUDGET));
+    TERN_(ANYCUBIC_DGUS_TX_QUEUE, TxQueue::pump());
 
-    } else if(page_index_now == 203 || page_index_now == 206) {
+#if ENABLED(ANYCUBIC_DGUS_LOAD_STATS)
+    const uint32_t spent = HAL_cycle_count() - cycles;
+    load_count++;
+    load_total += spent;
+    NOLESS(load_max, spent);
+#endif
+  }
 
-      page203_handle();
+  const DgusTFT::page_t* DgusTFT::FindPage(uint32_t page) {
+    // ENG pages 121-155 share the CHS handlers
+    if(120 < page && page < 156) {
+      if(lcd_info.language != ExtUI::ENG) return nullptr;
+      page -= 120;
+    } else if(page < 36 && lcd_info.language != ExtUI::CHS) {
+      return nullptr;
+    }
 
-    } else {
+    for(uint8_t i = 0; i < COUNT(page_table); i++) {
+      if(WITHIN(page, page_table[i].first, page_table[i].last)) {
+        return &page_table[i];
+      }
+    }
+    return nullptr;
+  }
 
-      if(lcd_info.language == ExtUI::CHS) {
-        if(0 < page_index_now && page_index_now < 36) {
-          fun_array[page_index_now-1]();
-        } else {
-#if ACDEBUG(AC_MARLIN)
-          SERIAL_ECHOLNPAIR("line: ", __LINE__);
-          SERIAL_ECHOLNPAIR("fun not exists: ", page_index_now);
-#endif
-        }
-      } else if(lcd_info.language == ExtUI::ENG) {
-        if(120 < page_index_now && page_index_now < 156) {
-          fun_array[page_index_now-1-120]();  // ENG page_index is 120 more than CHS
-        } else {
+  // Run the shown page's handler on entry, on a key press and at its refresh rate
+  void DgusTFT::DispatchPage() {
+    static uint32_t page_last = 0;
+    static millis_t next_refresh_ms = 0;
+
+    const page_t *page = FindPage(page_index_now);
+    if(!page) {
 #if ACDEBUG(AC_MARLIN)
-          SERIAL_ECHOLN("lcd function not exists");
-          SERIAL_ECHOLNPAIR("page_index_last: ", page_index_last);
-          SERIAL_ECHOLNPAIR("page_index_last_2: ", page_index_last_2);
-#endif
-        }
+      if(page_index_now != page_last) {
+        SERIAL_ECHOLNPAIR("fun not exists: ", page_index_now);
       }
+#endif
+      page_last = page_index_now;
+      return;
+    }
 
+    if(page_index_now == page_last && !key_value &&
+       !(page->refresh_ms && ELAPSED(millis(), next_refresh_ms))) {
+      return;
     }
 
-    pop_up_manager();
-    key_value = 0;
+    page_last = page_index_now;
+    page->handler();
+    next_refresh_ms = millis() + page->refresh_ms;
+  }
 
-    CheckHeaters();
+#if ENABLED(ANYCUBIC_DGUS_LOAD_STATS)
+
+  uint32_t DgusTFT::load_count, DgusTFT::load_max;
+  uint64_t DgusTFT::load_total;
+  millis_t DgusTFT::load_ms;
+
+  void DgusTFT::ResetLoad() {
+    load_count = load_max = 0;
+    load_total = 0;
+    load_ms = millis();
+  }
+
+  // Cycles spent in IdleLoop and their share of the CPU, in per mille
+  void DgusTFT::ReportLoad() {
+    const millis_t ms = millis() - load_ms;
+    const uint32_t avg = load_count ? uint32_t(load_total / load_count) : 0,
+                   load = ms ? uint32_t(load_total / ms * 1000 / (F_CPU / 1000)) : 0;
+    SERIAL_ECHOLNPAIR("LCD cycles over ", ms, "ms");
+    SERIAL_ECHOPAIR("LCD    n:", load_count, " avg:", avg, " max:", load_max, " load:", load / 10);
+    SERIAL_CHAR('.', '0' + char(load % 10));
+    SERIAL_ECHOLNPGM("%");
   }
 
+#endif
+
   void DgusTFT::PrinterKilled(PGM_P error,PGM_P component)  {
 //    SendtoTFTLN(AC_msg_kill_lcd);
     #if ACDEBUG(AC_MARLIN)
@@ -368,6 +435,7 @@ namespace Anycubic {
         }
     }
 
+    TERN_(ANYCUBIC_DGUS_TX_QUEUE, TxQueue::flush());   // IdleLoop won't run again
   }
 
   void DgusTFT::MediaEvent(media_event_t event)  {
@@ -660,6 +728,13 @@ namespace Anycubic {
 //        SendtoTFTLN(AC_msg_bed_heating);
         hotbed_state = AC_heater_temp_set;
       }
+      #if ENABLED(PREHEAT_SCHEDULER)
+        else if (strncmp(msg, MARLIN_msg_preheating, strlen(MARLIN_msg_preheating)) == 0) {
+          // M193 progress: "Preheat <percent>% <seconds>s"
+          hotend_state = hotbed_state = AC_heater_temp_set;
+          SendTxtToTFT(msg, TXT_MAIN_MESSAGE);
+        }
+      #endif
     }
   }
 
@@ -669,9 +744,7 @@ namespace Anycubic {
 
     uint8_t data_buf[8] = { 0x5A, 0xA5, 0x05, 0x82, 0x00, 0x82, 0x00, 0x00 };
 
-    for(uint8_t i=0; i<8; i++) {
-      TFTSer.write(data_buf[i]);
-    }
+    SendFrameToTFT(data_buf, 8, true);
   }
 
   void DgusTFT::PowerLossRecovery()  {
@@ -705,11 +778,54 @@ namespace Anycubic {
     #if ACDEBUG(AC_SOME)
       serialprintPGM(str);
     #endif
-    while (const char c = pgm_read_byte(str++)) TFTSer.print(c);
+    // Text is queued behind any pending frames, a chunk at a time
+    uint8_t chunk[32];
+    uint8_t n = 0;
+    while (const char c = pgm_read_byte(str++)) {
+      chunk[n++] = c;
+      if (n == sizeof(chunk)) { SendBytesToTFT(chunk, n); n = 0; }
+    }
+    if (n) SendBytesToTFT(chunk, n);
+  }
+
+  void DgusTFT::SendtoTFTLN(PGM_P str/*=nullptr*/) {
+    if (str) SendtoTFT(str);
+    SendtoTFT(PSTR("\r\n"));
+  }
+
+  // Raw bytes, not a VP frame
+  void DgusTFT::SendBytesToTFT(const uint8_t *data, uint8_t len) {
+    TERN_(ANYCUBIC_DGUS_SHADOW_STATE, ShadowState::sync());
+#if ENABLED(ANYCUBIC_DGUS_TX_QUEUE)
+    TxQueue::write(data, len);
+#else
+    for(uint8_t i=0; i<len; i++) {
+      TFTSer.write(data[i]);
+    }
+#endif
+  }
+
+  // All panel output goes through here; VP value writes are flagged as words
+  void DgusTFT::SendFrameToTFT(const uint8_t *frame, uint8_t len, bool words) {
+    TERN_(ANYCUBIC_DGUS_SHADOW_STATE, ShadowState::sync());   // Deferred values go first
+#if ENABLED(ANYCUBIC_DGUS_TX_QUEUE)
+    TxQueue::push(frame, len, words);
+#else
+    UNUSED(words);
+    for(uint8_t i=0; i<len; i++) {
+      TFTSer.write(frame[i]);
+    }
+#endif
   }
 
   void DgusTFT::SendValueToTFT(uint32_t value, uint32_t address) {
 
+#if ENABLED(ANYCUBIC_DGUS_SHADOW_STATE)
+
+    ShadowState::setValue(address, value);    // Sent from IdleLoop if changed
+
+#else
+
     uint8_t data_buf[32] = {0};
     uint8_t data_index = 0;
 
@@ -727,9 +843,9 @@ namespace Anycubic {
     p_u8--;
     data_buf[data_index++] = *p_u8;
 
-    for(uint8_t i=0; i<data_index; i++) {
-      TFTSer.write(data_buf[i]);
-    }
+    SendFrameToTFT(data_buf, data_index, true);
+
+#endif
   }
 
   void DgusTFT::RequestValueFromTFT(uint32_t address) {
@@ -748,9 +864,7 @@ namespace Anycubic {
     data_buf[data_index++] = *p_u8;
     data_buf[data_index++] = 0x01;
 
-    for(uint8_t i=0; i<data_index; i++) {
-      TFTSer.write(data_buf[i]);
-    }
+    SendFrameToTFT(data_buf, data_index);
   }
   
 
@@ -760,6 +874,12 @@ namespace Anycubic {
     uint8_t data_index = 0;
     uint8_t data_len = 0;
 
+#if ENABLED(ANYCUBIC_DGUS_SHADOW_STATE)
+    if(!ShadowState::textChanged(address, pdata)) {
+      return;
+    }
+#endif
+
     uint8_t *p_u8 =  (uint8_t *)(&address)+1 ;
     data_len = strlen(pdata);
 
@@ -777,9 +897,7 @@ namespace Anycubic {
     data_buf[data_index++] = 0xFF;
     data_buf[data_index++] = 0xFF;
 
-    for(uint8_t i=0; i<data_index; i++) {
-      TFTSer.write(data_buf[i]);
-    }
+    SendFrameToTFT((uint8_t *)data_buf, data_index);
   }
 
   void DgusTFT::SendColorToTFT(uint32_t color, uint32_t address) {
@@ -802,9 +920,7 @@ namespace Anycubic {
     p_u8--;
     data_buf[data_index++] = *p_u8;
 
-    for(uint8_t i=0; i<data_index; i++) {
-      TFTSer.write(data_buf[i]);
-    }
+    SendFrameToTFT(data_buf, data_index, true);
   }
 
   void DgusTFT::SendReadNumOfTxtToTFT(uint8_t number, uint32_t address) {
@@ -822,9 +938,7 @@ namespace Anycubic {
     data_buf[data_index++] = *p_u8;
     data_buf[data_index++] = number;    //how much bytes to read
 
-    for(uint8_t i=0; i<data_index; i++) {
-      TFTSer.write(data_buf[i]);
-    }
+    SendFrameToTFT(data_buf, data_index);
   }
 
   void DgusTFT::ChangePageOfTFT(uint32_t page_index) {
@@ -868,9 +982,20 @@ namespace Anycubic {
     p_u8--;
     data_buf[data_index++] = *p_u8;
 
-    for(uint8_t i=0; i<data_index; i++) {
-      TFTSer.write(data_buf[i]);
+    SendFrameToTFT(data_buf, data_index);
+
+#if ENABLED(ANYCUBIC_DGUS_SHADOW_STATE)
+    // The new page may have edited its VPs without reporting them.
+    // A page with no VP list could show anything, so forget them all.
+    const page_t *page = FindPage(data_temp);
+    if(!page || !page->vps) {
+      ShadowState::invalidate();
+    } else {
+      for(const uint16_t *vp = page->vps; *vp; vp++) {
+        ShadowState::invalidate(*vp);
+      }
     }
+#endif
 
     page_index_last_2 = page_index_last;
     page_index_last = page_index_now;
@@ -932,75 +1057,20 @@ namespace Anycubic {
         data_buf[9] = 0x12;
     }
 
-    for(uint8_t i=0; i<10; i++) {
-      TFTSer.write(data_buf[i]);
-    }
+    SendFrameToTFT(data_buf, 10);
   }
 
   bool DgusTFT::ReadTFTCommand() {
 
-    static uint32_t tft_last_check = 0;
-
-    static uint8_t length = 0, cnt = 0, tft_receive_steps = 0;
-	uint8_t data;
-
-	if(0 == TFTSer.available() || data_received) {
-	  return false;
-	}
-
-	data = TFTSer.read();
-
-    if(tft_receive_steps==0) {
-      if(data != 0x5a) {
-        cnt = 0;
-        length = 0;
-        data_index = 0;
-        data_received = 0;
-        return false;
-      }
-
-      tft_last_check = millis();
-      while(!TFTSer.available()) {
-        TERN_(USE_WATCHDOG, HAL_watchdog_refresh());
-        if(millis() - tft_last_check > 500) {
-          data_index = 0;
-          data_received = 0;
-          printf("lcd ReadTFTCommand error\n");
-          return false;
-        }
-      }
+    FrameReceiver::poll();
 
-      data = TFTSer.read(); 
-      //MYSERIAL.write(data );
-      if(data == 0xa5) {
-        tft_receive_steps=2;
-      }
-    } else if(tft_receive_steps==2) {  
-      length = data;
-      tft_receive_steps = 3;
-      data_index = 0;
-      cnt = 0 ;
-    } else if(tft_receive_steps==3) {
-      if(data_index >= 63) {
-#if ACDEBUG(AC_MARLIN)
-        SERIAL_ECHOLNPAIR("lcd uart buff overflow: ", data_index);
-#endif
-        data_index = 0;
-        data_received = 0;
-        return false;
-      }
-      data_buf[data_index++] = data;
-      cnt++;
-      if(cnt>=length) {   //Receive complete
-        tft_receive_steps = 0;
-        cnt = 0;
-        data_index = 0;
-        data_received = 1;
-        return true;
-      }
+    // One frame per loop; the page handlers consume key_value before the next
+    if(data_received || !FrameReceiver::pop(data_buf)) {
+      return false;
     }
 
-    return false;
+    data_received = 1;
+    return true;
   }
 
 #if 0
@@ -1159,6 +1229,8 @@ namespace Anycubic {
   		*p_u8 = data_buf[2];
   		p_u8++;
   		*p_u8 = data_buf[1] ;
+
+        TERN_(ANYCUBIC_DGUS_SHADOW_STATE, ShadowState::invalidate(control_index));   // Panel wrote this VP
   
         if((control_index&0xF000) == KEY_ADDRESS)// is KEY
         {
@@ -1322,7 +1394,6 @@ namespace Anycubic {
 
   void DgusTFT::page1_handle(void) {
 
-	static millis_t flash_time = 0;
 	char str_buf[20];
 
 	switch (key_value) {
@@ -1384,12 +1455,6 @@ namespace Anycubic {
 	 message_index = 30;
 	}
 #endif
-
-	if(millis() < (flash_time + 1500) ) {
-	  return;
-	}
-
-	flash_time = millis();
   }
 
 
@@ -1572,7 +1637,6 @@ namespace Anycubic {
     void DgusTFT::page3_handle(void)
     {
         
-        static millis_t flash_time = 0;
         char str_buf[20];
         static int16_t speed_last = -1;
         static uint8_t progress_last = 0;
@@ -1604,7 +1668,6 @@ namespace Anycubic {
               pause_state = AC_paused_idle;
               resumePrint();
               ChangePageOfTFT(PAGE_STATUS2);    // show pasue print
-              flash_time = millis();
 
             } else {
               setUserConfirmed();
@@ -1626,15 +1689,9 @@ namespace Anycubic {
             SendValueToTFT((uint16_t)getTargetTemp_celsius(BED), TXT_ADJUST_BED);
             feedrate_last = (uint16_t)getFeedrate_percent();
             SendValueToTFT(feedrate_last, TXT_ADJUST_SPEED);
-            flash_time = millis();
             break;
         }
 
-        if(millis() < (flash_time +1500) ) {
-          return;
-        }
-        flash_time=millis();
-
         if(feedrate_last != (uint16_t)getFeedrate_percent()) {
           feedrate_last = (uint16_t)getFeedrate_percent();
           sprintf(str_buf, "%d", feedrate_last);
@@ -1657,7 +1714,6 @@ namespace Anycubic {
     void DgusTFT::page4_handle(void)
     {
         
-        static millis_t flash_time = 0;
         char str_buf[20];
         static uint8_t progress_last = 0;
 		static uint16_t feedrate_last = 0;
@@ -1707,11 +1763,6 @@ namespace Anycubic {
           break;
         }
 
-        if(millis() < (flash_time +1500)) {
-          return;
-        }
-        flash_time=millis();
-
         if(feedrate_last != (uint16_t)getFeedrate_percent()) {
           feedrate_last = (uint16_t)getFeedrate_percent();
           sprintf(str_buf, "%d", feedrate_last);
@@ -2024,7 +2075,6 @@ namespace Anycubic {
 
     void DgusTFT::page9_handle(void)
     {
-       static millis_t flash_time = 0;
      
         switch (key_value)
         {
@@ -2062,11 +2112,6 @@ namespace Anycubic {
             ChangePageOfTFT(PAGE_TOOL);
           break;
     }
-
-        if(millis() < (flash_time +1500) ) {
-          return;
-        }
-        flash_time=millis();
     
         SendValueToTFT( (uint16_t)getActualTemp_celsius(E0), TXT_HOTNED_NOW);
         SendValueToTFT( (uint16_t)getActualTemp_celsius(BED), TXT_BED_NOW);
@@ -2074,7 +2119,6 @@ namespace Anycubic {
     
     void DgusTFT::page10_handle(void)
     {
-        static millis_t flash_time = 0;
         switch (key_value)
         {
                 case 0:
@@ -2106,11 +2150,6 @@ namespace Anycubic {
             ChangePageOfTFT(PAGE_TOOL);
           break;
     }
-    
-      if(millis() < (flash_time +1500)) {
-        return;
-      }
-      flash_time=millis();
   
        SendValueToTFT((uint16_t)getActualFan_percent(FAN0), TXT_FAN_SPEED_NOW);
        SendValueToTFT((uint16_t)getFeedrate_percent(), TXT_PRINT_SPEED_NOW);
@@ -2435,7 +2474,6 @@ namespace Anycubic {
 
         void DgusTFT::page18_handle(void) //preheat
         {
-            static millis_t flash_time = 0;
             char str_buf[16];
 
             switch (key_value)
@@ -2467,11 +2505,6 @@ namespace Anycubic {
 
             }
 
-            if(millis() < (flash_time +1500) ) {
-              return;
-            }
-            flash_time=millis();
-
             sprintf(str_buf,"%u/%u",(uint16_t)getActualTemp_celsius(E0), (uint16_t)getTargetTemp_celsius(E0));
             SendTxtToTFT(str_buf, TXT_PREHEAT_HOTEND);
             sprintf(str_buf,"%u/%u",(uint16_t)getActualTemp_celsius(BED), (uint16_t)getTargetTemp_celsius(BED));
@@ -2489,7 +2522,6 @@ namespace Anycubic {
             char str_buf[20];
             static bool fil_need_in = 0;
             static filament_cmd_t filament_cmd = FILA_NO_ACT;
-            static millis_t flash_time = 0;
             switch (key_value)
             {
               case 0:
@@ -2535,11 +2567,6 @@ namespace Anycubic {
               
             }
 
-            if(millis() < (flash_time +1000) ) {
-              return;
-            }
-            flash_time=millis();
-
             sprintf(str_buf,"%u/%u",(uint16_t)getActualTemp_celsius(E0), (uint16_t)getTargetTemp_celsius(E0));
             SendTxtToTFT(str_buf, TXT_FILAMENT_TEMP);
 
@@ -2559,7 +2586,6 @@ namespace Anycubic {
 
         void DgusTFT::page20_handle(void)   // confirm
         {
-            static millis_t flash_time = 0;
             switch (key_value)
             {
               case 0:
@@ -2571,14 +2597,11 @@ namespace Anycubic {
               break;
 
             }
-            if(millis() < (flash_time +1000) )return;
-            flash_time=millis();
         
         }
 
         void DgusTFT::page21_handle(void)
         {
-            static millis_t flash_time = 0;
             switch (key_value)
             {
               case 0:
@@ -2595,14 +2618,10 @@ namespace Anycubic {
               }
               break;
             }
-
-            if(millis() < (flash_time +1000) )return;
-             flash_time=millis();
         }
     
         void DgusTFT::page22_handle(void)   // print finish
         {
-            static millis_t flash_time = 0;
             switch (key_value)
             {
               case 0:
@@ -2624,13 +2643,10 @@ namespace Anycubic {
               }
               break;
             }
-                if(millis() < (flash_time +1000) )return;
-                flash_time=millis();
             }
 
             void DgusTFT::page23_handle(void)
             {
-                static millis_t flash_time = 0;
                 switch (key_value)
                 {
                   case 0:
@@ -2648,15 +2664,12 @@ namespace Anycubic {
                   }
                   break;
                 }
-
-             if(millis() < (flash_time +1000) )return;
-               flash_time=millis();
             
             }
     
             
             void DgusTFT::page24_handle(void)
-            {static millis_t flash_time = 0;
+            {
                 switch (key_value)
                     {
             
@@ -2674,13 +2687,10 @@ namespace Anycubic {
                       break;
             
                     }
-                    if(millis() < (flash_time +1000) )return;
-                  flash_time=millis();
             }
 
             void DgusTFT::page25_handle(void)   // lack filament
             {
-               static millis_t flash_time = 0;
                 switch (key_value)
                 {
                   case 0:
@@ -2701,13 +2711,10 @@ namespace Anycubic {
                   }
                   break;
                 }
-                if(millis() < (flash_time +1000) )return;
-                flash_time=millis();
             }
 
             void DgusTFT::page26_handle(void)
             {
-            static millis_t flash_time = 0;
                 switch (key_value)
                     {
             
@@ -2727,16 +2734,12 @@ namespace Anycubic {
             
                     }
     
-    
-              if(millis() < (flash_time +1000) )return;
-              flash_time=millis();
             
             }
     
     
         void DgusTFT::page27_handle(void)
         {
-        static millis_t flash_time = 0;
             switch (key_value)
             {
     
@@ -2771,14 +2774,10 @@ namespace Anycubic {
                 }
               }
             }
-
-          if(millis() < (flash_time +1000) )return;
-          flash_time=millis();
         }
     
         void DgusTFT::page28_handle(void)
         {
-        static millis_t flash_time = 0;
             switch (key_value)
                 {
         
@@ -2798,15 +2797,11 @@ namespace Anycubic {
         
                 }
     
-    
-          if(millis() < (flash_time +1000) )return;
-          flash_time=millis();
         
         }
     
         void DgusTFT::page29_handle(void)
         {
-        static millis_t flash_time = 0;
             switch (key_value)
             {
               case 0:
@@ -2828,15 +2823,11 @@ namespace Anycubic {
               break;
     
             }
-
-          if(millis() < (flash_time +1000) )return;
-          flash_time=millis();
         
         }
 
         void DgusTFT::page30_handle(void)   // Auto heat filament
         {
-            static millis_t flash_time = 0;
             switch (key_value)
             {
               case 0:
@@ -2849,14 +2840,10 @@ namespace Anycubic {
               }
               break;
             }
-
-          if(millis() < (flash_time +1000) )return;
-          flash_time=millis();
         }
 
         void DgusTFT::page31_handle(void)
         {
-            static millis_t flash_time = 0;
             switch (key_value)
             {
               case 0:
@@ -2872,23 +2859,15 @@ namespace Anycubic {
               }
               break;
             }
-
-          if(millis() < (flash_time +1000) )return;
-          flash_time=millis();
         }
 
         void DgusTFT::page32_handle(void)
         {
-          static millis_t flash_time = 0;
-    
-             if(millis() < (flash_time +1000) )return;
-             flash_time=millis();
         
         }
 
         void DgusTFT::page33_handle(void)
         {
-          static millis_t flash_time = 0;
           switch (key_value)
           {
             case 0:
@@ -2916,20 +2895,11 @@ namespace Anycubic {
             }
             break;
           }
-
-          if(millis() < (flash_time +1000)){
-            return;
-          }
-          flash_time = millis();
         }
 
         void DgusTFT::page34_handle(void)
         {
           char str_buf[20];
-          static millis_t flash_time = 0;
-
-          if(millis() < (flash_time + 1500) )return;
-          flash_time=millis();
 
           if(pop_up_index==25)
           {
@@ -2941,7 +2911,6 @@ namespace Anycubic {
     
     void DgusTFT::page115_handle(void)
     {
-        static millis_t flash_time = 0;
             switch (key_value)
             {
     
@@ -2993,9 +2962,6 @@ namespace Anycubic {
             }
     
     
-        if(millis() < (flash_time +1000) )return;
-        flash_time=millis();
-    
         
     }
 
@@ -3245,24 +3211,12 @@ namespace Anycubic {
 
     void DgusTFT::page175_handle(void)     // CHS probe preheating handler
     {
-        static millis_t flash_time = 0;
         char str_buf[16];
-
-        if(millis() < (flash_time +1500) ) {
-          return;
-        }
-        flash_time=millis();
     }
 
     void DgusTFT::page176_handle(void)     // ENG probe preheating handler
     {
-        static millis_t flash_time = 0;
         char str_buf[16];
-
-        if(millis() < (flash_time +1500) ) {
-          return;
-        }
-        flash_time=millis();
     }
 
     void DgusTFT::page177_to_198_handle(void)
@@ -3428,7 +3382,6 @@ namespace Anycubic {
 
     void DgusTFT::page202_handle(void)  // probe precheck ok
     {
-        static millis_t flash_time = 0;
         static millis_t probe_check_counter = 0;
         static uint8_t probe_state_last = 0;
         char str_buf[16];
@@ -3442,15 +3395,9 @@ namespace Anycubic {
 
     void DgusTFT::page203_handle(void)    // probe precheck failed
     {
-        static millis_t flash_time = 0;
         static millis_t probe_check_counter = 0;
         static uint8_t probe_state_last = 0;
         char str_buf[16];
-
-        if(millis() < (flash_time + 1500) ) {
-            return;
-        }
-        flash_time=millis();
     }
 
     void DgusTFT::pop_up_manager(void)
@@ -375,8 +375,7 @@ namespace Anycubic {
     static float            live_Zoffset;
     static file_menu_t      file_menu;
     static bool             data_received;
-    static uint8_t          data_buf[64];
-    static uint8_t          data_index;
+    static uint8_t          data_buf[AC_RX_FRAME_MAX];
     static uint32_t         page_index_last;
     static uint32_t         page_index_last_2;
 	static uint8_t          message_index;
@@ -392,6 +391,11 @@ namespace Anycubic {
     static uint8_t          TFTStatusFlag;
     static uint8_t          TFTresumingflag;
     static uint8_t          ready;
+#if ENABLED(ANYCUBIC_DGUS_LOAD_STATS)
+    static uint32_t         load_count, load_max;
+    static uint64_t         load_total;
+    static millis_t         load_ms;
+#endif
 
     public:
       DgusTFT();
@@ -415,6 +419,14 @@ namespace Anycubic {
       void HomingComplete();
       
       typedef void (*p_fun)(void);
+
+      typedef struct {
+        uint8_t         first, last;    // Page range served
+        p_fun           handler;
+        uint16_t        refresh_ms;     // Call period without a key press, 0 for none
+        const uint16_t *vps;            // 0-terminated VPs shown on the page
+      } page_t;
+
       static void page1_handle(void);
       static void page2_handle(void);
       static void page3_handle(void);
@@ -471,7 +483,7 @@ namespace Anycubic {
       static void pop_up_manager(void);
 
       void SendtoTFT(PGM_P);
-      void SendtoTFTLN(PGM_P);
+      void SendtoTFTLN(PGM_P=nullptr);
       bool ReadTFTCommand();
       int8_t Findcmndpos(const char *, char);
       void CheckHeaters();
@@ -483,6 +495,8 @@ namespace Anycubic {
       void PanelAction(uint8_t);
       void PanelProcess(uint8_t);
 
+      static void SendFrameToTFT(const uint8_t *frame, uint8_t len, bool words=false);
+      static void SendBytesToTFT(const uint8_t *data, uint8_t len);
       static void SendValueToTFT(uint32_t value, uint32_t address);
       static void RequestValueFromTFT(uint32_t address);
       static void SendTxtToTFT(const char *pdata, uint32_t address);
@@ -492,6 +506,14 @@ namespace Anycubic {
       static void FakeChangePageOfTFT(uint32_t page_index);
       static void LcdAudioSet(ExtUI::audio_t audio);
 
+      static const page_t* FindPage(uint32_t page);
+      static void DispatchPage();
+
+#if ENABLED(ANYCUBIC_DGUS_LOAD_STATS)
+      static void ResetLoad();
+      static void ReportLoad();
+#endif
+
     private:
     
   };
@@ -55,6 +55,9 @@
 #define MAX_PATH_LEN                   16 * MAX_FOLDER_DEPTH // Maximum number of characters in a SD file path
 
 #define AC_HEATER_FAULT_VALIDATION_TIME 5    // number of 1/2 second loops before signalling a heater fault
+#define AC_RX_FRAME_MAX                64    // Longest panel frame payload accepted
+#define AC_RX_FRAME_QUEUE               4    // Panel frames held for ProcessPanelRequest
+#define AC_RX_FRAME_TIMEOUT           100    // (ms) Drop a partial panel frame after this long without a byte
 #define AC_LOWEST_MESHPOINT_VAL        Z_PROBE_LOW_POINT // The lowest value you can set for a single mesh point offset
 
  // TFT panel commands
@@ -98,6 +101,7 @@
 #define MARLIN_msg_bed_heating         PSTR("Bed Heating...")
 #define MARLIN_msg_probe_preheat_start PSTR("Probe preheat start")
 #define MARLIN_msg_probe_preheat_stop  PSTR("Probe preheat stop")
+#define MARLIN_msg_preheating         PSTR("Preheat ")
 
 
 #define MARLIN_msg_nozzle_parked       PSTR("Nozzle Parked")
@@ -841,6 +841,7 @@ namespace ExtUI {
         if (WITHIN(pos.x, 0, GRID_MAX_POINTS_X) && WITHIN(pos.y, 0, GRID_MAX_POINTS_Y)) {
           Z_VALUES(pos.x, pos.y) = zoff;
           TERN_(ABL_BILINEAR_SUBDIVISION, bed_level_virt_interpolate());
+          TERN_(ABL_BICUBIC, bed_level_bicubic_patches());
         }
       }
     #endif
@@ -1033,6 +1034,17 @@ namespace ExtUI {
     #endif
   }
 
+  // Read items ahead (e.g., the next page) while the current ones are shown
+  void FileList::prefetch(const uint16_t pos, const uint8_t n) {
+    #if ENABLED(SD_PREFETCH)
+      for (uint16_t i = pos; i < pos + n && i < count(); i++)
+        card.prefetch(SD_ORDER(i, count()));
+    #else
+      UNUSED(pos);
+      UNUSED(n);
+    #endif
+  }
+
   const char* FileList::filename() {
     return IFSD(card.longest_filename(), "");
   }
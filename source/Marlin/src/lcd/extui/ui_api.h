@@ -45,6 +45,9 @@
 #include "../../inc/MarlinConfig.h"
 #include "../marlinui.h"
 #include "../../module/probe.h"
+#if ENABLED(PRINT_ETA_ESTIMATOR)
+  #include "../../feature/print_eta.h"
+#endif
 
 namespace ExtUI {
 
@@ -143,7 +146,9 @@ namespace ExtUI {
   uint32_t getProgress_seconds_elapsed();
   void clearProgress_seconds_elapsed();
 
-  #if ENABLED(SHOW_REMAINING_TIME)
+  #if ENABLED(PRINT_ETA_ESTIMATOR)
+    inline uint32_t getProgress_seconds_remaining() { return print_eta.valid() ? print_eta.remaining() : TERN0(SHOW_REMAINING_TIME, ui.get_remaining_time()); }
+  #elif ENABLED(SHOW_REMAINING_TIME)
     inline uint32_t getProgress_seconds_remaining() { return ui.get_remaining_time(); }
   #endif
 
@@ -337,6 +342,7 @@ namespace ExtUI {
       FileList();
       void refresh();
       bool seek(const uint16_t, const bool skip_range_check = false);
+      void prefetch(const uint16_t pos, const uint8_t n);
 
       const char *longFilename();
       const char *shortFilename();
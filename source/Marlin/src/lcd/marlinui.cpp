@@ -157,6 +157,10 @@ constexpr uint8_t epps = ENCODER_PULSES_PER_STEP;
   #include "../feature/power_monitor.h"
 #endif
 
+#if ENABLED(PRINT_ETA_ESTIMATOR)
+  #include "../feature/print_eta.h"
+#endif
+
 #if HAS_ENCODER_ACTION
   volatile uint8_t MarlinUI::buttons;
   #if HAS_SLOW_BUTTONS
@@ -1536,6 +1540,9 @@ void MarlinUI::update() {
     MarlinUI::progress_t MarlinUI::_get_progress() {
       return (
         TERN0(LCD_SET_PROGRESS_MANUALLY, (progress_override & PROGRESS_MASK))
+        #if ENABLED(PRINT_ETA_ESTIMATOR)
+          ?: progress_t(print_eta.permyriad() / (100U / (PROGRESS_SCALE)))
+        #endif
         #if ENABLED(SDSUPPORT)
           ?: TERN(HAS_PRINT_PROGRESS_PERMYRIAD, card.permyriadDone(), card.percentDone())
         #endif
@@ -23,4 +23,11 @@
 
 #include <stdint.h>
 
+// CRC-16/XMODEM (poly 0x1021, MSB first) of a block, continuing from *crc
 void crc16(uint16_t *crc, const void * const data, uint16_t cnt);
+
+// Table-driven CRC, for HALs without a CRC unit
+uint16_t crc16_sw(uint16_t crc, const uint8_t *data, uint32_t cnt);
+
+// The table unless the HAL defines its own
+uint16_t HAL_crc16(uint16_t crc, const uint8_t *data, uint32_t cnt);
@@ -188,6 +188,13 @@ xyz_pos_t cartes;
   feedRate_t xy_probe_feedrate_mm_s = MMM_TO_MMS(XY_PROBE_SPEED);
 #endif
 
+#if ENABLED(SENSORLESS_FAST_HOMING)
+  // Set by M915 C or M915 X Y. Saved to EEPROM.
+  xy_float_t stall_offset = { NAN, NAN };
+  uint8_t stall_sample_count; // = 0
+  stall_stats_t stall_stats[XY];
+#endif
+
 /**
  * Output the current position to serial
  */
@@ -1372,6 +1379,49 @@ void do_homing_move(const AxisEnum axis, const float distance, const feedRate_t
   }
 }
 
+#if ENABLED(SENSORLESS_FAST_HOMING)
+
+  /**
+   * Back off from the endstop, approach it again at the given feedrate
+   * and return where the stall stopped the axis, in the current frame.
+   */
+  static float stall_position(const AxisEnum axis, const float away, const feedRate_t fr_mm_s) {
+    const int axis_home_dir = home_dir(axis);
+    current_position[axis] -= away * axis_home_dir;
+    line_to_current_position(homing_feedrate(axis));
+    planner.synchronize();
+    const float start = current_position[axis];
+    do_homing_move(axis, 1.5f * max_length(axis) * axis_home_dir, fr_mm_s);
+    current_position[axis] = start + planner.get_axis_position_mm(axis);
+    sync_plan_position();
+    return current_position[axis];
+  }
+
+  /**
+   * For M915, after the normal home: pair each fast single approach with
+   * the bumped approach that follows it. Both stall on the same stop, so
+   * their difference is the offset fast homing has to take off.
+   */
+  static void sample_stalls(const AxisEnum axis) {
+    current_position[axis] = planner.get_axis_position_mm(axis);
+    sync_plan_position();
+
+    const float bump = home_bump_mm(axis);
+    stall_stats_t &stats = stall_stats[axis];
+    stats.reset();
+    LOOP_L_N(i, stall_sample_count) {
+      // Start from a different distance, and so a different step phase, each time
+      const float away = (SENSORLESS_FAST_HOMING_TRAVEL) * (1.0f + random(0, 100) * 0.01f),
+                  fast = stall_position(axis, away, MMM_TO_MMS(fast_homing_mm_m[axis])),
+                  slow = bump ? stall_position(axis, bump, get_homing_bump_feedrate(axis))
+                              : stall_position(axis, away, homing_feedrate(axis));
+      stats.add(fast - slow);
+      if (DEBUGGING(LEVELING)) DEBUG_ECHOLNPAIR("Stall ", i + 1, ": ", fast - slow);
+    }
+  }
+
+#endif
+
 /**
  * Set an axis' current position to its home position (after homing).
  *
@@ -1611,10 +1661,13 @@ void homeaxis(const AxisEnum axis) {
     }
   #endif
 
+  // A calibrated sensorless axis homes in a single fast approach
+  const bool fast_home = TERN0(SENSORLESS_FAST_HOMING, stall_calibrated(axis));
+
   // Determine if a homing bump will be done and the bumps distance
   // When homing Z with probe respect probe clearance
   const bool use_probe_bump = TERN0(HOMING_Z_WITH_PROBE, axis == Z_AXIS && home_bump_mm(Z_AXIS));
-  const float bump = axis_home_dir * (
+  const float bump = fast_home ? 0 : axis_home_dir * (
     use_probe_bump ? _MAX(TERN0(HOMING_Z_WITH_PROBE, Z_CLEARANCE_BETWEEN_PROBES), home_bump_mm(Z_AXIS)) : home_bump_mm(axis)
   );
 
@@ -1623,7 +1676,7 @@ void homeaxis(const AxisEnum axis) {
   //
   const float move_length = 1.5f * max_length(TERN(DELTA, Z_AXIS, axis)) * axis_home_dir;
   if (DEBUGGING(LEVELING)) DEBUG_ECHOLNPAIR("Home Fast: ", move_length, "mm");
-  do_homing_move(axis, move_length, 0.0, !use_probe_bump);
+  do_homing_move(axis, move_length, TERN0(SENSORLESS_FAST_HOMING, fast_home ? MMM_TO_MMS(fast_homing_mm_m[axis]) : 0.0f), !use_probe_bump);
 
   #if BOTH(HOMING_Z_WITH_PROBE, BLTOUCH_SLOW_MODE)
     if (axis == Z_AXIS) bltouch.stow(); // Intermediate STOW (in LOW SPEED MODE)
@@ -1664,6 +1717,12 @@ void homeaxis(const AxisEnum axis) {
     #endif
   }
 
+  #if ENABLED(SENSORLESS_FAST_HOMING)
+    // M915 measures the fast stall against this home
+    if (stall_sample_count && !fast_home && (TERN0(X_SENSORLESS, axis == X_AXIS) || TERN0(Y_SENSORLESS, axis == Y_AXIS)))
+      sample_stalls(axis);
+  #endif
+
   #if HAS_EXTRA_ENDSTOPS
     const bool pos_dir = axis_home_dir > 0;
     #if ENABLED(X_DUAL_ENDSTOPS)
@@ -1826,6 +1885,13 @@ void homeaxis(const AxisEnum axis) {
   #else // CARTESIAN / CORE / MARKFORGED_XY
 
     set_axis_is_at_home(axis);
+    #if ENABLED(SENSORLESS_FAST_HOMING)
+      // The fast stall stopped the count short of or past the bumped home
+      if (fast_home) {
+        current_position[axis] += stall_offset[axis];
+        if (DEBUGGING(LEVELING)) DEBUG_ECHOLNPAIR("Stall offset: ", stall_offset[axis]);
+      }
+    #endif
     sync_plan_position();
 
     destination[axis] = current_position[axis];
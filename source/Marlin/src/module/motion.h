@@ -461,3 +461,31 @@ FORCE_INLINE void set_all_unhomed()                       { axis_homed = axis_tr
   sensorless_t start_sensorless_homing_per_axis(const AxisEnum axis);
   void end_sensorless_homing_per_axis(const AxisEnum axis, sensorless_t enable_stealth);
 #endif
+
+#if ENABLED(SENSORLESS_FAST_HOMING)
+  constexpr xy_feedrate_t fast_homing_mm_m = SENSORLESS_FAST_HOMING_FEEDRATE_MM_M;
+
+  // Fast stall position minus the bumped home. NAN until calibrated.
+  extern xy_float_t stall_offset;
+
+  FORCE_INLINE bool stall_calibrated(const AxisEnum axis) {
+    return (TERN0(X_SENSORLESS, axis == X_AXIS) || TERN0(Y_SENSORLESS, axis == Y_AXIS)) && !isnan(stall_offset[axis]);
+  }
+
+  // Fast stall minus the following bumped stall, over M915's approaches
+  typedef struct {
+    uint8_t n;
+    float mean, m2, min, max;
+    void reset() { n = 0; mean = m2 = 0; min = 99999; max = -99999; }
+    void add(const float d) {
+      const float delta = d - mean;
+      mean += delta / ++n;
+      m2 += delta * (d - mean);
+      NOMORE(min, d); NOLESS(max, d);
+    }
+    float sigma() const { return n ? SQRT(m2 / n) : 0; }
+  } stall_stats_t;
+
+  extern uint8_t stall_sample_count;  // Set by M915 for one G28, else 0
+  extern stall_stats_t stall_stats[XY];
+#endif
@@ -220,7 +220,7 @@ typedef struct block_t {
     uint8_t valve_pressure, e_to_p_pressure;
   #endif
 
-  #if HAS_WIRED_LCD
+  #if HAS_BLOCK_RUNTIME
     uint32_t segment_time_us;
   #endif
 
@@ -444,7 +444,7 @@ class Planner {
       static last_move_t g_uc_extruder_last_move[EXTRUDERS];
     #endif
 
-    #if HAS_WIRED_LCD
+    #if HAS_BLOCK_RUNTIME
       volatile static uint32_t block_buffer_runtime_us; // Theoretical block buffer runtime in µs
     #endif
 
@@ -877,7 +877,7 @@ class Planner {
         block_buffer_tail = next_block_index(block_buffer_tail);
     }
 
-    #if HAS_WIRED_LCD
+    #if HAS_BLOCK_RUNTIME
       static uint16_t block_buffer_runtime();
       static void clear_block_buffer_runtime();
     #endif
@@ -48,7 +48,7 @@
   #include "delta.h"
 #endif
 
-#if ENABLED(BABYSTEP_ZPROBE_OFFSET)
+#if ANY(BABYSTEP_ZPROBE_OFFSET, G29_FAST_PROBING, G29_SWEEP_PROBING)
   #include "planner.h"
 #endif
 
@@ -96,6 +96,11 @@ xy_pos_t Probe::default_probe_xy_offset = { default_probe_xyz_offset.x,default_p
   const xy_pos_t &Probe::offset_xy = Probe::offset;
 #endif
 
+#if ENABLED(Z_MIN_PROBE_REPEATABILITY_TEST)
+  float Probe::speed_scale = 1,
+        Probe::trigger_latency = NAN;
+#endif
+
 #if ENABLED(Z_PROBE_SLED)
 
   #ifndef SLED_DOCKING_OFFSET
@@ -446,6 +451,18 @@ bool Probe::set_deployed(const bool deploy) {
  * @return true to indicate an error
  */
 
+#ifdef NOZZLE_AS_PROBE
+  /**
+   * @brief Zero the nozzle probe's strain gauge, with the nozzle clear of the bed and still
+   */
+  static void nozzle_tare() {
+    OUT_WRITE(AUTO_LEVEL_TX_PIN, LOW);
+    delay(300);
+    OUT_WRITE(AUTO_LEVEL_TX_PIN, HIGH);
+    delay(100);
+  }
+#endif
+
 /**
  * @brief Move down until the probe triggers or the low limit is reached
  *
@@ -460,10 +477,7 @@ bool Probe::probe_down_to_z(const float z, const feedRate_t fr_mm_s) {
   DEBUG_SECTION(log_probe, "Probe::probe_down_to_z", DEBUGGING(LEVELING));
 
 #ifdef NOZZLE_AS_PROBE
-	OUT_WRITE(AUTO_LEVEL_TX_PIN, LOW);
-	delay(300);
-	OUT_WRITE(AUTO_LEVEL_TX_PIN, HIGH);
-	delay(100);
+  nozzle_tare();
 #endif
 
   #if BOTH(HAS_HEATED_BED, WAIT_FOR_BED_HEATER)
@@ -526,21 +540,46 @@ bool Probe::probe_down_to_z(const float z, const feedRate_t fr_mm_s) {
 
 #if ENABLED(PROBE_TARE)
 
+  bool Probe::tare_held;        // The tare pin is asserted
+  millis_t Probe::tare_began,   // When it was asserted
+           Probe::tare_ms;
+
   /**
    * @brief Init the tare pin
    *
-   * @details Init tare pin to ON state for a strain gauge, otherwise OFF
+   * @details Init tare pin to ON state for a strain gauge, otherwise OFF.
+   *          Also ends a tare left unfinished by a failed probe.
    */
   void Probe::tare_init() {
     OUT_WRITE(PROBE_TARE_PIN, !PROBE_TARE_STATE);
+    tare_held = false;
+  }
+
+  /**
+   * @brief Begin taring the Z probe
+   *
+   * @details Assert the tare pin ahead of the moves to the next touch, so
+   *          the pulse runs while they do. tare() ends it once they're done.
+   */
+  void Probe::tare_start() {
+    if (tare_held) return;
+    #if BOTH(PROBE_ACTIVATION_SWITCH, PROBE_TARE_ONLY_WHILE_INACTIVE)
+      if (endstops.probe_switch_activated()) return;  // tare() will report it
+    #endif
+    WRITE(PROBE_TARE_PIN, PROBE_TARE_STATE);
+    tare_began = millis();
+    tare_held = true;
   }
 
   /**
    * @brief Tare the Z probe
    *
-   * @details Signal to the probe to tare itself
+   * @details Signal to the probe to tare itself. The pin is held for at least
+   *          PROBE_TARE_TIME, counted from tare_start(). After release the probe
+   *          is ready once its output stays untriggered for PROBE_TARE_SETTLE,
+   *          which must happen within PROBE_TARE_DELAY.
    *
-   * @return TRUE if the tare cold not be completed
+   * @return TRUE if the tare could not be completed
    */
   bool Probe::tare() {
     #if BOTH(PROBE_ACTIVATION_SWITCH, PROBE_TARE_ONLY_WHILE_INACTIVE)
@@ -550,11 +589,31 @@ bool Probe::probe_down_to_z(const float z, const feedRate_t fr_mm_s) {
       }
     #endif
 
-    SERIAL_ECHOLNPGM("Taring probe");
-    WRITE(PROBE_TARE_PIN, PROBE_TARE_STATE);
-    delay(PROBE_TARE_TIME);
+    const millis_t entered = millis();
+    tare_start();
+    const millis_t release = tare_began + PROBE_TARE_TIME;
+    while (PENDING(millis(), release)) idle();
     WRITE(PROBE_TARE_PIN, !PROBE_TARE_STATE);
-    delay(PROBE_TARE_DELAY);
+    tare_held = false;
+
+    const millis_t released = millis();
+    millis_t quiet_since = released;
+    bool ready;
+    for (;;) {
+      const millis_t ms = millis();
+      if (PROBE_TRIGGERED()) quiet_since = ms;
+      if ((ready = ELAPSED(ms, quiet_since + (PROBE_TARE_SETTLE))) || ELAPSED(ms, released + (PROBE_TARE_DELAY))) break;
+      idle();
+    }
+
+    const millis_t waited = millis() - entered;
+    tare_ms += waited;
+    if (DEBUGGING(LEVELING)) DEBUG_ECHOLNPAIR("Tare wait:", waited, "ms settle:", millis() - released, "ms");
+
+    if (!ready) {
+      SERIAL_ECHOLNPGM("Probe not ready after tare");
+      return true;
+    }
 
     endstops.hit_on_purpose();
     return false;
@@ -566,11 +625,23 @@ bool Probe::probe_down_to_z(const float z, const feedRate_t fr_mm_s) {
  *
  * @details Used by probe_at_point to get the bed Z height at the current XY.
  *          Leaves current_position.z at the height where the probe triggered.
+ *          With G29_FAST_AGREE a fast touch landing within that distance
+ *          of predicted_z is taken as the result, without the slow touch.
  *
  * @return The Z position of the bed at the current XY or NAN on error.
  */
-float Probe::run_z_probe(const bool sanity_check/*=true*/) {
+float Probe::run_z_probe(const bool sanity_check/*=true*/, const float predicted_z/*=NAN*/) {
   DEBUG_SECTION(log_probe, "Probe::run_z_probe", DEBUGGING(LEVELING));
+
+  #if ENABLED(Z_MIN_PROBE_REPEATABILITY_TEST)
+    const feedRate_t fast_fr = z_probe_fast_mm_s * speed_scale,
+                     slow_fr = MMM_TO_MMS(Z_PROBE_SPEED_SLOW) * speed_scale;
+    trigger_latency = NAN;
+  #else
+    constexpr feedRate_t fast_fr = z_probe_fast_mm_s,
+                         slow_fr = MMM_TO_MMS(Z_PROBE_SPEED_SLOW);
+  #endif
+
   auto try_to_probe = [&](PGM_P const plbl, const float &z_probe_low_point, const feedRate_t fr_mm_s, const bool scheck, const float clearance) -> bool {
     // Tare the probe, if supported
     if (TERN0(PROBE_TARE, tare())) return true;
@@ -598,18 +669,38 @@ float Probe::run_z_probe(const bool sanity_check/*=true*/) {
 
   // Double-probing does a fast probe followed by a slow probe
   #if TOTAL_PROBING == 2
-    // Attempt to tare the probe
-    if (TERN0(PROBE_TARE, tare())) return NAN;
+    TERN_(G29_FAST_PROBING, millis_t phase_ms = millis());
 
     // Do a first probe at the fast speed
-    if (try_to_probe(PSTR("FAST"), z_probe_low_point, z_probe_fast_mm_s,
+    if (try_to_probe(PSTR("FAST"), z_probe_low_point, fast_fr,
                      sanity_check, Z_CLEARANCE_BETWEEN_PROBES) ) return NAN;
 
     const float first_probe_z = current_position.z;
 
     if (DEBUGGING(LEVELING)) DEBUG_ECHOLNPAIR("1st Probe Z:", first_probe_z);
 
-    // Raise to give the probe clearance
+    #if ENABLED(G29_FAST_PROBING)
+      fast_times.fast += millis() - phase_ms;
+      phase_ms = millis();
+
+      #ifdef G29_FAST_AGREE
+        // Once the fast touch bias is known, a fast touch that lands on the
+        // prediction from flat neighbors needs no slow touch to confirm it
+        if (!isnan(predicted_z) && fast_bias_n >= 2) {
+          const float z = first_probe_z + fast_bias;
+          if (ABS(z + offset.z - predicted_z) <= G29_FAST_AGREE) {
+            if (DEBUGGING(LEVELING)) DEBUG_ECHOLNPAIR("Fast Z agrees with ", predicted_z);
+            fast_times.skipped++;
+            return z;
+          }
+        }
+      #else
+        UNUSED(predicted_z);
+      #endif
+    #endif
+
+    // Raise to give the probe clearance, taring on the way up
+    TERN_(PROBE_TARE, tare_start());
     do_blocking_move_to_z(current_position.z + Z_CLEARANCE_MULTI_PROBE, z_probe_fast_mm_s);
 
   #elif Z_PROBE_SPEED_FAST != Z_PROBE_SPEED_SLOW
@@ -639,11 +730,8 @@ float Probe::run_z_probe(const bool sanity_check/*=true*/) {
     )
   #endif
     {
-      // If the probe won't tare, return
-      if (TERN0(PROBE_TARE, tare())) return true;
-
       // Probe downward slowly to find the bed
-      if (try_to_probe(PSTR("SLOW"), z_probe_low_point, MMM_TO_MMS(Z_PROBE_SPEED_SLOW),
+      if (try_to_probe(PSTR("SLOW"), z_probe_low_point, slow_fr,
                        sanity_check, Z_CLEARANCE_MULTI_PROBE) ) return NAN;
 
       TERN_(MEASURE_BACKLASH_WHEN_PROBING, backlash.measure_with_probe());
@@ -671,7 +759,10 @@ float Probe::run_z_probe(const bool sanity_check/*=true*/) {
           #if EXTRA_PROBING > 0
             < TOTAL_PROBING - 1
           #endif
-        ) do_blocking_move_to_z(z + Z_CLEARANCE_MULTI_PROBE, z_probe_fast_mm_s);
+        ) {
+          TERN_(PROBE_TARE, tare_start());
+          do_blocking_move_to_z(z + Z_CLEARANCE_MULTI_PROBE, z_probe_fast_mm_s);
+        }
       #endif
     }
 
@@ -703,9 +794,23 @@ float Probe::run_z_probe(const bool sanity_check/*=true*/) {
 
     if (DEBUGGING(LEVELING)) DEBUG_ECHOLNPAIR("2nd Probe Z:", z2, " Discrepancy:", first_probe_z - z2);
 
+    // A late trigger lets the faster touch go deeper by its speed times the delay
+    #if ENABLED(Z_MIN_PROBE_REPEATABILITY_TEST)
+      if (fast_fr > slow_fr) trigger_latency = (z2 - first_probe_z) / (fast_fr - slow_fr);
+    #endif
+
     // Return a weighted average of the fast and slow probes
     const float measured_z = (z2 * 3.0f + first_probe_z * 2.0f) * 0.2f;
 
+    #if ENABLED(G29_FAST_PROBING)
+      fast_times.slow += millis() - phase_ms;
+      #ifdef G29_FAST_AGREE
+        // Learn where the fast touch lands relative to the full result
+        fast_bias = (fast_bias * fast_bias_n + measured_z - first_probe_z) / (fast_bias_n + 1);
+        if (fast_bias_n < 255) fast_bias_n++;
+      #endif
+    #endif
+
   #else
 
     // Return the single probe result
@@ -753,7 +858,11 @@ float Probe::probe_at_point(const float &rx, const float &ry, const ProbePtRaise
   }
   else if (!position_is_reachable(npos)) return NAN;        // The given position is in terms of the nozzle
 
-  // Move the probe to the starting XYZ
+  // Move the probe to the starting XYZ, taring on the way
+  #if ENABLED(PROBE_TARE)
+    tare_ms = 0;
+    tare_start();
+  #endif
   do_blocking_move_to(npos, feedRate_t(XY_PROBE_FEEDRATE_MM_S));
 
   float measured_z = NAN;
@@ -765,11 +874,17 @@ float Probe::probe_at_point(const float &rx, const float &ry, const ProbePtRaise
     else if (raise_after == PROBE_PT_STOW)
       if (stow()) measured_z = NAN;   // Error on stow?
 
-    if (verbose_level > 2)
-      SERIAL_ECHOLNPAIR("Bed X: ", LOGICAL_X_POSITION(rx), " Y: ", LOGICAL_Y_POSITION(ry), " Z: ", measured_z);
+    if (verbose_level > 2) {
+      SERIAL_ECHOPAIR("Bed X: ", LOGICAL_X_POSITION(rx), " Y: ", LOGICAL_Y_POSITION(ry), " Z: ", measured_z);
+      #if ENABLED(PROBE_TARE)
+        SERIAL_ECHOPAIR(" Tare: ", tare_ms, "ms");
+      #endif
+      SERIAL_EOL();
+    }
   }
 
   if (isnan(measured_z)) {
+    TERN_(PROBE_TARE, tare_init());   // Release a tare left held
     stow();
     LCD_MESSAGEPGM(MSG_LCD_PROBING_FAILED);
     #if DISABLED(G29_RETRY_AND_RECOVER)
@@ -781,6 +896,249 @@ float Probe::probe_at_point(const float &rx, const float &ry, const ProbePtRaise
   return measured_z;
 }
 
+#if ENABLED(G29_FAST_PROBING)
+
+  Probe::fast_times_t Probe::fast_times;
+  #ifdef G29_FAST_AGREE
+    float Probe::fast_bias;
+    uint8_t Probe::fast_bias_n;
+  #endif
+
+  /**
+   * @brief Start a G29 sequence with fresh timings and fast touch bias
+   */
+  void Probe::fast_begin() {
+    fast_times = { 0 };
+    #ifdef G29_FAST_AGREE
+      fast_bias = 0;
+      fast_bias_n = 0;
+    #endif
+  }
+
+  /**
+   * @brief Travel from the last touch to the given XY and probe there
+   *
+   * @details For the G29 sequencer. A short lift and the move to the next XY
+   *          are planned together, so the nozzle reaches travel height on the
+   *          way. The nozzle is left at the touch for the next point.
+   *
+   * @param  predicted_z  Bed Z expected here, or NAN
+   * @param  travel       Travel height. PROBE_TRAVEL_LOW needs predicted_z.
+   * @return The probed Z position or NAN on error
+   */
+  float Probe::probe_at_point_fast(const xy_pos_t &pos, const float predicted_z, const ProbeTravel travel, const uint8_t verbose_level/*=0*/) {
+    DEBUG_SECTION(log_probe, "Probe::probe_at_point_fast", DEBUGGING(LEVELING));
+
+    float measured_z = NAN;
+
+    if (can_reach(pos)) {
+      const xy_pos_t npos = pos - offset_xy;
+      const millis_t ms = millis();
+
+      #if ENABLED(PROBE_TARE)
+        tare_ms = 0;
+        tare_start();
+      #endif
+
+      if (travel != PROBE_TRAVEL_FIRST) {
+        const bool low = travel == PROBE_TRAVEL_LOW;
+        const float travel_z = low ? predicted_z - offset.z + G29_FAST_CLEARANCE
+                                   : current_position.z + Z_CLEARANCE_BETWEEN_PROBES;
+        if (low) fast_times.low++;
+        current_position.z += G29_FAST_CLEARANCE;
+        line_to_current_position(z_probe_fast_mm_s);
+        current_position.set(npos.x, npos.y, travel_z);
+        line_to_current_position(XY_PROBE_FEEDRATE_MM_S);
+        planner.synchronize();
+      }
+      else
+        do_blocking_move_to(npos, feedRate_t(XY_PROBE_FEEDRATE_MM_S));
+
+      fast_times.travel += millis() - ms;
+
+      if (!deploy()) measured_z = run_z_probe(true, predicted_z) + offset.z;
+      TERN_(PROBE_TARE, fast_times.tare += tare_ms);
+      fast_times.points++;
+    }
+
+    if (isnan(measured_z)) {
+      TERN_(PROBE_TARE, tare_init());
+      stow();
+      LCD_MESSAGEPGM(MSG_LCD_PROBING_FAILED);
+      #if DISABLED(G29_RETRY_AND_RECOVER)
+        status = -1;
+        SERIAL_ERROR_MSG(STR_ERR_PROBING_FAILED);
+      #endif
+    }
+    else if (verbose_level > 2)
+      SERIAL_ECHOLNPAIR("Bed X: ", LOGICAL_X_POSITION(pos.x), " Y: ", LOGICAL_Y_POSITION(pos.y), " Z: ", measured_z);
+
+    return measured_z;
+  }
+
+  /**
+   * @brief End a G29 sequence, raising off the last touch, and report timings
+   */
+  void Probe::fast_end(const bool ok) {
+    if (!ok) return;
+    do_blocking_move_to_z(current_position.z + Z_CLEARANCE_BETWEEN_PROBES, z_probe_fast_mm_s);
+    SERIAL_ECHOPAIR("Probe times (ms) travel:", fast_times.travel, " fast:", fast_times.fast, " slow:", fast_times.slow);
+    #if ENABLED(PROBE_TARE)
+      SERIAL_ECHOPAIR(" tare:", fast_times.tare);
+    #endif
+    SERIAL_ECHOPAIR(" points:", fast_times.points, " low:", fast_times.low);
+    #ifdef G29_FAST_AGREE
+      SERIAL_ECHOPAIR(" skipped:", fast_times.skipped);
+    #endif
+    SERIAL_EOL();
+  }
+
+#endif // G29_FAST_PROBING
+
+#if ENABLED(G29_SWEEP_PROBING)
+
+  /**
+   * @brief Sweep the probe over the bed in a serpentine, touching down on the move
+   *
+   * @details Rows run along X from lf to rb. Each touch is a diagonal move,
+   *          falling at the fast probing speed while going on along the row,
+   *          that the probe trigger ends. The steppers stop where it fired,
+   *          which gives the sample. A diagonal lift to G29_SWEEP_LIFT over
+   *          the touch then carries on to the next one. A touch that finds
+   *          no bed within G29_SWEEP_DEPTH, or fires before moving, is done
+   *          again as a regular vertical probe. The sweep starts with a
+   *          regular probe and a fast touch on the same spot, and moves the
+   *          fast touches by the difference. A nozzle probe is tared again
+   *          at the start of each row, as probe_down_to_z() does before
+   *          every regular touch, so its gauge drifts over one row at most.
+   *
+   * @param lf,rb         Probe bounds of the sweep
+   * @param samples       Probe XYZ of each touch
+   * @param max_samples   Room in samples
+   * @param verbose_level Print each touch at 3 and above
+   *
+   * @return The number of samples, or 0 if probing failed
+   */
+  uint16_t Probe::sweep(const xy_pos_t &lf, const xy_pos_t &rb, xyz_pos_t samples[], const uint16_t max_samples, const uint8_t verbose_level/*=0*/) {
+    DEBUG_SECTION(log_probe, "Probe::sweep", DEBUGGING(LEVELING));
+
+    const millis_t ms = millis();
+    const feedRate_t vz = z_probe_fast_mm_s;
+    uint16_t n = 0, touches = 0, dropped = 0;
+    uint8_t refound = 0;
+
+    auto failed = [&]{
+      LCD_MESSAGEPGM(MSG_LCD_PROBING_FAILED);
+      #if DISABLED(G29_RETRY_AND_RECOVER)
+        status = -1;
+        SERIAL_ERROR_MSG(STR_ERR_PROBING_FAILED);
+      #endif
+      return 0;
+    };
+
+    // Keep a touch, or count it if there's no room
+    auto keep = [&](const float z) {
+      touches++;
+      if (n < max_samples)
+        samples[n++].set(current_position.x + offset_xy.x, current_position.y + offset_xy.y, z);
+      else
+        dropped++;
+      if (verbose_level > 2)
+        SERIAL_ECHOLNPAIR("Bed X: ", LOGICAL_X_POSITION(current_position.x + offset_xy.x), " Y: ", LOGICAL_Y_POSITION(current_position.y + offset_xy.y), " Z: ", z);
+    };
+
+    // Regular probe at the front left, then a fast touch there to find the
+    // difference. Fast touches land a little deeper.
+    const float z = probe_at_point(lf, PROBE_PT_NONE, verbose_level);
+    if (isnan(z)) return 0;
+    do_blocking_move_to_z(current_position.z + G29_SWEEP_LIFT, vz);
+    if (probe_down_to_z(current_position.z - (G29_SWEEP_LIFT) - (G29_SWEEP_DEPTH), vz)) return failed();
+    float touch_z = current_position.z;   // Nozzle Z of the last touch
+    const float bias = z - (touch_z + offset.z);
+    keep(z);
+
+    LOOP_L_N(r, G29_SWEEP_ROWS) {
+      const float dir = (r & 1) ? -1 : 1,
+                  end_x = ((r & 1) ? lf.x : rb.x) - offset_xy.x;
+
+      if (r) {
+        // Step over to the next row clear of the bed
+        TERN_(PROBE_TARE, tare_start());
+        current_position.z = touch_z + Z_CLEARANCE_BETWEEN_PROBES;
+        line_to_current_position(vz);
+        current_position.y = lf.y + (rb.y - lf.y) * r / (G29_SWEEP_ROWS - 1) - offset_xy.y;
+        line_to_current_position(XY_PROBE_FEEDRATE_MM_S);
+        #if ENABLED(PROBE_TARE)
+          planner.synchronize();
+          if (tare()) return failed();
+        #endif
+        #ifdef NOZZLE_AS_PROBE
+          planner.synchronize();
+          nozzle_tare();
+        #endif
+      }
+
+      for (bool touched = !r;;) {
+        float left = (end_x - current_position.x) * dir;
+
+        if (touched) {
+          if (left < 0.1f) break;           // At the end of the row
+          // Lift off the touch, going on along the row at the sweep speed.
+          // Two halves, so with the fall the planner has the 3 blocks it
+          // starts on at once, rather than after BLOCK_DELAY_FOR_1ST_MOVE.
+          const float dx = _MIN(left, _MAX(0.0f, float(G29_SWEEP_SPACING) - (G29_SWEEP_LIFT) * (G29_SWEEP_FEEDRATE) / vz)),
+                      dz = touch_z + (G29_SWEEP_LIFT) - current_position.z;
+          const feedRate_t fr = dx ? (G29_SWEEP_FEEDRATE) * HYPOT(dx, dz) / dx : vz;
+          LOOP_L_N(h, 2) {
+            current_position.x += dir * dx / 2;
+            current_position.z += dz / 2;
+            line_to_current_position(fr);
+          }
+          left -= dx;
+        }
+
+        // Fall at the probing speed, keeping the XY speed when hovering low
+        const float start_z = current_position.z,
+                    drop = start_z - (touch_z - (G29_SWEEP_DEPTH)),
+                    dx = start_z <= touch_z + (G29_SWEEP_LIFT) + 0.01f ? _MIN(left, drop * (G29_SWEEP_FEEDRATE) / vz) : 0;
+        current_position.x += dir * dx;
+        current_position.z -= drop;
+        TERN_(HAS_QUIET_PROBING, set_probing_paused(true));
+        line_to_current_position(vz * HYPOT(dx, drop) / drop);
+        planner.synchronize();
+        TERN_(HAS_QUIET_PROBING, set_probing_paused(false));
+
+        const bool triggered = TEST(endstops.trigger_state(), TERN(Z_MIN_PROBE_USES_Z_MIN_ENDSTOP_PIN, Z_MIN, Z_MIN_PROBE));
+        endstops.hit_on_purpose();
+
+        // Take XYZ where the steppers stopped and tell the planner
+        set_current_from_steppers_for_axis(ALL_AXES);
+        sync_plan_position();
+
+        float sample_z = current_position.z + offset.z + bias;
+        if (!triggered || current_position.z > start_z - 0.01f) {
+          // No bed in reach, or the probe was still set. Probe straight down.
+          if (triggered) do_blocking_move_to_z(current_position.z + Z_CLEARANCE_BETWEEN_PROBES, vz);
+          sample_z = run_z_probe() + offset.z;
+          if (isnan(sample_z)) return failed();
+          refound++;
+        }
+
+        touch_z = current_position.z;
+        keep(sample_z);
+        touched = true;
+        idle_no_sleep();
+      }
+    }
+
+    do_blocking_move_to_z(current_position.z + Z_CLEARANCE_BETWEEN_PROBES, vz);
+
+    SERIAL_ECHOLNPAIR("Sweep touches:", touches, " vertical:", refound, " dropped:", dropped, " bias:", bias, " time:", millis() - ms, "ms");
+    return n;
+  }
+
+#endif // G29_SWEEP_PROBING
+
 #if HAS_Z_SERVO_PROBE
 
   void Probe::servo_probe_init() {
@@ -36,6 +36,13 @@
     PROBE_PT_RAISE,     // Raise to "between" clearance after run_z_probe
     PROBE_PT_BIG_RAISE  // Raise to big clearance after run_z_probe
   };
+  #if ENABLED(G29_FAST_PROBING)
+    enum ProbeTravel : uint8_t {
+      PROBE_TRAVEL_FIRST, // Travel at the current Z
+      PROBE_TRAVEL_HIGH,  // Lift off the last touch to Z_CLEARANCE_BETWEEN_PROBES
+      PROBE_TRAVEL_LOW    // Lift off the last touch, travel G29_FAST_CLEARANCE over the prediction
+    };
+  #endif
 #endif
 
 #if HAS_CUSTOM_PROBE_PIN
@@ -103,6 +110,30 @@ public:
       return probe_at_point(pos.x, pos.y, raise_after, verbose_level, probe_relative, sanity_check);
     }
 
+    #if ENABLED(G29_FAST_PROBING)
+      typedef struct {
+        millis_t travel, fast, slow;        // Time spent in each phase
+        #if ENABLED(PROBE_TARE)
+          millis_t tare;
+        #endif
+        uint8_t points, low, skipped;       // Points, low travels, slow touches skipped
+      } fast_times_t;
+      static fast_times_t fast_times;
+
+      static void fast_begin();
+      static float probe_at_point_fast(const xy_pos_t &pos, const float predicted_z, const ProbeTravel travel, const uint8_t verbose_level=0);
+      static void fast_end(const bool ok);
+    #endif
+
+    #if ENABLED(Z_MIN_PROBE_REPEATABILITY_TEST)
+      static float speed_scale;         // M48 speed sweep: factor on both touch feedrates
+      static float trigger_latency;     // (s) From the last fast/slow touch pair. NAN if none.
+    #endif
+
+    #if ENABLED(G29_SWEEP_PROBING)
+      static uint16_t sweep(const xy_pos_t &lf, const xy_pos_t &rb, xyz_pos_t samples[], const uint16_t max_samples, const uint8_t verbose_level=0);
+    #endif
+
   #else
 
     static const xyz_pos_t &offset; // See #16767
@@ -245,14 +276,26 @@ public:
   #endif
 
   #if ENABLED(PROBE_TARE)
+    static millis_t tare_ms;            // Time spent waiting on tare at the last point
     static void tare_init();
+    static void tare_start();
     static bool tare();
   #endif
 
 private:
+  #if ENABLED(PROBE_TARE)
+    static bool tare_held;
+    static millis_t tare_began;
+  #endif
+
+  #if ENABLED(G29_FAST_PROBING) && defined(G29_FAST_AGREE)
+    static float fast_bias;             // Mean of (full result - fast touch)
+    static uint8_t fast_bias_n;
+  #endif
+
   static bool probe_down_to_z(const float z, const feedRate_t fr_mm_s);
   static void do_z_raise(const float z_raise);
-  static float run_z_probe(const bool sanity_check=true);
+  static float run_z_probe(const bool sanity_check=true, const float predicted_z=NAN);
 };
 
 extern Probe probe;
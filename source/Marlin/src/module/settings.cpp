@@ -36,7 +36,7 @@
  */
 
 // Change EEPROM version if the structure changes
-#define EEPROM_VERSION "V82"
+#define EEPROM_VERSION "V83"
 #define EEPROM_OFFSET 100
 
 // Check the integrity of data offsets.
@@ -133,6 +133,10 @@
   void M710_report(const bool forReplay);
 #endif
 
+#if ENABLED(SENSORLESS_FAST_HOMING)
+  void M915_report(const bool eeprom);
+#endif
+
 #if ENABLED(CASE_LIGHT_ENABLE)
   #include "../feature/caselight.h"
 #endif
@@ -366,6 +370,9 @@ typedef struct SettingsDataStruct {
   tmc_stepper_current_t tmc_stepper_current;            // M906 X Y Z X2 Y2 Z2 Z3 Z4 E0 E1 E2 E3 E4 E5
   tmc_hybrid_threshold_t tmc_hybrid_threshold;          // M913 X Y Z X2 Y2 Z2 Z3 Z4 E0 E1 E2 E3 E4 E5
   tmc_sgt_t tmc_sgt;                                    // M914 X Y Z X2 Y2 Z2 Z3 Z4
+  #if ENABLED(SENSORLESS_FAST_HOMING)
+    xy_float_t stall_offset;                            // M915 X Y
+  #endif
   tmc_stealth_enabled_t tmc_stealth_enabled;            // M569 X Y Z X2 Y2 Z2 Z3 Z4 E0 E1 E2 E3 E4 E5
 
   //
@@ -1175,6 +1182,14 @@ void MarlinSettings::postprocess() {
       EEPROM_WRITE(tmc_sgt);
     }
 
+    //
+    // Sensorless fast homing stall offsets
+    //
+    #if ENABLED(SENSORLESS_FAST_HOMING)
+      _FIELD_TEST(stall_offset);
+      EEPROM_WRITE(stall_offset);
+    #endif
+
     //
     // TMC stepping mode
     //
@@ -2032,6 +2047,14 @@ void MarlinSettings::postprocess() {
         #endif
       }
 
+      //
+      // Sensorless fast homing stall offsets
+      //
+      #if ENABLED(SENSORLESS_FAST_HOMING)
+        _FIELD_TEST(stall_offset);
+        EEPROM_READ(stall_offset);
+      #endif
+
       // TMC stepping mode
       {
         _FIELD_TEST(tmc_stealth_enabled);
@@ -2479,6 +2502,195 @@ void MarlinSettings::postprocess() {
 
   #endif // AUTO_BED_LEVELING_UBL
 
+  #if ENABLED(ABL_MESH_SLOTS)
+
+    /**
+     * Named BILINEAR meshes live in the last MESH_SLOTS_SIZE bytes of the
+     * store, clear of SettingsData so they survive a layout change. Records
+     * are packed end to end with a 0xFF slot number after the last one. The
+     * area is edited in RAM and written back whole, which only touches the
+     * flash blocks that changed.
+     */
+    typedef struct {
+      uint8_t slot;
+      char name[MESH_SLOT_NAME_LEN];
+      uint16_t len;                           // Packed Z bytes after the header
+      int16_t bed_temp;                       // (°C) 0 if not given
+      int16_t start[2], spacing[2];           // (0.01mm) bilinear_start, bilinear_grid_spacing
+      uint16_t crc;                           // Over the header to here and the packed Z
+    } mesh_slot_t;
+
+    static_assert(sizeof(mesh_slot_t) == 26, "mesh_slot_t must have no padding.");
+
+    static uint8_t mesh_area[MESH_SLOTS_SIZE];
+
+    static uint16_t mesh_slot_crc(const mesh_slot_t &h, const uint8_t * const z) {
+      uint16_t crc = 0;
+      crc16(&crc, &h, offsetof(mesh_slot_t, crc));
+      crc16(&crc, z, h.len);
+      return crc;
+    }
+
+    // Walk the records to the given slot, or to the end with slot 0xFF
+    static uint16_t mesh_find(const uint8_t slot, mesh_slot_t &h) {
+      uint16_t at = 0;
+      while (at + sizeof(h) <= sizeof(mesh_area)) {
+        memcpy(&h, &mesh_area[at], sizeof(h));
+        if (h.slot == 0xFF) break;
+        if (h.slot >= MESH_SLOTS_MAX || at + sizeof(h) + h.len > sizeof(mesh_area)) {
+          mesh_area[at] = 0xFF;               // Cut off anything unreadable
+          break;
+        }
+        if (h.slot == slot) return at;
+        at += sizeof(h) + h.len;
+      }
+      h.slot = 0xFF;
+      return at;
+    }
+
+    // Read the area into RAM. False if it's not there or overlaps the settings.
+    static bool mesh_area_read() {
+      int pos = persistentStore.capacity() - (MESH_SLOTS_SIZE);
+      if (pos < int(MarlinSettings::datasize() + EEPROM_OFFSET)) {
+        SERIAL_ECHO_MSG("?Mesh slots overlap the settings.");
+        return false;
+      }
+      uint16_t crc = 0;
+      persistentStore.access_start();
+      const bool status = persistentStore.read_data(pos, mesh_area, sizeof(mesh_area), &crc);
+      persistentStore.access_finish();
+      if (status) return false;
+      mesh_slot_t h;
+      (void)mesh_find(0xFF, h);               // Drop damaged records so the area can be walked safely
+      return true;
+    }
+
+    static bool mesh_area_write() {
+      int pos = persistentStore.capacity() - (MESH_SLOTS_SIZE);
+      uint16_t crc = 0;
+      persistentStore.access_start();
+      const bool status = persistentStore.write_data(pos, mesh_area, sizeof(mesh_area), &crc);
+      if (!persistentStore.access_finish() || status) {
+        SERIAL_ECHO_MSG("?Unable to save mesh slots.");
+        return false;
+      }
+      return true;
+    }
+
+    static void mesh_remove(const uint8_t slot) {
+      mesh_slot_t h;
+      const uint16_t at = mesh_find(slot, h);
+      if (h.slot == 0xFF) return;
+      const uint16_t next = at + sizeof(h) + h.len;
+      memmove(&mesh_area[at], &mesh_area[next], sizeof(mesh_area) - next);
+      memset(&mesh_area[sizeof(mesh_area) - (next - at)], 0xFF, next - at);
+    }
+
+    bool MarlinSettings::store_mesh(const uint8_t slot, const char * const name, const int16_t bed_temp) {
+      if (slot >= MESH_SLOTS_MAX) { SERIAL_ECHO_MSG("?Invalid mesh slot."); return false; }
+      if (!leveling_is_valid()) { SERIAL_ECHO_MSG("?No mesh to save."); return false; }
+      if (!mesh_area_read()) return false;
+      mesh_remove(slot);
+
+      mesh_slot_t h;
+      const uint16_t at = mesh_find(0xFF, h), room = sizeof(mesh_area) - at;
+      h.len = room > sizeof(h) ? bed_level_pack(&mesh_area[at + sizeof(h)], room - sizeof(h)) : 0;
+      if (!h.len) { SERIAL_ECHO_MSG("?Mesh slots full."); return false; }
+
+      h.slot = slot;
+      LOOP_L_N(i, MESH_SLOT_NAME_LEN) h.name[i] = name && (i == 0 || h.name[i - 1]) ? name[i] : '\0';
+      h.bed_temp = bed_temp;
+      LOOP_L_N(a, 2) {
+        h.start[a] = LROUND(bilinear_start[a] * 100.0f);
+        h.spacing[a] = LROUND(bilinear_grid_spacing[a] * 100.0f);
+      }
+      h.crc = mesh_slot_crc(h, &mesh_area[at + sizeof(h)]);
+      memcpy(&mesh_area[at], &h, sizeof(h));
+      if (at + sizeof(h) + h.len < sizeof(mesh_area)) mesh_area[at + sizeof(h) + h.len] = 0xFF;
+
+      if (!mesh_area_write()) return false;
+      DEBUG_ECHOLNPAIR("Mesh saved in slot ", slot, " (", h.len, " bytes)");
+      return true;
+    }
+
+    /**
+     * Load a slot into z_values and refresh the leveling. A slot that fails
+     * its checks leaves the mesh in RAM as it was. The caller turns leveling
+     * off before and back on after.
+     */
+    bool MarlinSettings::load_mesh(const uint8_t slot) {
+      if (!mesh_area_read()) return false;
+      mesh_slot_t h;
+      const uint16_t at = mesh_find(slot, h);
+      if (h.slot == 0xFF) { SERIAL_ECHO_MSG("?Mesh slot is empty."); return false; }
+      const uint8_t * const z = &mesh_area[at + sizeof(h)];
+      if (h.crc != mesh_slot_crc(h, z)) { SERIAL_ECHO_MSG("?Mesh slot CRC mismatch."); return false; }
+
+      if (!bed_level_unpack(z, h.len)) { SERIAL_ECHO_MSG("?Unable to load mesh data."); return false; }
+      LOOP_L_N(a, 2) {
+        bilinear_start[a] = h.start[a] * 0.01f;
+        bilinear_grid_spacing[a] = h.spacing[a] * 0.01f;
+      }
+      refresh_bed_level();
+      DEBUG_ECHOLNPAIR("Mesh loaded from slot ", slot);
+      return true;
+    }
+
+    bool MarlinSettings::delete_mesh(const uint8_t slot) {
+      if (!mesh_area_read()) return false;
+      mesh_remove(slot);
+      return mesh_area_write();
+    }
+
+    // The good slot probed closest to the given bed temperature, or -1 if none is within MESH_SLOT_TEMP_RANGE
+    int8_t MarlinSettings::find_mesh(const int16_t bed_temp) {
+      int8_t best = -1;
+      if (!mesh_area_read()) return best;
+      int16_t best_d = (MESH_SLOT_TEMP_RANGE) + 1;
+      mesh_slot_t h;
+      for (uint16_t at = 0; at + sizeof(h) <= sizeof(mesh_area); at += sizeof(h) + h.len) {
+        memcpy(&h, &mesh_area[at], sizeof(h));
+        if (h.slot >= MESH_SLOTS_MAX) break;
+        const int16_t d = ABS(h.bed_temp - bed_temp);
+        if (h.bed_temp && d < best_d && h.crc == mesh_slot_crc(h, &mesh_area[at + sizeof(h)])) { best_d = d; best = h.slot; }
+      }
+      return best;
+    }
+
+    // The lowest empty slot, or -1 if all are in use
+    int8_t MarlinSettings::free_mesh() {
+      if (!mesh_area_read()) return -1;
+      mesh_slot_t h;
+      LOOP_L_N(i, MESH_SLOTS_MAX) {
+        (void)mesh_find(i, h);
+        if (h.slot == 0xFF) return i;
+      }
+      return -1;
+    }
+
+    void MarlinSettings::list_meshes() {
+      if (!mesh_area_read()) return;
+      mesh_slot_t h;
+      uint16_t used = 0;
+      for (uint16_t at = 0; at + sizeof(h) <= sizeof(mesh_area); at += sizeof(h) + h.len) {
+        memcpy(&h, &mesh_area[at], sizeof(h));
+        if (h.slot >= MESH_SLOTS_MAX) break;
+        used = at + sizeof(h) + h.len;
+        char name[MESH_SLOT_NAME_LEN + 1];
+        memcpy(name, h.name, MESH_SLOT_NAME_LEN);
+        name[MESH_SLOT_NAME_LEN] = '\0';
+        SERIAL_ECHO_START();
+        SERIAL_ECHOPAIR("Slot ", h.slot, " \"", name, "\" bed ", h.bed_temp);
+        SERIAL_ECHOPAIR("C start ", h.start[0] * 0.01f, ",", h.start[1] * 0.01f);
+        SERIAL_ECHOPAIR(" spacing ", h.spacing[0] * 0.01f, ",", h.spacing[1] * 0.01f);
+        SERIAL_ECHOLNPAIR(" ", h.len, " bytes", h.crc == mesh_slot_crc(h, &mesh_area[at + sizeof(h)]) ? "" : " (bad CRC)");
+      }
+      SERIAL_ECHO_START();
+      SERIAL_ECHOLNPAIR("Mesh slots use ", used, " of ", int(MESH_SLOTS_SIZE), " bytes");
+    }
+
+  #endif // ABL_MESH_SLOTS
+
 #else // !EEPROM_SETTINGS
 
   bool MarlinSettings::save() {
@@ -2529,6 +2741,8 @@ void MarlinSettings::reset() {
     home_offset.reset();
   #endif
 
+  TERN_(SENSORLESS_FAST_HOMING, stall_offset.set(NAN, NAN));
+
   TERN_(HAS_HOTEND_OFFSET, reset_hotend_offsets());
 
   //
@@ -3662,6 +3876,12 @@ void MarlinSettings::reset() {
 
       #endif // USE_SENSORLESS
 
+      #if ENABLED(SENSORLESS_FAST_HOMING)
+        CONFIG_ECHO_HEADING("Sensorless fast homing stall offsets:");
+        CONFIG_ECHO_START();
+        M915_report(true);
+      #endif
+
       /**
        * TMC stepping mode
        */
@@ -31,6 +31,10 @@
   #include "../HAL/shared/eeprom_api.h"
 #endif
 
+#if ENABLED(ABL_MESH_SLOTS)
+  #define MESH_SLOT_NAME_LEN 11           // Characters in a mesh slot name
+#endif
+
 class MarlinSettings {
   public:
     static uint16_t datasize();
@@ -76,6 +80,15 @@ class MarlinSettings {
         //static void delete_mesh();    // necessary if we have a MAT
         //static void defrag_meshes();  // "
       #endif
+
+      #if ENABLED(ABL_MESH_SLOTS)         // Named BILINEAR meshes, packed at the end of the store
+        static bool store_mesh(const uint8_t slot, const char * const name, const int16_t bed_temp);
+        static bool load_mesh(const uint8_t slot);
+        static bool delete_mesh(const uint8_t slot);
+        static int8_t find_mesh(const int16_t bed_temp);
+        static int8_t free_mesh();
+        static void list_meshes();
+      #endif
     #else
       FORCE_INLINE
       static bool load() { reset(); report(); return true; }
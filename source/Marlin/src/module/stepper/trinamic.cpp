@@ -480,6 +480,8 @@ enum StealthIndex : uint8_t { STEALTH_AXIS_XY, STEALTH_AXIS_Z, STEALTH_AXIS_E };
         stepperE7.beginSerial(TMC_BAUD_RATE);
       #endif
     #endif
+
+    TERN_(TMC_UART_ASYNC, tmc_bus.init());
   }
 #endif
 
@@ -799,6 +801,8 @@ void reset_trinamic_drivers() {
     TMC_ADV()
   #endif
 
+  TERN_(TMC_SHADOW_REGISTERS, TMCShadow::flush_all());
+
   stepper.set_directions();
 }
 
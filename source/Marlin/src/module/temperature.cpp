@@ -110,10 +110,22 @@
   #include "../feature/e_parser.h"
 #endif
 
+#if ENABLED(HEATER_HEALTH_CHECK)
+  #include "../feature/heater_health.h"
+#endif
+
+#if ENABLED(TEMP_TELEMETRY)
+  #include "../feature/temp_telemetry.h"
+#endif
+
 #if ENABLED(PRINTER_EVENT_LEDS)
   #include "../feature/leds/printer_event_leds.h"
 #endif
 
+#if ENABLED(PID_AUTOTUNE_FAST)
+  #include "../feature/fopdt.h"
+#endif
+
 #if ENABLED(JOYSTICK)
   #include "../feature/joystick.h"
 #endif
@@ -678,6 +690,153 @@ volatile bool Temperature::raw_temps_ready = false;
       return;
   }
 
+  #if ENABLED(PID_AUTOTUNE_FAST)
+
+    /**
+     * Fast PID Autotuning (M303 F1)
+     *
+     * Apply full power once, fit the heating curve to a first-order-plus-
+     * dead-time model, and derive the PID gains from the model. This takes
+     * a single rise to the target instead of several relay cycles.
+     * With DEBUGGING(DRYRUN) the heater stays off and a simulated plant
+     * is used, to check the fit against known parameters.
+     */
+    void Temperature::PID_autotune_fast(const float &target, const heater_id_t heater_id, const bool set_result/*=false*/) {
+      const bool isbed = (heater_id == H_BED);
+
+      if (target > GHV(BED_MAX_TARGET, temp_range[heater_id].maxtemp - HOTEND_OVERSHOOT)) {
+        SERIAL_ECHOLNPGM(STR_PID_TEMP_TOO_HIGH);
+        TERN_(EXTENSIBLE_UI, ExtUI::onPidTuning(ExtUI::result_t::PID_TEMP_TOO_HIGH));
+        return;
+      }
+
+      SERIAL_ECHOLNPGM(STR_PID_AUTOTUNE_START);
+
+      const long step = GHV(MAX_BED_POWER, PID_MAX);
+      const uint16_t period_ms = GHV(2000, 500);
+      FOPDTFit fitter;
+      fopdt_model_t model;
+      bool reached = false;
+      millis_t start_ms = millis();
+
+      if (DEBUGGING(DRYRUN)) {
+        static constexpr fopdt_model_t sim_hotend = PID_AUTOTUNE_SIM_HOTEND, sim_bed = PID_AUTOTUNE_SIM_BED;
+        const fopdt_model_t &plant = isbed ? sim_bed : sim_hotend;
+        SERIAL_ECHOLNPAIR("Simulated K:", plant.K, " tau:", plant.tau, " L:", plant.L);
+        fitter.start(25, step, period_ms);
+        fitter.simulate(plant, target);
+        reached = true;
+      }
+      else {
+        disable_all_heaters();
+        TERN_(AUTO_POWER_CONTROL, powerManager.power_on());
+        TERN_(NO_FAN_SLOWING_IN_PID_TUNING, adaptive_fan_slowing = false);
+
+        float current_temp = GHV(temp_bed.celsius, temp_hotend[heater_id].celsius);
+        millis_t next_temp_ms = start_ms;
+        #if WATCH_PID
+          const bool watching = BOTH(WATCH_BED, WATCH_HOTENDS) || isbed == DISABLED(WATCH_HOTENDS);
+          float watch_temp = current_temp + GTV(WATCH_BED_TEMP_INCREASE, WATCH_TEMP_INCREASE);
+          millis_t watch_ms = start_ms + SEC_TO_MS(GTV(WATCH_BED_TEMP_PERIOD, WATCH_TEMP_PERIOD));
+        #endif
+
+        fitter.start(current_temp, step, period_ms);
+        SHV(step >> 1, step >> 1);
+
+        wait_for_heatup = true; // Can be interrupted with M108
+        while (wait_for_heatup && !reached) {
+          const millis_t ms = millis();
+
+          if (raw_temps_ready) {
+            updateTemperaturesFromRawValues();
+            current_temp = GHV(temp_bed.celsius, temp_hotend[heater_id].celsius);
+            fitter.sample(ms - start_ms, current_temp);
+            reached = current_temp >= target;
+          }
+
+          if (ELAPSED(ms, next_temp_ms)) {
+            #if HAS_TEMP_SENSOR
+              print_heater_states(isbed ? active_extruder : heater_id);
+              SERIAL_EOL();
+            #endif
+            next_temp_ms = ms + 2000UL;
+          }
+
+          // Make sure heating is actually working
+          #if WATCH_PID
+            if (watching) {
+              if (current_temp > watch_temp) {
+                watch_temp = current_temp + GTV(WATCH_BED_TEMP_INCREASE, WATCH_TEMP_INCREASE);
+                watch_ms = ms + SEC_TO_MS(GTV(WATCH_BED_TEMP_PERIOD, WATCH_TEMP_PERIOD));
+              }
+              else if (ELAPSED(ms, watch_ms)) {
+                _temp_error(heater_id, str_t_heating_failed, GET_TEXT(MSG_HEATING_FAILED_LCD));
+                break;
+              }
+            }
+          #endif
+
+          if (ms - start_ms > (MAX_CYCLE_TIME_PID_AUTOTUNE * 60L * 1000L)) {
+            TERN_(EXTENSIBLE_UI, ExtUI::onPidTuning(ExtUI::result_t::PID_TUNING_TIMEOUT));
+            SERIAL_ECHOLNPGM(STR_PID_TIMEOUT);
+            break;
+          }
+
+          TERN_(HAL_IDLETASK, HAL_idletask());
+          TERN(DWIN_CREALITY_LCD, DWIN_Update(), ui.update());
+        }
+        wait_for_heatup = false;
+
+        disable_all_heaters();
+        TERN_(NO_FAN_SLOWING_IN_PID_TUNING, adaptive_fan_slowing = true);
+      }
+
+      if (!reached) return;
+
+      if (!fitter.fit(model)) {
+        SERIAL_ECHOLNPGM("PID Autotune failed! Not enough data to fit");
+        TERN_(EXTENSIBLE_UI, ExtUI::onPidTuning(ExtUI::result_t::PID_TUNING_TIMEOUT));
+        return;
+      }
+
+      const fopdt_gains_t g = FOPDTFit::gains(model, GHV(PID_AUTOTUNE_FAST_LAMBDA_BED, PID_AUTOTUNE_FAST_LAMBDA));
+      PID_t tune_pid = { g.Kp, g.Ki, g.Kd };
+
+      SERIAL_ECHOLNPAIR("Model K:", model.K, " tau:", model.tau, " L:", model.L, " in ", long((millis() - start_ms) / 1000UL), "s");
+      #if HAS_HEATER_MODEL
+      {
+        // Heater watts are taken from the configured model. The fit gives the rest.
+        static constexpr heater_model_t hotend_model = HOTEND_THERMAL_MODEL;
+        #if HAS_HEATED_BED
+          static constexpr heater_model_t bed_model = BED_THERMAL_MODEL;
+        #endif
+        const float watts = GHV(bed_model.watts, hotend_model.watts),
+                    loss = watts * heater_supply_scale() / (model.K * 255); // K is per PID count
+        SERIAL_ECHOLNPAIR("Thermal model { ", watts, ", ", loss * model.tau, ", ", loss, " }");
+      }
+      #endif
+      SERIAL_ECHOLNPGM(STR_PID_AUTOTUNE_FINISHED);
+      const char * const estring = GHV(PSTR("bed"), NUL_STR);
+      say_default_(); serialprintPGM(estring); SERIAL_ECHOLNPAIR("Kp ", tune_pid.Kp);
+      say_default_(); serialprintPGM(estring); SERIAL_ECHOLNPAIR("Ki ", tune_pid.Ki);
+      say_default_(); serialprintPGM(estring); SERIAL_ECHOLNPAIR("Kd ", tune_pid.Kd);
+
+      // Use the result? (As with "M303 U1")
+      if (set_result && !DEBUGGING(DRYRUN)) {
+        #if HAS_PID_FOR_BOTH
+          if (isbed) _SET_BED_PID(); else _SET_EXTRUDER_PID();
+        #elif ENABLED(PIDTEMP)
+          _SET_EXTRUDER_PID();
+        #else
+          _SET_BED_PID();
+        #endif
+      }
+
+      TERN_(EXTENSIBLE_UI, ExtUI::onPidTuning(ExtUI::result_t::PID_DONE));
+    }
+
+  #endif // PID_AUTOTUNE_FAST
+
 #endif // HAS_PID_HEATING
 
 /**
@@ -697,6 +856,20 @@ int16_t Temperature::getHeaterPower(const heater_id_t heater_id) {
   }
 }
 
+#if HAS_HEATER_MODEL
+
+  float Temperature::heater_supply_scale() {
+    #if ENABLED(POWER_MONITOR_VOLTAGE)
+      // Resistive heaters: power goes with the square of the voltage
+      const float v = power_monitor.getVolts();
+      if (WITHIN(v, (HEATER_NOMINAL_VOLTAGE) * 0.5f, (HEATER_NOMINAL_VOLTAGE) * 1.5f))
+        return sq(v * (1.0f / (HEATER_NOMINAL_VOLTAGE)));
+    #endif
+    return 1.0f;
+  }
+
+#endif
+
 #define _EFANOVERLAP(A,B) _FANOVERLAP(E##A,B)
 
 #if HAS_AUTO_FAN
@@ -848,6 +1021,29 @@ void Temperature::_temp_error(const heater_id_t heater_id, PGM_P const serial_ms
   #endif
 }
 
+#if ENABLED(HEATER_HEALTH_CHECK)
+
+  void Temperature::check_heater_health(const heater_id_t heater_id, const uint8_t index, const heater_info_t &heater, const millis_t &ms) {
+    const HeaterHealth::Verdict verdict = heater_health.update(index, heater.celsius, heater.soft_pwm_amount, ms);
+    if (verdict == HeaterHealth::HEALTH_OK) return;
+
+    #if ENABLED(HEATER_HEALTH_REPORT_ONLY)
+      // Models not calibrated yet. Tell the host what would have tripped and keep heating.
+      SERIAL_ECHO_START();
+      SERIAL_ECHOPGM("Heater health ");
+      if (heater_id >= 0) SERIAL_ECHO((int)heater_id); else SERIAL_ECHOPGM(STR_HEATER_BED);
+      serialprintPGM(verdict == HeaterHealth::HEALTH_HEAT_MISSING ? PSTR(": heat missing") : PSTR(": heat excess"));
+      SERIAL_EOL();
+    #else
+      if (verdict == HeaterHealth::HEALTH_HEAT_MISSING)
+        _temp_error(heater_id, str_t_heating_failed, GET_TEXT(MSG_HEATING_FAILED_LCD));
+      else
+        _temp_error(heater_id, str_t_thermal_runaway, GET_TEXT(MSG_THERMAL_RUNAWAY));
+    #endif
+  }
+
+#endif
+
 void Temperature::max_temp_error(const heater_id_t heater_id) {
   #if ENABLED(DWIN_CREALITY_LCD) && (HAS_HOTEND || HAS_HEATED_BED)
     DWIN_Popup_Temperature(1);
@@ -888,6 +1084,7 @@ void Temperature::min_temp_error(const heater_id_t heater_id) {
         const float pid_error = temp_hotend[ee].target - temp_hotend[ee].celsius;
 
         float pid_output;
+        TERN_(TEMP_TELEMETRY, temp_hotend[ee].set_pid_terms(0, 0, 0));
 
         if (temp_hotend[ee].target == 0
           || pid_error < -(PID_FUNCTIONAL_RANGE)
@@ -914,6 +1111,7 @@ void Temperature::min_temp_error(const heater_id_t heater_id) {
           work_pid[ee].Ki = PID_PARAM(Ki, ee) * temp_iState[ee];
 
           pid_output = work_pid[ee].Kp + work_pid[ee].Ki + work_pid[ee].Kd + float(MIN_POWER);
+          TERN_(TEMP_TELEMETRY, temp_hotend[ee].set_pid_terms(work_pid[ee].Kp, work_pid[ee].Ki, work_pid[ee].Kd));
 
           #if ENABLED(PID_EXTRUSION_SCALING)
             #if HOTENDS == 1
@@ -999,6 +1197,7 @@ void Temperature::min_temp_error(const heater_id_t heater_id) {
       const float max_power_over_i_gain = float(MAX_BED_POWER) / temp_bed.pid.Ki - float(MIN_BED_POWER),
                   pid_error = temp_bed.target - temp_bed.celsius;
 
+      TERN_(TEMP_TELEMETRY, temp_bed.set_pid_terms(0, 0, 0));
       if (!temp_bed.target || pid_error < -(PID_FUNCTIONAL_RANGE)) {
         pid_output = 0;
         pid_reset = true;
@@ -1023,6 +1222,7 @@ void Temperature::min_temp_error(const heater_id_t heater_id) {
         temp_dState = temp_bed.celsius;
 
         pid_output = constrain(work_pid.Kp + work_pid.Ki + work_pid.Kd + float(MIN_BED_POWER), 0, MAX_BED_POWER);
+        TERN_(TEMP_TELEMETRY, temp_bed.set_pid_terms(work_pid.Kp, work_pid.Ki, work_pid.Kd));
       }
 
     #else // PID_OPENLOOP
@@ -1079,6 +1279,9 @@ void Temperature::manage_heater() {
 
   updateTemperaturesFromRawValues(); // also resets the watchdog
 
+  // The PID terms below are worked out before idle() sends the frame
+  TERN_(TEMP_TELEMETRY, temp_telemetry.sampled(millis()));
+
   #if DISABLED(IGNORE_THERMOCOUPLE_ERRORS)
     #if HEATER_0_USES_MAX6675
       if (temp_hotend[0].celsius > _MIN(HEATER_0_MAXTEMP, HEATER_0_MAX6675_TMAX - 1.0)) max_temp_error(H_E0);
@@ -1106,7 +1309,11 @@ void Temperature::manage_heater() {
         tr_state_machine[e].run(temp_hotend[e].celsius, temp_hotend[e].target, (heater_id_t)e, THERMAL_PROTECTION_PERIOD, THERMAL_PROTECTION_HYSTERESIS);
       #endif
 
+      // Check the power balance with the PWM applied since the last update
+      TERN_(HEATER_HEALTH_CHECK, check_heater_health((heater_id_t)e, e, temp_hotend[e], ms));
+
       temp_hotend[e].soft_pwm_amount = (temp_hotend[e].celsius > temp_range[e].mintemp || is_preheating(e)) && temp_hotend[e].celsius < temp_range[e].maxtemp ? (int)get_pid_output_hotend(e) >> 1 : 0;
+      TERN_(PREHEAT_SCHEDULER, temp_hotend[e].apply_limit());
 
       #if WATCH_HOTENDS
         // Make sure temperature is increasing
@@ -1163,6 +1370,8 @@ void Temperature::manage_heater() {
       }
     #endif // WATCH_BED
 
+    TERN_(HEATER_HEALTH_CHECK, check_heater_health(H_BED, HEALTH_INDEX_BED, temp_bed, ms));
+
     #if BOTH(PROBING_HEATERS_OFF, BED_LIMIT_SWITCHING)
       #define PAUSE_CHANGE_REQD 1
     #endif
@@ -1199,6 +1408,7 @@ void Temperature::manage_heater() {
       {
         #if ENABLED(PIDTEMPBED)
           temp_bed.soft_pwm_amount = WITHIN(temp_bed.celsius, BED_MINTEMP, BED_MAXTEMP) ? (int)get_pid_output_bed() >> 1 : 0;
+          TERN_(PREHEAT_SCHEDULER, temp_bed.apply_limit());
         #else
           // Check if temperature is within the correct band
           if (WITHIN(temp_bed.celsius, BED_MINTEMP, BED_MAXTEMP)) {
@@ -1874,9 +2084,17 @@ void Temperature::init() {
     // HAL_ANALOG_SELECT(POWER_MONITOR_VOLTAGE_PIN);
   #endif
 
+  #if ENABLED(TEMP_ISR_STATS)
+    HAL_cycle_counter_init();
+    reset_isr_stats();
+  #endif
+
   HAL_timer_start(TEMP_TIMER_NUM, TEMP_TIMER_FREQUENCY);
   ENABLE_TEMPERATURE_INTERRUPT();
 
+  // Sensors are sampled when the ADC scan triggered at this rate completes
+  TERN_(TEMP_SENSOR_EVENT_ISR, HAL_ADC_EVENT_START(TEMP_SENSOR_FREQUENCY));
+
   #if HAS_AUTO_FAN_0
     INIT_E_AUTO_FAN_PIN(E0_AUTO_FAN_PIN);
   #endif
@@ -2135,6 +2353,8 @@ void Temperature::disable_all_heaters() {
   // Unpause and reset everything
   TERN_(PROBING_HEATERS_OFF, pause(false));
 
+  TERN_(HEATER_HEALTH_CHECK, heater_health.reset());
+
   #if HAS_HOTEND
     HOTEND_LOOP() {
       setTargetHotend(0, e);
@@ -2476,12 +2696,92 @@ void Temperature::readings_ready() {
  */
 HAL_TEMP_TIMER_ISR() {
   HAL_timer_isr_prologue(TEMP_TIMER_NUM);
+  TERN_(TEMP_ISR_STATS, const uint32_t start = HAL_cycle_count());
 
   Temperature::tick();
 
+  TERN_(TEMP_ISR_STATS, Temperature::tick_stats.add(HAL_cycle_count() - start));
   HAL_timer_isr_epilogue(TEMP_TIMER_NUM);
 }
 
+#if ENABLED(TEMP_SENSOR_EVENT_ISR)
+
+  /**
+   * The ADC scans its channels on a hardware timer at TEMP_SENSOR_FREQUENCY
+   * and DMA stores the results. Once the whole scan is stored, every sensor
+   * takes one sample here, so the ~1KHz tick no longer has to visit them.
+   */
+  HAL_ADC_EVENT_ISR() {
+    TERN_(TEMP_ISR_STATS, const uint32_t start = HAL_cycle_count());
+
+    Temperature::sample_sensors();
+
+    TERN_(TEMP_ISR_STATS, Temperature::sensor_stats.add(HAL_cycle_count() - start));
+    HAL_adc_event_isr_epilogue();
+  }
+
+  void Temperature::sample_sensors() {
+    static uint8_t temp_count = 0;
+
+    #define SAMPLE_ADC(P) (HAL_START_ADC(P), HAL_READ_ADC())
+
+    #if HAS_TEMP_ADC_0
+      temp_hotend[0].sample(SAMPLE_ADC(TEMP_0_PIN));
+    #endif
+    #if HAS_TEMP_ADC_BED
+      temp_bed.sample(SAMPLE_ADC(TEMP_BED_PIN));
+    #endif
+    #if ENABLED(POWER_MONITOR_VOLTAGE)
+      power_monitor.add_voltage_sample(SAMPLE_ADC(POWER_MONITOR_VOLTAGE_PIN));
+    #endif
+
+    #undef SAMPLE_ADC
+
+    if (++temp_count >= OVERSAMPLENR) {
+      temp_count = 0;
+      readings_ready();
+    }
+  }
+
+#endif // TEMP_SENSOR_EVENT_ISR
+
+#if ENABLED(TEMP_ISR_STATS)
+
+  isr_stats_t Temperature::tick_stats, Temperature::sensor_stats;
+  millis_t Temperature::isr_stats_ms;
+
+  void Temperature::reset_isr_stats() {
+    DISABLE_ISRS();
+    tick_stats.reset();
+    sensor_stats.reset();
+    ENABLE_ISRS();
+    isr_stats_ms = millis();
+  }
+
+  static void print_isr_stats(PGM_P const label, const isr_stats_t &st, const millis_t ms) {
+    // Cycles per millisecond of elapsed time, as per mille of the CPU
+    const uint32_t avg = st.count ? uint32_t(st.total / st.count) : 0,
+                   load = ms ? uint32_t(st.total / ms * 1000 / (F_CPU / 1000)) : 0;
+    serialprintPGM(label);
+    SERIAL_ECHOPAIR(" n:", st.count, " avg:", avg, " max:", st.max, " load:", load / 10);
+    SERIAL_CHAR('.', '0' + char(load % 10));
+    SERIAL_ECHOLNPGM("%");
+  }
+
+  void Temperature::report_isr_stats() {
+    DISABLE_ISRS();
+    const isr_stats_t tick = tick_stats, sensor = sensor_stats;
+    ENABLE_ISRS();
+    const millis_t ms = millis() - isr_stats_ms;
+    SERIAL_ECHOLNPAIR("ISR cycles over ", ms, "ms");
+    print_isr_stats(PSTR("Tick  "), tick, ms);
+    #if ENABLED(TEMP_SENSOR_EVENT_ISR)
+      print_isr_stats(PSTR("Sensor"), sensor, ms);
+    #endif
+  }
+
+#endif // TEMP_ISR_STATS
+
 #if ENABLED(SLOW_PWM_HEATERS) && !defined(MIN_STATE_TIME)
   #define MIN_STATE_TIME 16 // MIN_STATE_TIME * 65.5 = time in milliseconds
 #endif
@@ -2511,15 +2811,17 @@ public:
  * Handle various ~1KHz tasks associated with temperature
  *  - Heater PWM (~1KHz with scaler)
  *  - LCD Button polling (~500Hz)
- *  - Start / Read one ADC sensor
+ *  - Start / Read one ADC sensor (unless TEMP_SENSOR_EVENT_ISR)
  *  - Advance Babysteps
  *  - Endstop polling
  *  - Planner clean buffer
  */
 void Temperature::tick() {
 
-  static int8_t temp_count = -1;
-  static ADCSensorState adc_sensor_state = StartupDelay;
+  #if DISABLED(TEMP_SENSOR_EVENT_ISR)
+    static int8_t temp_count = -1;
+    static ADCSensorState adc_sensor_state = StartupDelay;
+  #endif
   static uint8_t pwm_count = _BV(SOFT_PWM_SCALE);
 
   // avoid multiple loads of pwm_count
@@ -2796,6 +3098,8 @@ void Temperature::tick() {
   static bool do_buttons;
   if ((do_buttons ^= true)) ui.update_buttons();
 
+  #if DISABLED(TEMP_SENSOR_EVENT_ISR)
+
   /**
    * One sensor is sampled on every other call of the ISR.
    * Each sensor is read 16 (OVERSAMPLENR) times, taking the average.
@@ -2970,6 +3274,8 @@ void Temperature::tick() {
   // Go to the next state
   adc_sensor_state = next_sensor_state;
 
+  #endif // !TEMP_SENSOR_EVENT_ISR
+
   //
   // Additional ~1KHz Tasks
   //
@@ -155,7 +155,11 @@ enum ADCSensorState : char {
 
 #if HAS_PID_HEATING
   #define PID_K2 (1-float(PID_K1))
-  #define PID_dT ((OVERSAMPLENR * float(ACTUAL_ADC_SAMPLES)) / TEMP_TIMER_FREQUENCY)
+  #if ENABLED(TEMP_SENSOR_EVENT_ISR)
+    #define PID_dT (float(OVERSAMPLENR) / (TEMP_SENSOR_FREQUENCY))
+  #else
+    #define PID_dT ((OVERSAMPLENR * float(ACTUAL_ADC_SAMPLES)) / TEMP_TIMER_FREQUENCY)
+  #endif
 
   // Apply the scale factors to the PID values
   #define scalePID_i(i)   ( float(i) * PID_dT )
@@ -168,6 +172,25 @@ enum ADCSensorState : char {
   #define G26_CLICK_CAN_CANCEL 1
 #endif
 
+#if ENABLED(TEMP_ISR_STATS)
+  // Cycles spent in an ISR
+  typedef struct {
+    uint32_t count, max;
+    uint64_t total;
+    inline void add(const uint32_t cycles) { count++; total += cycles; NOLESS(max, cycles); }
+    inline void reset() { count = max = 0; total = 0; }
+  } isr_stats_t;
+#endif
+
+#if HAS_HEATER_MODEL
+  // First-order thermal model of a heater: C * dT/dt = P - k * (T - Tamb)
+  typedef struct {
+    float watts,      // (W) Heater power at HEATER_NOMINAL_VOLTAGE
+          capacity,   // (J/K) Heat capacity of the heater block or bed
+          loss;       // (W/K) Heat lost to ambient per degree above ambient
+  } heater_model_t;
+#endif
+
 // A temperature sensor
 typedef struct TempInfo {
   uint16_t acc;
@@ -182,6 +205,16 @@ typedef struct TempInfo {
 typedef struct HeaterInfo : public TempInfo {
   int16_t target;
   uint8_t soft_pwm_amount;
+  #if ENABLED(PREHEAT_SCHEDULER)
+    uint8_t soft_pwm_limit;   // Power cap set by the preheat scheduler (0 = none)
+    inline void apply_limit() { if (soft_pwm_limit) NOMORE(soft_pwm_amount, soft_pwm_limit); }
+  #endif
+  #if ENABLED(TEMP_TELEMETRY)
+    int16_t pid_term[3];      // Last P, I, D terms in 1/10 PWM counts
+    inline void set_pid_terms(const float p, const float i, const float d) {
+      pid_term[0] = int16_t(p * 10); pid_term[1] = int16_t(i * 10); pid_term[2] = int16_t(d * 10);
+    }
+  #endif
 } heater_info_t;
 
 // A heater with PID stabilization
@@ -567,6 +600,16 @@ class Temperature {
      */
     static void readings_ready();
     static void tick();
+    #if ENABLED(TEMP_SENSOR_EVENT_ISR)
+      static void sample_sensors();
+    #endif
+
+    #if ENABLED(TEMP_ISR_STATS)
+      static isr_stats_t tick_stats, sensor_stats;
+      static millis_t isr_stats_ms;
+      static void reset_isr_stats();
+      static void report_isr_stats();
+    #endif
 
     /**
      * Call periodically to manage heaters
@@ -755,6 +798,11 @@ class Temperature {
      */
     static int16_t getHeaterPower(const heater_id_t heater_id);
 
+    #if HAS_HEATER_MODEL
+      // Heater power scale factor from the measured supply voltage
+      static float heater_supply_scale();
+    #endif
+
     /**
      * Switch off all heaters, set all target temperatures to 0
      */
@@ -773,6 +821,9 @@ class Temperature {
      */
     #if HAS_PID_HEATING
       static void PID_autotune(const float &target, const heater_id_t heater_id, const int8_t ncycles, const bool set_result=false);
+      #if ENABLED(PID_AUTOTUNE_FAST)
+        static void PID_autotune_fast(const float &target, const heater_id_t heater_id, const bool set_result=false);
+      #endif
 
       #if ENABLED(NO_FAN_SLOWING_IN_PID_TUNING)
         static bool adaptive_fan_slowing;
@@ -875,6 +926,10 @@ class Temperature {
     static void min_temp_error(const heater_id_t e);
     static void max_temp_error(const heater_id_t e);
 
+    #if ENABLED(HEATER_HEALTH_CHECK)
+      static void check_heater_health(const heater_id_t heater_id, const uint8_t index, const heater_info_t &heater, const millis_t &ms);
+    #endif
+
     #define HAS_THERMAL_PROTECTION ANY(THERMAL_PROTECTION_HOTENDS, THERMAL_PROTECTION_CHAMBER, HAS_THERMALLY_PROTECTED_BED)
 
     #if HAS_THERMAL_PROTECTION
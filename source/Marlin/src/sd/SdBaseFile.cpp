@@ -1059,6 +1059,42 @@ int16_t SdBaseFile::read(void* buf, uint16_t nbyte) {
   return nbyte;
 }
 
+/**
+ * Read the next block of a file without using the volume cache, so the
+ * block cached for another open file stays there. Cluster lookups also
+ * go through \a buf.
+ *
+ * \param[out] buf Receives the block. Only the bytes in the file are valid.
+ *
+ * \return The number of bytes read, 0 at the end of the file, or -1 if
+ * not open for read, not at a block boundary, or on an I/O error.
+ */
+int16_t SdBaseFile::readBlockUncached(cache_t* buf) {
+  if (!isOpen() || !(flags_ & O_READ) || !isFile()) return -1;
+
+  const uint16_t n = _MIN(fileSize_ - curPosition_, uint32_t(512));
+  if (!n) return 0;
+  if (curPosition_ & 0x1FF) return -1;
+
+  const uint8_t blockOfCluster = vol_->blockOfCluster(curPosition_);
+  if (blockOfCluster == 0) {
+    if (curPosition_ == 0)
+      curCluster_ = firstCluster_;
+    else if (!vol_->fatGet(curCluster_, &curCluster_, buf))
+      return -1;
+  }
+
+  // A block already in the cache is copied rather than read again
+  const uint32_t block = vol_->clusterStartBlock(curCluster_) + blockOfCluster;
+  if (block == vol_->cacheBlockNumber())
+    memcpy(buf->data, vol_->cache()->data, n);
+  else if (!vol_->readBlock(block, buf->data))
+    return -1;
+
+  curPosition_ += n;
+  return n;
+}
+
 /**
  * Read the next entry in a directory.
  *
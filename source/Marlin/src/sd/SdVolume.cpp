@@ -160,7 +160,8 @@ bool SdVolume::chainSize(uint32_t cluster, uint32_t* size) {
 }
 
 // Fetch a FAT entry
-bool SdVolume::fatGet(uint32_t cluster, uint32_t* value) {
+// With 'buf' a FAT16/32 block not in the cache is read there, leaving the cache alone
+bool SdVolume::fatGet(uint32_t cluster, uint32_t* value, cache_t* buf/*=nullptr*/) {
   uint32_t lba;
   if (cluster > (clusterCount_ + 1)) return false;
   if (FAT12_SUPPORT && fatType_ == 12) {
@@ -187,10 +188,17 @@ bool SdVolume::fatGet(uint32_t cluster, uint32_t* value) {
   else
     return false;
 
-  if (lba != cacheBlockNumber_ && !cacheRawBlock(lba, CACHE_FOR_READ))
-    return false;
+  const cache_t *fat = &cacheBuffer_;
+  if (lba != cacheBlockNumber_) {
+    if (buf) {
+      if (!readBlock(lba, buf->data)) return false;
+      fat = buf;
+    }
+    else if (!cacheRawBlock(lba, CACHE_FOR_READ))
+      return false;
+  }
 
-  *value = (fatType_ == 16) ? cacheBuffer_.fat16[cluster & 0xFF] : (cacheBuffer_.fat32[cluster & 0x7F] & FAT32MASK);
+  *value = (fatType_ == 16) ? fat->fat16[cluster & 0xFF] : (fat->fat32[cluster & 0x7F] & FAT32MASK);
   return true;
 }
 
@@ -53,6 +53,14 @@
   #include "../feature/pause.h"
 #endif
 
+#if ENABLED(PRINT_ETA_ESTIMATOR)
+  #include "../feature/print_eta.h"
+#endif
+
+#if ENABLED(G29_ADAPTIVE)
+  #include "../feature/print_area.h"
+#endif
+
 #define DEBUG_OUT EITHER(DEBUG_CARDREADER, MARLIN_DEV_MODE)
 #include "../core/debug_out.h"
 #include "../libs/hex_print.h"
@@ -115,6 +123,16 @@ uint8_t CardReader::workDirDepth;
 
 #endif // SDCARD_SORT_ALPHA
 
+#if ENABLED(SDCARD_DIR_INDEX)
+  CardReader::dir_index_t CardReader::dir_index[SDCARD_DIR_INDEX_SIZE];
+  uint16_t CardReader::dir_index_count, CardReader::dir_item_count;
+  bool CardReader::dir_index_valid; // = false
+  #if ENABLED(SD_PREFETCH)
+    CardReader::dir_prefetch_t CardReader::prefetched[SDCARD_DIR_PREFETCH];
+    uint8_t CardReader::prefetch_head;
+  #endif
+#endif
+
 Sd2Card CardReader::sd2card;
 SdVolume CardReader::volume;
 SdFile CardReader::file;
@@ -210,9 +228,9 @@ int CardReader::countItems(SdFile dir) {
 //
 // Get file/folder info for an item by index
 //
-void CardReader::selectByIndex(SdFile dir, const uint8_t index) {
+void CardReader::selectByIndex(SdFile dir, const uint16_t index) {
   dir_t p;
-  for (uint8_t cnt = 0; dir.readDir(&p, longFilename) > 0;) {
+  for (uint16_t cnt = 0; dir.readDir(&p, longFilename) > 0;) {
     if (is_dir_or_gcode(p)) {
       if (cnt == index) {
         createFilename(filename, p);
@@ -503,6 +521,7 @@ void CardReader::release() {
 
   flag.mounted = false;
   flag.workDirIsRoot = true;
+  TERN_(SDCARD_DIR_INDEX, invalidate_index());
   #if ALL(SDCARD_SORT_ALPHA, SDSORT_USES_RAM, SDSORT_CACHE_NAMES)
     nrFiles = 0;
   #endif
@@ -542,6 +561,8 @@ void CardReader::endFilePrint(TERN_(SD_RESORT, const bool re_sort/*=false*/)) {
   TERN_(DWIN_CREALITY_LCD, HMI_flag.print_finish = flag.sdprinting);
   flag.sdprinting = flag.abort_sd_printing = false;
   if (isFileOpen()) file.close();
+  TERN_(PRINT_ETA_ESTIMATOR, print_eta.reset());
+  TERN_(G29_ADAPTIVE, print_area.reset());
   TERN_(SD_RESORT, if (re_sort) presort());
 }
 
@@ -643,6 +664,8 @@ void CardReader::openFileRead(char * const path, const uint8_t subcall_type/*=0*
   if (file.open(diveDir, fname, O_READ)) {
     filesize = file.fileSize();
     sdpos = 0;
+    TERN_(PRINT_ETA_ESTIMATOR, print_eta.start(file));
+    TERN_(G29_ADAPTIVE, print_area.start(file));
 
     SERIAL_ECHOLNPAIR(STR_SD_FILE_OPENED, fname, STR_SD_SIZE, filesize);
     SERIAL_ECHOLNPGM(STR_SD_FILE_SELECTED);
@@ -678,6 +701,7 @@ void CardReader::openFileWrite(char * const path) {
   #else
     if (file.open(diveDir, fname, O_CREAT | O_APPEND | O_WRITE | O_TRUNC)) {
       flag.saving = true;
+      TERN_(SDCARD_DIR_INDEX, invalidate_index());
       selectFileByName(fname);
       TERN_(EMERGENCY_PARSER, emergency_parser.disable());
       echo_write_to_file(fname);
@@ -732,6 +756,7 @@ void CardReader::removeFile(const char * const name) {
     if (file.remove(curDir, fname)) {
       SERIAL_ECHOLNPAIR("File deleted:", fname);
       sdpos = 0;
+      TERN_(SDCARD_DIR_INDEX, invalidate_index());
       TERN_(SDCARD_SORT_ALPHA, presort());
     }
     else
@@ -744,6 +769,7 @@ void CardReader::report_status() {
     SERIAL_ECHOPAIR(STR_SD_PRINTING_BYTE, sdpos);
     SERIAL_CHAR('/');
     SERIAL_ECHOLN(filesize);
+    TERN_(PRINT_ETA_ESTIMATOR, print_eta.report());
   }
   else
     SERIAL_ECHOLNPGM(STR_SD_NOT_PRINTING);
@@ -835,6 +861,28 @@ void CardReader::selectFileByIndex(const uint16_t nr) {
       return;
     }
   #endif
+  #if ENABLED(SDCARD_DIR_INDEX)
+    if (TERN0(SD_PREFETCH, take_prefetched(nr))) return;
+    if (!dir_index_valid) build_index();
+    if (nr < dir_index_count) {
+      if (read_indexed(nr, filename, longFilename)) {
+        flag.filenameIsDir = dir_index[nr].isDir;
+        return;
+      }
+      build_index();                      // The folder changed behind our back
+      if (nr < dir_index_count && read_indexed(nr, filename, longFilename)) {
+        flag.filenameIsDir = dir_index[nr].isDir;
+        return;
+      }
+    }
+    else if (dir_index_count == SDCARD_DIR_INDEX_SIZE) {
+      // Beyond the index, so scan on from the last indexed item
+      const uint16_t last = dir_index_count - 1;
+      workDir.seekSet(dir_index[last].pos);
+      selectByIndex(workDir, nr - last);
+      return;
+    }
+  #endif
   workDir.rewind();
   selectByIndex(workDir, nr);
 }
@@ -857,10 +905,136 @@ void CardReader::selectFileByName(const char * const match) {
 }
 
 uint16_t CardReader::countFilesInWorkDir() {
-  workDir.rewind();
-  return countItems(workDir);
+  #if ENABLED(SDCARD_DIR_INDEX)
+    if (!dir_index_valid) build_index();
+    #if ALL(SDCARD_SORT_ALPHA, SDSORT_USES_RAM, SDSORT_CACHE_NAMES)
+      nrFiles = dir_item_count;
+    #endif
+    return dir_item_count;
+  #else
+    workDir.rewind();
+    return countItems(workDir);
+  #endif
 }
 
+#if ENABLED(SDCARD_DIR_INDEX)
+
+  //
+  // 16-bit FNV-1a hash of a long filename
+  //
+  static uint16_t longname_hash(const char * const lname) {
+    uint32_t h = 0x811C9DC5;
+    for (uint8_t i = 0; i < LONG_FILENAME_LENGTH && lname[i]; i++)
+      h = (h ^ uint8_t(lname[i])) * 0x01000193;
+    return uint16_t(h ^ (h >> 16));
+  }
+
+  //
+  // Forget the index and any prefetched names. Called whenever the working
+  // directory changes or a file is added or removed.
+  //
+  void CardReader::invalidate_index() {
+    dir_index_valid = false;
+    #if ENABLED(SD_PREFETCH)
+      LOOP_L_N(i, SDCARD_DIR_PREFETCH) prefetched[i].state = PF_EMPTY;
+    #endif
+  }
+
+  //
+  // Read the working directory once, noting where each item starts.
+  // Items past the end of the index are counted but not stored.
+  //
+  void CardReader::build_index() {
+    dir_t p;
+    dir_index_count = dir_item_count = 0;
+    workDir.rewind();
+    for (;;) {
+      const uint32_t pos = workDir.curPosition();
+      if (workDir.readDir(&p, longFilename) <= 0) break;
+      if (!is_dir_or_gcode(p)) continue;
+      if (dir_index_count < SDCARD_DIR_INDEX_SIZE) {
+        dir_index_t &e = dir_index[dir_index_count++];
+        e.pos = pos;
+        createFilename(e.name, p);
+        e.isDir = flag.filenameIsDir;
+        e.hash = longname_hash(longFilename);
+      }
+      dir_item_count++;
+    }
+    dir_index_valid = true;
+  }
+
+  //
+  // Read an indexed item with a single seek. Return 'false' if the
+  // entry found there no longer matches the index.
+  //
+  bool CardReader::read_indexed(const uint16_t nr, char * const name, char * const lname) {
+    const dir_index_t &e = dir_index[nr];
+    dir_t p;
+    if (!workDir.seekSet(e.pos) || workDir.readDir(&p, lname) <= 0) return false;
+    createFilename(name, p);
+    return strcmp(name, e.name) == 0 && longname_hash(lname) == e.hash;
+  }
+
+  #if ENABLED(SD_PREFETCH)
+
+    //
+    // Queue an item to be read in the background. Takes the same
+    // index as getfilename_sorted(). The oldest queued item is replaced.
+    //
+    void CardReader::prefetch(uint16_t nr) {
+      #if ENABLED(SDCARD_SORT_ALPHA)
+        if (TERN1(SDSORT_GCODE, sort_alpha) && nr < sort_count) {
+          if (ENABLED(SDSORT_CACHE_NAMES)) return;    // Already in RAM
+          nr = sort_order[nr];
+        }
+      #endif
+      LOOP_L_N(i, SDCARD_DIR_PREFETCH)
+        if (prefetched[i].state != PF_EMPTY && prefetched[i].nr == nr) return;
+      dir_prefetch_t &f = prefetched[prefetch_head];
+      f.nr = nr;
+      f.state = PF_QUEUED;
+      if (++prefetch_head >= SDCARD_DIR_PREFETCH) prefetch_head = 0;
+    }
+
+    //
+    // Read one queued item, leaving media access free for printing
+    //
+    void CardReader::prefetch_task() {
+      if (!isMounted() || isPrinting() || !dir_index_valid) return;
+      LOOP_L_N(i, SDCARD_DIR_PREFETCH) {
+        dir_prefetch_t &f = prefetched[i];
+        if (f.state != PF_QUEUED) continue;
+        if (f.nr < dir_index_count && read_indexed(f.nr, f.name, f.longname)) {
+          f.isDir = dir_index[f.nr].isDir;
+          f.state = PF_READY;
+        }
+        else
+          f.state = PF_EMPTY;
+        return;
+      }
+    }
+
+    //
+    // Select a prefetched item, if it's ready
+    //
+    bool CardReader::take_prefetched(const uint16_t nr) {
+      LOOP_L_N(i, SDCARD_DIR_PREFETCH) {
+        const dir_prefetch_t &f = prefetched[i];
+        if (f.state == PF_READY && f.nr == nr) {
+          strcpy(filename, f.name);
+          memcpy(longFilename, f.longname, LONG_FILENAME_LENGTH);
+          flag.filenameIsDir = f.isDir;
+          return true;
+        }
+      }
+      return false;
+    }
+
+  #endif // SD_PREFETCH
+
+#endif // SDCARD_DIR_INDEX
+
 /**
  * Dive to the given DOS 8.3 file path, with optional echo of the dive paths.
  *
@@ -949,6 +1123,7 @@ const char* CardReader::diveToFile(const bool update_cwd, SdFile*& diveDir, cons
     workDir = *diveDir;
     DEBUG_ECHOLNPAIR("diveToFile: final workDir = ", hex_address((void*)diveDir));
     flag.workDirIsRoot = (workDirDepth == 0);
+    TERN_(SDCARD_DIR_INDEX, invalidate_index());
     TERN_(SDCARD_SORT_ALPHA, presort());
   }
 
@@ -964,6 +1139,7 @@ void CardReader::cd(const char * relpath) {
     flag.workDirIsRoot = false;
     if (workDirDepth < MAX_DIR_DEPTH)
       workDirParents[workDirDepth++] = workDir;
+    TERN_(SDCARD_DIR_INDEX, invalidate_index());
     TERN_(SDCARD_SORT_ALPHA, presort());
   }
   else {
@@ -975,6 +1151,7 @@ void CardReader::cd(const char * relpath) {
 int8_t CardReader::cdup() {
   if (workDirDepth > 0) {                                               // At least 1 dir has been saved
     workDir = --workDirDepth ? workDirParents[workDirDepth - 1] : root; // Use parent, or root if none
+    TERN_(SDCARD_DIR_INDEX, invalidate_index());
     TERN_(SDCARD_SORT_ALPHA, presort());
   }
   if (!workDirDepth) flag.workDirIsRoot = true;
@@ -984,6 +1161,7 @@ int8_t CardReader::cdup() {
 void CardReader::cdroot() {
   workDir = root;
   flag.workDirIsRoot = true;
+  TERN_(SDCARD_DIR_INDEX, invalidate_index());
   TERN_(SDCARD_SORT_ALPHA, presort());
 }
 
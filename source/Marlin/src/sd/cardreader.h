@@ -31,6 +31,10 @@
   #define SD_RESORT 1
 #endif
 
+#if ENABLED(SDCARD_DIR_INDEX) && SDCARD_DIR_PREFETCH > 0
+  #define SD_PREFETCH 1
+#endif
+
 #if ENABLED(SDCARD_RATHERRECENTFIRST) && DISABLED(SDCARD_SORT_ALPHA)
   #define SD_ORDER(N,C) ((C) - 1 - (N))
 #else
@@ -152,6 +156,14 @@ public:
     FORCE_INLINE static void getfilename_sorted(const uint16_t nr) { selectFileByIndex(nr); }
   #endif
 
+  #if ENABLED(SDCARD_DIR_INDEX)
+    static void invalidate_index();
+    #if ENABLED(SD_PREFETCH)
+      static void prefetch(uint16_t nr);    // Queue an item (by sort index) to be read while idle
+      static void prefetch_task();          // Read one queued item. Called from idle().
+    #endif
+  #endif
+
   #if ENABLED(POWER_LOSS_RECOVERY)
     static bool jobRecoverFileExists();
     static void openJobRecoveryFile(const bool read);
@@ -243,6 +255,41 @@ private:
 
   #endif // SDCARD_SORT_ALPHA
 
+  //
+  // Directory index of the working folder
+  //
+  #if ENABLED(SDCARD_DIR_INDEX)
+    typedef struct {
+      uint32_t pos;                   // Folder offset at which readDir() returns the item
+      char name[FILENAME_LENGTH];     // DOS 8.3 name
+      bool isDir;
+      uint16_t hash;                  // Long name hash, to notice a changed folder
+    } dir_index_t;
+
+    static dir_index_t dir_index[SDCARD_DIR_INDEX_SIZE];
+    static uint16_t dir_index_count,  // Number of indexed items
+                    dir_item_count;   // Number of items in the folder
+    static bool dir_index_valid;
+
+    static void build_index();
+    static bool read_indexed(const uint16_t nr, char * const name, char * const lname);
+
+    #if ENABLED(SD_PREFETCH)
+      enum PrefetchState : uint8_t { PF_EMPTY, PF_QUEUED, PF_READY };
+      typedef struct {
+        uint16_t nr;                  // Item index in the folder
+        PrefetchState state;
+        bool isDir;
+        char name[FILENAME_LENGTH], longname[LONG_FILENAME_LENGTH];
+      } dir_prefetch_t;
+
+      static dir_prefetch_t prefetched[SDCARD_DIR_PREFETCH];
+      static uint8_t prefetch_head;
+
+      static bool take_prefetched(const uint16_t nr);
+    #endif
+  #endif
+
   static Sd2Card sd2card;
   static SdVolume volume;
   static SdFile file;
@@ -275,7 +322,7 @@ private:
   //
   static bool is_dir_or_gcode(const dir_t &p);
   static int countItems(SdFile dir);
-  static void selectByIndex(SdFile dir, const uint8_t index);
+  static void selectByIndex(SdFile dir, const uint16_t index);
   static void selectByName(SdFile dir, const char * const match);
   static void printListing(SdFile parent, const char * const prepend=nullptr);
 
@@ -0,0 +1,175 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * FLASH_EEPROM_LOG on simulated flash
+ *
+ * Settings are saved over and over, mostly one changed value at a time as
+ * when babystepping Z. Now and then a flash write fails part way and the
+ * printer keeps going, or reboots. A reboot must load either the last
+ * save that succeeded or the one that failed, never a mix, and no later
+ * save may be lost behind a failed one.
+ *
+ * The store is included rather than linked so a reboot can clear its RAM.
+ */
+
+// sources: Marlin/src/libs/crc16.cpp framework/cores/flash.cpp Marlin/tests/host/flash_sim.cpp
+// sources: Marlin/src/HAL/shared/eeprom_api.cpp
+// flags: -no-pie -Wl,--unresolved-symbols=ignore-all
+
+#include "marlin_tests.h"
+#include "host/flash_sim.h"
+#include "../src/HAL/STM32/eeprom_flash.cpp"
+
+volatile uint8_t Planner::block_buffer_head, Planner::block_buffer_tail;
+
+#define SETTINGS_USED 700   // Bytes of EEPROM_SIZE the settings take
+
+static void reboot() { mounted = false; save_id = 0; }
+
+static bool save(const uint8_t *img) {
+  persistentStore.access_start();
+  int pos = 0;
+  uint16_t crc = 0;
+  persistentStore.write_data(pos, img, EEPROM_SIZE, &crc);
+  return persistentStore.access_finish();
+}
+
+static void load(uint8_t *img) {
+  persistentStore.access_start();
+  int pos = 0;
+  uint16_t crc = 0;
+  persistentStore.read_data(pos, img, EEPROM_SIZE, &crc);
+}
+
+static uint8_t committed[EEPROM_SIZE], want[EEPROM_SIZE], got[EEPROM_SIZE];
+
+MARLIN_TEST(settings_log, imports_the_eeprom_page) {
+  flash_sim_init();
+  reboot();
+  memset(committed, 0xFF, sizeof(committed));
+  for (int i = 0; i < SETTINGS_USED; i++) committed[i] = test_rand();
+  memcpy((void*)FLASH_EEPROM_BASE, committed, EEPROM_SIZE);
+
+  load(got);
+  TEST_ASSERT(!memcmp(got, committed, EEPROM_SIZE));
+  reboot();
+  load(got);
+  TEST_ASSERT(!memcmp(got, committed, EEPROM_SIZE));
+}
+
+MARLIN_TEST(settings_log, imports_the_stock_eeprom_page) {
+  flash_sim_init();
+  reboot();
+  memset(committed, 0xFF, sizeof(committed));
+  for (int i = 0; i < SETTINGS_USED; i++) committed[i] = test_rand();
+  memcpy((void*)FLASH_STOCK_EEPROM_BASE, committed, EEPROM_SIZE);
+
+  load(got);
+  TEST_ASSERT(!memcmp(got, committed, EEPROM_SIZE));
+
+  // Later boots read the log, not the stock page
+  memset((void*)FLASH_STOCK_EEPROM_BASE, 0x00, EEPROM_SIZE);
+  reboot();
+  load(got);
+  TEST_ASSERT(!memcmp(got, committed, EEPROM_SIZE));
+}
+
+MARLIN_TEST(settings_log, failed_writes_and_reboots) {
+  flash_sim_init();
+  reboot();
+  memset(committed, 0xFF, sizeof(committed));
+  load(got);
+
+  int saves = 0, failed = 0, torn = 0, lost = 0, small = 0;
+  uint32_t small_words = 0, max_words = 0;
+  for (int i = 0; i < 100000; i++) {
+    memcpy(want, committed, EEPROM_SIZE);
+    const bool one = test_rand() % 10 < 7;
+    if (one)
+      want[test_rand() % SETTINGS_USED] = test_rand();
+    else
+      for (int n = test_rand() % 40; n--;) want[test_rand() % SETTINGS_USED] = test_rand();
+
+    const bool fail = test_rand() % 50 == 0;
+    flash_sim_cut_after = fail ? test_rand() % 200 : -1;
+    const uint32_t w0 = flash_sim_words;
+    const bool ok = save(want);
+    flash_sim_cut_after = -1;
+
+    if (ok) {
+      memcpy(committed, want, EEPROM_SIZE);
+      saves++;
+      const uint32_t words = flash_sim_words - w0;
+      if (one) { small++; small_words += words; }
+      NOLESS(max_words, words);
+    }
+    else {
+      failed++;
+      if (test_rand() & 1) continue;  // Carry on, the next save writes it again
+
+      // After a reboot either the old or the new settings are fine
+      reboot();
+      load(got);
+      if (memcmp(got, committed, EEPROM_SIZE) && memcmp(got, want, EEPROM_SIZE)) torn++;
+      memcpy(committed, got, EEPROM_SIZE);
+      continue;
+    }
+
+    if (test_rand() % 3 == 0) HAL_idletask();
+
+    if (test_rand() % 20 == 0) {
+      reboot();
+      load(got);
+      if (memcmp(got, committed, EEPROM_SIZE)) lost++;
+    }
+  }
+  TEST_ASSERT(failed > 0);
+  TEST_ASSERT_EQUAL(0, torn);
+  TEST_ASSERT_EQUAL(0, lost);
+  TEST_ASSERT(!flash_sim_overwrite);
+  MEASURE("%d saves, %d failed, %u erases, %.1f words per one-value save, %u words at most",
+    saves, failed, flash_sim_erases, double(small_words) / small, max_words);
+}
+
+// A record that fails before any of it is programmed leaves a blank slot
+MARLIN_TEST(settings_log, save_after_a_blank_slot) {
+  flash_sim_init();
+  reboot();
+  memset(committed, 0xFF, sizeof(committed));
+  load(got);
+
+  committed[0] = 1;
+  TEST_ASSERT(save(committed));
+
+  memcpy(want, committed, EEPROM_SIZE);
+  want[0] = 2;
+  flash_sim_cut_after = 0;
+  TEST_ASSERT(!save(want));
+  flash_sim_cut_after = -1;
+
+  want[0] = 3;                        // Written after the blank slot
+  TEST_ASSERT(save(want));
+  reboot();
+  load(got);
+  TEST_ASSERT_EQUAL(3, got[0]);
+}
@@ -0,0 +1,181 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * Brown-out checkpoint against every flash user
+ *
+ * The ADC watchdog ISR is fired at a random point inside each kind of
+ * flash operation: a journal save, a journal erase, and the settings
+ * writes. It must never start a flash operation inside another one, and
+ * the checkpoint it asked for must be what the next boot loads.
+ *
+ * The latency test feeds a decaying 24V rail to the watchdog and reports
+ * the time from the threshold crossing to the checkpoint in flash, using
+ * the flash timings in host/flash_sim.h.
+ */
+
+// sources: Marlin/src/feature/plr_journal.cpp Marlin/src/libs/crc16.cpp framework/cores/flash.cpp
+// sources: Marlin/tests/host/flash_sim.cpp
+// flags: -no-pie -Wl,--unresolved-symbols=ignore-all
+
+#include "marlin_tests.h"
+#include "host/flash_sim.h"
+#include "feature/plr_journal.h"
+#include "module/planner.h"
+#include <string.h>
+
+volatile uint8_t Planner::block_buffer_head, Planner::block_buffer_tail;
+
+enum flash_user_t { SAVE, ERASE, SETTINGS_ERASE, SETTINGS_RECORD, SETTINGS_LEGACY, SETTINGS_EEPROM, FLASH_USERS };
+static const char * const user_name[FLASH_USERS] = {
+  "journal save", "journal erase", "settings erase", "settings record", "legacy settings", "eeprom flush"
+};
+
+static job_recovery_info_t info;
+static uint32_t stepper_sdpos;
+static int isr_countdown;         // Flash steps into the operation before the ISR fires
+static double isr_us;             // Flash time when it fired
+static bool isr_fired;
+
+// HAL_ADC_AWD_ISR
+static void brownout_isr() {
+  flash_sim_interrupt = nullptr;
+  isr_fired = true;
+  isr_us = flash_sim_us;
+  plr_journal.checkpoint(stepper_sdpos);
+}
+
+static void countdown() { if (!isr_countdown--) brownout_isr(); }
+
+// A print that has saved a few times and armed its checkpoint
+static void start_print(const int saves) {
+  flash_sim_init();
+  memset(&info, 0, sizeof(info));
+  plr_journal.load(info);
+  info.valid_head = info.valid_foot = 1;
+  strcpy(info.sd_filename, "/X.GCO");
+  for (int i = 0; i < saves; i++) {
+    info.sdpos += 40;
+    info.current_position.e += 1;
+    plr_journal.append(info);
+  }
+  info.current_position.e += 1;
+  plr_journal.arm(info);
+  stepper_sdpos = info.sdpos + 1234;
+}
+
+static void run_flash_user(const flash_user_t user) {
+  static uint8_t record[64];
+  memset(record, 0x5A, sizeof(record));
+  switch (user) {
+    case SAVE:
+      info.sdpos += 40;
+      plr_journal.append(info);
+      break;
+    case ERASE:
+      Planner::block_buffer_head = Planner::block_buffer_tail;
+      plr_journal.task();
+      break;
+    case SETTINGS_ERASE:  Intflash::FlashErasePage(FLASH_SETTINGS_BASE); break;
+    case SETTINGS_RECORD: Intflash::FlashProgram(FLASH_SETTINGS_BASE, record, sizeof(record)); break;
+    case SETTINGS_LEGACY: Intflash::Flash_Updata(FLASH_EEPROM_BASE, record, sizeof(record)); break;
+    case SETTINGS_EEPROM: Intflash::eeprom_buffer_flush(); break;
+    default: break;
+  }
+}
+
+// Steps (words or erases) the operation takes, so the ISR can land anywhere in it
+static int steps_of(const flash_user_t user) {
+  switch (user) {
+    case SAVE:            return 8;
+    case SETTINGS_RECORD:
+    case SETTINGS_LEGACY: return 16;
+    case SETTINGS_EEPROM: return EEPROM_SIZE / 4;
+    default:              return 1;
+  }
+}
+
+MARLIN_TEST(brownout, defers_to_every_flash_user) {
+  LOOP_L_N(u, FLASH_USERS) {
+    const flash_user_t user = flash_user_t(u);
+    int nested = 0, missed = 0, lost = 0;
+    for (int run = 0; run < 200; run++) {
+      // Fill the sector most of the way so a journal erase is due
+      start_print(user == ERASE ? 400 : 1 + test_rand() % 300);
+      isr_fired = false;
+      isr_countdown = test_rand() % steps_of(user);
+      flash_sim_interrupt = countdown;
+      run_flash_user(user);
+      flash_sim_interrupt = nullptr;
+
+      if (flash_sim_nested) nested++;
+      if (!isr_fired) { missed++; continue; }
+      job_recovery_info_t got;
+      if (!plr_journal.load(got) || got.sdpos != stepper_sdpos) lost++;
+    }
+    if (nested || missed || lost) printf("  %s: nested %d, missed %d, lost %d\n", user_name[u], nested, missed, lost);
+    TEST_ASSERT_EQUAL(0, nested);
+    TEST_ASSERT_EQUAL(0, missed);
+    TEST_ASSERT_EQUAL(0, lost);
+  }
+}
+
+MARLIN_TEST(brownout, idle_checkpoint) {
+  start_print(10);
+  TEST_ASSERT(plr_journal.checkpoint(stepper_sdpos));
+  TEST_ASSERT(!flash_sim_nested);
+  job_recovery_info_t got;
+  TEST_ASSERT(plr_journal.load(got));
+  TEST_ASSERT_EQUAL(stepper_sdpos, got.sdpos);
+}
+
+/**
+ * Time from the rail crossing the threshold to the checkpoint in flash.
+ * The watchdog samples at POWER_LOSS_BROWNOUT_FREQUENCY from a random
+ * phase, then the ISR waits for whatever holds the flash.
+ */
+MARLIN_TEST(brownout, latency) {
+  const double period_us = 1e6 / (POWER_LOSS_BROWNOUT_FREQUENCY),
+               threshold_v = (POWER_LOSS_ADC_THRESHOLD) * 3.3 / 4096 / (POWER_MONITOR_VOLTS_PER_VOLT),
+               dropout_v = 6;                      // Assumed rail voltage where the MCU supply gives out
+  double worst[FLASH_USERS + 1] = { 0 };
+  for (int run = 0; run < 600; run++) {
+    const int u = run % (FLASH_USERS + 1);        // FLASH_USERS means the flash is idle
+    const flash_user_t user = flash_user_t(u);
+    start_print(user == ERASE ? 400 : 1 + test_rand() % 300);
+    const double detect_us = test_randf(0, period_us);
+    flash_sim_us = 0;
+    if (u == FLASH_USERS)
+      brownout_isr();
+    else {
+      isr_fired = false;
+      isr_countdown = test_rand() % steps_of(user);
+      flash_sim_interrupt = countdown;
+      run_flash_user(user);
+      flash_sim_interrupt = nullptr;
+    }
+    NOLESS(worst[u], detect_us + flash_sim_us - isr_us);
+  }
+  LOOP_L_N(u, FLASH_USERS + 1)
+    MEASURE("during %-16s worst %6.0f us, the rail may fall at most %5.2f V/ms from %.1fV to %gV",
+      u < FLASH_USERS ? user_name[u] : "idle", worst[u], (threshold_v - dropout_v) * 1000 / worst[u], threshold_v, dropout_v);
+}
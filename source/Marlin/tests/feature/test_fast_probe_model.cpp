@@ -0,0 +1,243 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * G29_FAST_PROBING against stock G29, on a model of the Kobra
+ *
+ * The machine is the one test_sweep_model.cpp models from Configuration.h.
+ * Stock G29 is probe_at_point() with PROBE_PT_RAISE at each point. The
+ * sequence follows probe_at_point_fast() and run_z_probe(): the lift and
+ * the move to the next point are planned together, the fast touch falls
+ * from the travel height, the slow touch is the same as stock. Travel is
+ * low where G29 would choose it, with g29_predict() ported over. With
+ * G29_FAST_AGREE the slow touch is skipped the way run_z_probe() does it.
+ *
+ * Every travel is walked to find how close the probe comes to the bed.
+ */
+
+#include "marlin_tests.h"
+#include "inc/MarlinConfig.h"
+
+// Machine
+static const float accel[] = DEFAULT_MAX_ACCELERATION;
+#define AX        accel[X_AXIS]
+#define AY        accel[Y_AXIS]
+#define AZ        accel[Z_AXIS]
+#define VZ_MAX    20.0f
+#define V_XY      (XY_PROBE_SPEED / 60.0f)
+#define V_FAST    (Z_PROBE_SPEED_FAST / 60.0f)
+#define V_SLOW    (Z_PROBE_SPEED_SLOW / 60.0f)
+#define DELAY_1ST 0.1f    // (s) BLOCK_DELAY_FOR_1ST_MOVE with fewer than 3 blocks
+#define TARE_S    0.4f    // (s) The AUTO_LEVEL_TX_PIN pulse
+
+// Grid
+#define N   GRID_MAX_POINTS_X
+#define X0  10.0f
+#define Y0  10.0f
+#define X1  210.0f
+#define Y1  220.0f
+#define CLR   Z_CLEARANCE_BETWEEN_PROBES
+#define MULTI Z_CLEARANCE_MULTI_PROBE
+#define AGREE 0.02f       // The commented-out G29_FAST_AGREE
+
+// Probe (mm). Fast touches land deeper than slow ones.
+#define FAST_OFS  -0.030f
+#define FAST_SD    0.006f
+#define SLOW_OFS  -0.012f
+#define SLOW_SD    0.003f
+
+static float gauss(const float sd) {
+  const float u = test_randf(1e-6f, 1), v = test_randf(0, 1);
+  return sd * sqrtf(-2 * logf(u)) * cosf(2 * M_PI * v);
+}
+
+static float trap(const float l, const float v, const float a) {
+  if (l <= 0) return 0;
+  return l > v * v / a ? l / v + v / a : 2 * sqrtf(l / a);
+}
+
+static float move(const float dx, const float dy, const float dz, const float f) {
+  const float l = sqrtf(dx * dx + dy * dy + dz * dz);
+  if (!l) return 0;
+  float a = 1e9f;
+  if (dx) NOMORE(a, AX * l / fabsf(dx));
+  if (dy) NOMORE(a, AY * l / fabsf(dy));
+  if (dz) NOMORE(a, AZ * l / fabsf(dz));
+  return trap(l, dz ? _MIN(f, VZ_MAX * l / fabsf(dz)) : f, a);
+}
+
+// From rest into a touch after d, stopping dead
+static float into(const float d, const float v) {
+  return d > v * v / (2 * AZ) ? d / v + v / (2 * AZ) : sqrtf(2 * d / AZ);
+}
+
+struct bed_t {
+  float tx, ty, bowl;
+  float z(const float x, const float y) const {
+    const float u = (x - 110) / 110, w = (y - 110) / 110;
+    return tx * u + ty * w + bowl * (u * u + w * w);
+  }
+};
+
+typedef struct { float s, rms, gap, low_gap; int low, skipped; } run_t;
+
+// Stock fast touch, raise, slow touch, from rest at 'fall' over the bed
+static float touches_s(const float fall) {
+  return TARE_S + DELAY_1ST + into(fall, V_FAST) + DELAY_1ST + move(0, 0, MULTI, V_FAST)
+       + TARE_S + DELAY_1ST + into(MULTI, V_SLOW);
+}
+
+// Lowest probe height over the bed along a straight travel
+static float travel_gap(const bed_t &bed, const float x0, const float y0, const float z0, const float x1, const float y1, const float z1) {
+  float gap = 1e9f;
+  for (int i = 0; i <= 100; i++) {
+    const float f = i / 100.0f, x = x0 + (x1 - x0) * f, y = y0 + (y1 - y0) * f;
+    NOMORE(gap, z0 + (z1 - z0) * f - bed.z(x, y));
+  }
+  return gap;
+}
+
+// g29_predict(), on grid indexes with the serpentine G29 runs
+static float predict(const float (&pz)[N][N], const int mx, const int my, const int inx, bool &flat) {
+  auto at = [&](const int x, const int y) { return WITHIN(x, 0, N - 1) && WITHIN(y, 0, N - 1) ? pz[x][y] : NAN; };
+  auto same = [](const float p, const float q) { return ABS(p - q) <= G29_FAST_FLAT; };
+  const float a = at(mx - inx, my), a2 = at(mx - 2 * inx, my),
+              b = at(mx, my - 1), b2 = at(mx, my - 2),
+              c = at(mx - inx, my - 1);
+  flat = false;
+  if (!isnan(a) && !isnan(b) && !isnan(c)) { flat = same(a, c) && same(b, c); return a + b - c; }
+  if (!isnan(a) && !isnan(a2)) { flat = same(a, a2); return a * 2 - a2; }
+  if (!isnan(b) && !isnan(b2)) { flat = same(b, b2); return b * 2 - b2; }
+  return NAN;
+}
+
+// One G29, stock or sequenced, with the given low travel clearance
+static run_t g29(const bed_t &bed, const bool fast, const bool agree, const float clearance) {
+  run_t r = { 0, 0, 1e9f, 1e9f, 0, 0 };
+  float pz[N][N];
+  LOOP_L_N(x, N) LOOP_L_N(y, N) pz[x][y] = NAN;
+  float px = X0, py = Y0, z = bed.z(X0, Y0) + CLR, last_miss = NAN, bias = 0, e2 = 0;
+  int bias_n = 0;
+  bool first = true;
+
+  for (int gy = 0; gy < N; gy++) for (int k = 0; k < N; k++) {
+    const int inx = (gy & 1) ? -1 : 1, gx = inx > 0 ? k : N - 1 - k;
+    const float x = X0 + (X1 - X0) * gx / (N - 1), y = Y0 + (Y1 - Y0) * gy / (N - 1), bz = bed.z(x, y);
+    bool flat;
+    const float predicted = predict(pz, gx, gy, inx, flat);
+    float travel_z;
+
+    if (!fast || first) {                 // do_blocking_move_to() at the height left by the last point
+      travel_z = z;
+      r.s += DELAY_1ST + move(x - px, y - py, 0, V_XY);
+    }
+    else {                                // Lift, then climb or descend on the way
+      const bool low = !isnan(predicted) && (flat || last_miss <= G29_FAST_FLAT);
+      travel_z = low ? predicted + clearance : z + CLR;
+      if (low) r.low++;
+      r.s += DELAY_1ST + move(0, 0, clearance, V_FAST) + move(x - px, y - py, travel_z - (z + clearance), V_XY);
+      const float g = travel_gap(bed, px, py, z + clearance, x, y, travel_z);
+      NOMORE(r.gap, g);
+      if (low) NOMORE(r.low_gap, g);
+    }
+    if (!fast && !first) NOMORE(r.gap, travel_gap(bed, px, py, z, x, y, z));
+    first = false;
+
+    // Fast touch from the travel height, then maybe the slow one
+    const float fast_z = bz + FAST_OFS + gauss(FAST_SD);
+    float result;
+    if (agree && !isnan(predicted) && bias_n >= 2 && ABS(fast_z + bias - predicted) <= AGREE) {
+      r.s += TARE_S + DELAY_1ST + into(travel_z - fast_z, V_FAST);
+      result = fast_z + bias;
+      r.skipped++;
+    }
+    else {
+      r.s += touches_s(travel_z - fast_z);
+      const float slow_z = bz + SLOW_OFS + gauss(SLOW_SD);
+      result = (fast_z * 2 + slow_z * 3) / 5;
+      bias = (bias * bias_n + result - fast_z) / (bias_n + 1);
+      bias_n++;
+    }
+    if (!isnan(predicted)) last_miss = ABS(result - predicted);
+    pz[gx][gy] = result;
+    e2 += sq(result - (bz + (2 * FAST_OFS + 3 * SLOW_OFS) / 5));
+
+    // Stock raises off each point; the sequence stays at the touch
+    z = fast ? result : result + CLR;
+    if (!fast) r.s += DELAY_1ST + move(0, 0, CLR, V_FAST);
+    px = x; py = y;
+  }
+  if (fast) r.s += DELAY_1ST + move(0, 0, CLR, V_FAST);   // fast_end()
+  r.rms = sqrtf(e2 / (N * N));
+  return r;
+}
+
+typedef struct { const char *name; float tilt, bowl; } shape_t;
+static const shape_t shapes[] = {
+  { "flat",          0.05f, 0.02f },
+  { "tilted 0.3mm",  0.3f,  0.03f },
+  { "bowl 0.15mm",   0.05f, 0.15f },
+  { "warped",        0.6f,  0.4f  },
+  { "out of tram",   2.0f,  0.5f  }
+};
+
+static run_t average(const shape_t &sh, const bool fast, const bool agree, const float clearance) {
+  const int beds = 50;
+  run_t a = { 0, 0, 1e9f, 1e9f, 0, 0 };
+  test_srand(1);
+  for (int b = 0; b < beds; b++) {
+    const bed_t bed = { sh.tilt * test_randf(-1, 1), sh.tilt * test_randf(-1, 1), sh.bowl * test_randf(-1, 1) };
+    const run_t r = g29(bed, fast, agree, clearance);
+    a.s += r.s / beds; a.rms += r.rms / beds;
+    a.low += r.low; a.skipped += r.skipped;
+    NOMORE(a.gap, r.gap); NOMORE(a.low_gap, r.low_gap);
+  }
+  a.low /= beds; a.skipped /= beds;
+  return a;
+}
+
+// The default sequence keeps both touches, so most of the stock time is still
+// there. Only G29_FAST_AGREE halves it.
+MARLIN_TEST(fast_probe_model, default_time) {
+  for (auto &sh : shapes) {
+    const run_t stock = average(sh, false, false, G29_FAST_CLEARANCE),
+                seq = average(sh, true, false, G29_FAST_CLEARANCE),
+                agree = average(sh, true, true, G29_FAST_CLEARANCE);
+    TEST_ASSERT(seq.s < stock.s);
+    TEST_ASSERT(agree.s * 2 < stock.s);
+    TEST_ASSERT_WITHIN(0.0005f, stock.rms, seq.rms);
+    MEASURE("%-13s stock %5.1f s | default %5.1f s (%.2fx) %2d low | AGREE %5.1f s (%.2fx) %2d skipped, rms %.1f -> %.1f um",
+      sh.name, stock.s, seq.s, stock.s / seq.s, seq.low, agree.s, stock.s / agree.s, agree.skipped, stock.rms * 1000, agree.rms * 1000);
+  }
+}
+
+// The low travel only has to clear the prediction error on points where it held
+MARLIN_TEST(fast_probe_model, travel_clearance) {
+  static const float clearances[] = { 1.0f, G29_FAST_CLEARANCE, CLR };
+  for (auto &sh : shapes) {
+    for (const float c : clearances) {
+      const run_t seq = average(sh, true, false, c);
+      if (c == G29_FAST_CLEARANCE) TEST_ASSERT(seq.gap > G29_FAST_CLEARANCE * 0.5f);
+      MEASURE("%-13s clearance %.1f mm: %5.1f s, closest %.2f mm, on low travel %.2f mm", sh.name, c, seq.s, seq.gap, seq.low ? seq.low_gap : NAN);
+    }
+  }
+}
@@ -0,0 +1,84 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * ABL_MESH_SLOTS packing of the bilinear grid
+ *
+ * A mesh must come back from its packed bytes as it went in, to the micron.
+ * Data that is cut short or runs over must be refused without touching the
+ * mesh in RAM, so M424 can leave the current leveling in place.
+ */
+
+// sources: Marlin/src/feature/bedlevel/abl/abl.cpp
+// flags: -no-pie -Wl,--unresolved-symbols=ignore-all
+
+#include "marlin_tests.h"
+#include "inc/MarlinConfig.h"
+#include "feature/bedlevel/bedlevel.h"
+
+#if ENABLED(EXTENSIBLE_UI)
+  #include "lcd/extui/ui_api.h"
+  void ExtUI::onMeshUpdate(const int8_t, const int8_t, const float) {}
+#endif
+
+static void make_mesh(const float tilt) {
+  GRID_LOOP(x, y) z_values[x][y] = tilt * x - 0.5f * tilt * y + ((x * 7 + y * 3) % 5) * 0.013f;
+}
+
+static bool same_mesh(const bed_mesh_t &a, const bed_mesh_t &b) {
+  GRID_LOOP(x, y) {
+    if (isnan(a[x][y]) != isnan(b[x][y])) return false;
+    if (!isnan(a[x][y]) && ABS(a[x][y] - b[x][y]) > 0.0006f) return false;
+  }
+  return true;
+}
+
+MARLIN_TEST(mesh_pack, round_trip) {
+  uint8_t buf[GRID_MAX_POINTS_X * GRID_MAX_POINTS_Y * 5];
+  make_mesh(0.05f);
+  z_values[1][2] = NAN;
+  bed_mesh_t packed;
+  COPY(packed, z_values);
+  const uint16_t n = bed_level_pack(buf, sizeof(buf));
+  TEST_ASSERT(n > 0);
+  MEASURE("%d points packed into %u bytes", GRID_MAX_POINTS_X * GRID_MAX_POINTS_Y, n);
+
+  GRID_LOOP(x, y) z_values[x][y] = 9;
+  TEST_ASSERT(bed_level_unpack(buf, n));
+  TEST_ASSERT(same_mesh(packed, z_values));
+}
+
+MARLIN_TEST(mesh_pack, bad_data_leaves_the_mesh) {
+  uint8_t buf[GRID_MAX_POINTS_X * GRID_MAX_POINTS_Y * 5];
+  make_mesh(0.2f);
+  const uint16_t n = bed_level_pack(buf, sizeof(buf));
+  TEST_ASSERT(n > 1);
+
+  make_mesh(-0.1f);
+  bed_mesh_t current;
+  COPY(current, z_values);
+  TEST_ASSERT(!bed_level_unpack(buf, n - 1));     // Cut short
+  TEST_ASSERT(same_mesh(current, z_values));
+  buf[n] = 0x01;
+  TEST_ASSERT(!bed_level_unpack(buf, n + 1));     // Runs over
+  TEST_ASSERT(same_mesh(current, z_values));
+}
@@ -0,0 +1,113 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * Power-loss journal on simulated flash
+ *
+ * A print saves its state over and over while the power fails at random
+ * points inside a write and the printer reboots at random. After every
+ * reboot the journal must give back the last state it reported as saved.
+ */
+
+// sources: Marlin/src/feature/plr_journal.cpp Marlin/src/libs/crc16.cpp framework/cores/flash.cpp
+// sources: Marlin/tests/host/flash_sim.cpp
+// flags: -no-pie -Wl,--unresolved-symbols=ignore-all
+
+#include "marlin_tests.h"
+#include "host/flash_sim.h"
+#include "feature/plr_journal.h"
+#include "module/planner.h"
+#include <string.h>
+
+volatile uint8_t Planner::block_buffer_head, Planner::block_buffer_tail;
+
+// The fields a print changes between saves, and now and then one that isn't in a delta
+static void advance(job_recovery_info_t &info) {
+  info.sdpos += 37;
+  info.current_position.z += 0.01f;
+  info.current_position.e += 1.5f;
+  info.print_job_elapsed += 1000;
+  if (!++info.valid_head) ++info.valid_head;
+  info.valid_foot = info.valid_head;
+  if (test_rand() % 50 == 0) info.zraise = test_rand() % 5;
+  if (test_rand() % 70 == 0) strcpy(info.sd_filename, test_rand() & 1 ? "/A.GCO" : "/B.GCO");
+}
+
+MARLIN_TEST(plr_journal, empty_flash_has_nothing) {
+  flash_sim_init();
+  job_recovery_info_t got;
+  TEST_ASSERT(!plr_journal.load(got));
+}
+
+MARLIN_TEST(plr_journal, legacy_outage_data_is_ignored) {
+  flash_sim_init();
+  memset((void*)uintptr_t(FLASH_OUTAGE_DATA_ADDR), 0x12, 400);    // Raw info from the old firmware
+  job_recovery_info_t info, got;
+  memset(&info, 0, sizeof(info));
+  TEST_ASSERT(!plr_journal.load(got));
+
+  // The sector is treated as full, so saving still works
+  advance(info);
+  TEST_ASSERT(plr_journal.append(info));
+  TEST_ASSERT(plr_journal.load(got));
+  TEST_ASSERT(!memcmp(&got, &info, sizeof(info)));
+}
+
+MARLIN_TEST(plr_journal, survives_power_cuts) {
+  flash_sim_init();
+  job_recovery_info_t info, got, last_ok;
+  memset(&info, 0, sizeof(info));
+  plr_journal.load(got);
+
+  bool have_ok = false;
+  int cuts = 0, mismatches = 0, lost = 0;
+  const int saves = 20000;
+  for (int i = 0; i < saves; i++) {
+    advance(info);
+
+    // Let idle() erase ahead when the planner runs dry
+    Planner::block_buffer_head = Planner::block_buffer_tail + (test_rand() % 20 != 0);
+    plr_journal.task();
+
+    const bool cut = test_rand() % 97 == 0;
+    if (cut) flash_sim_cut_after = test_rand() % 20;
+    if (plr_journal.append(info)) { memcpy(&last_ok, &info, sizeof(info)); have_ok = true; }
+    else cuts++;
+    flash_sim_cut_after = -1;
+
+    if (cut || test_rand() % 10 == 0) {       // Reboot
+      if (plr_journal.load(got) != have_ok) lost++;
+      else if (have_ok && memcmp(&got, &last_ok, sizeof(got))) mismatches++;
+      if (test_rand() % 200 == 0) {
+        plr_journal.clear();
+        have_ok = false;
+        if (plr_journal.load(got)) lost++;
+      }
+    }
+  }
+  TEST_ASSERT(cuts > 0);
+  TEST_ASSERT_EQUAL(0, lost);
+  TEST_ASSERT_EQUAL(0, mismatches);
+  TEST_ASSERT(!flash_sim_overwrite);
+  MEASURE("%d saves, %d cut short, %u words programmed, %u sector erases",
+    saves, cuts, flash_sim_words, flash_sim_erases);
+}
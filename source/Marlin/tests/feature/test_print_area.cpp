@@ -0,0 +1,159 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/**
+ * G29 A print area from the first layer of generated slicer files
+ *
+ * Each file has its slicer's header comments, a purge line in the start
+ * G-code and a part of known extents. Only the part may count, and header
+ * lines like ";LAYER_COUNT:" must not be taken for layer marks.
+ */
+
+// sources: Marlin/src/feature/print_area.cpp
+
+#include "marlin_tests.h"
+#include "feature/print_area.h"
+#include <stdarg.h>
+#include <string.h>
+
+// The SD file, in memory
+static char gcode[1 << 20];
+static uint32_t gcode_len, gcode_pos;
+static uint32_t idle_calls;
+
+bool SdBaseFile::seekSet(const uint32_t pos) { gcode_pos = pos; return pos <= gcode_len; }
+
+int16_t SdBaseFile::read(void *buf, uint16_t nbyte) {
+  NOMORE(nbyte, gcode_len - gcode_pos);
+  memcpy(buf, gcode + gcode_pos, nbyte);
+  gcode_pos += nbyte;
+  return nbyte;
+}
+
+bool SdBaseFile::close() { return true; }
+
+void idle(TERN_(ADVANCED_PAUSE_FEATURE, bool)) { idle_calls++; }
+uint32_t millis() { return 0; }
+
+void serialprintPGM(PGM_P str) { fputs(str, stdout); }
+void serial_echopair_PGM(PGM_P const s_P, unsigned int v) { printf("%s%u", s_P, v); }
+void serial_echopair_PGM(PGM_P const s_P, float v) { printf("%s%.2f", s_P, v); }
+
+static void emit(const char * const fmt, ...) {
+  va_list args;
+  va_start(args, fmt);
+  gcode_len += vsnprintf(gcode + gcode_len, sizeof(gcode) - gcode_len, fmt, args);
+  va_end(args);
+}
+
+enum slicer_t { CURA, PRUSA, S3D, UNMARKED };
+
+// Start G-code with a purge line along X0.5-1.0, Y20-200
+static void start(const slicer_t slicer) {
+  gcode_len = 0;
+  switch (slicer) {
+    case CURA:
+      emit(";FLAVOR:Marlin\n;TIME:1234\n;Filament used: 1.2m\n;Layer height: 0.2\n;LAYER_COUNT:5\n");
+      break;
+    case PRUSA:
+      emit("; generated by PrusaSlicer 2.3.0+win64 on 2021-03-01 at 10:00:00 UTC\n\n");
+      emit("; external perimeters extrusion width = 0.45mm\n; first layer extrusion width = 0.42mm\n\n");
+      break;
+    case S3D:
+      emit("; G-Code generated by Simplify3D(R) Version 4.1.2\n;   layerHeight,0.2\n;   topSolidLayers,3\n");
+      emit(";   firstLayerHeightPercentage,100\n");
+      break;
+    case UNMARKED: break;
+  }
+  emit("M140 S60\nM104 S200\nG28\nG29 A\nG92 E0\n");
+  emit("G1 Z0.3 F3000\nG1 X0.5 Y20 F6000\nG1 X0.5 Y200 E15 F1500 ; purge\nG1 X1.0 Y200\nG1 X1.0 Y20 E15\nG92 E0\n");
+}
+
+// A serpentine part centered on cx, cy, ending in an arc that G29 A bounds by its whole circle
+static void part(const slicer_t slicer, const float cx, const float cy, const float w, const float h, const int layers) {
+  float e = 0;
+  for (int l = 0; l < layers; l++) {
+    const float z = 0.2f + l * 0.2f;
+    switch (slicer) {
+      case CURA:  emit(";LAYER:%d\n", l); break;
+      case PRUSA: emit(";LAYER_CHANGE\n;Z:%.2f\n;HEIGHT:0.2\n", z); break;
+      case S3D:   emit("; layer %d, Z = %.3f\n", l + 1, z); break;
+      case UNMARKED: break;
+    }
+    emit("G0 F6000 X%.3f Y%.3f Z%.3f\n", cx - w / 2, cy - h / 2, z);
+    for (int k = 0; k < 40; k++)
+      emit("G1 X%.3f Y%.3f E%.5f\n", cx + (k & 1 ? w : -w) / 2, cy - h / 2 + h * k / 39, e += 1);
+    emit("G2 X%.3f Y%.3f I5 J0 E%.5f\n", cx - w / 2 + 10, cy - h / 2, e += 0.5f);
+    emit("G1 E%.5f F2400\n", e -= 0.8f);
+  }
+  emit("M107\nM104 S0\n");
+}
+
+static bool scan(xy_pos_t &lf, xy_pos_t &rb) {
+  SdFile f;
+  print_area.start(f);
+  idle_calls = 0;
+  return print_area.get(lf, rb);
+}
+
+MARLIN_TEST(print_area, slicer_layer_marks) {
+  static const slicer_t slicers[] = { CURA, PRUSA, S3D };
+  for (const slicer_t s : slicers) {
+    start(s);
+    part(s, 170, 160, 30, 20, 5);
+    xy_pos_t lf, rb;
+    TEST_ASSERT(scan(lf, rb));
+    TEST_ASSERT_WITHIN(0.01, 155, lf.x);
+    TEST_ASSERT_WITHIN(0.01, 150, lf.y);
+    TEST_ASSERT_WITHIN(0.01, 195, rb.x);   // The arc's circle, center 190,170 radius 5
+    TEST_ASSERT_WITHIN(0.01, 175, rb.y);
+  }
+}
+
+// With no marks the purge line is part of the first layer
+MARLIN_TEST(print_area, unmarked_includes_purge) {
+  start(UNMARKED);
+  part(UNMARKED, 110, 105, 50, 50, 3);
+  xy_pos_t lf, rb;
+  TEST_ASSERT(scan(lf, rb));
+  TEST_ASSERT_WITHIN(0.01, 0.5, lf.x);
+  TEST_ASSERT_WITHIN(0.01, 20, lf.y);
+  TEST_ASSERT_WITHIN(0.01, 145, rb.x);
+  TEST_ASSERT_WITHIN(0.01, 200, rb.y);
+}
+
+// A first layer cut off by G29_ADAPTIVE_SCAN_BYTES is no area, and each block yields
+MARLIN_TEST(print_area, scan_limit_and_idle) {
+  start(CURA);
+  emit(";LAYER:0\nG0 X100 Y100 Z0.2\n");
+  for (uint32_t i = 0; gcode_len < (G29_ADAPTIVE_SCAN_BYTES) + 1000; i++)
+    emit("G1 X%.3f Y%.3f E%.5f\n", 100 + 20 * sin(i), 100 + 20 * cos(i), i * 0.01f);
+  xy_pos_t lf, rb;
+  TEST_ASSERT(!scan(lf, rb));
+  TEST_ASSERT_EQUAL(uint32_t(G29_ADAPTIVE_SCAN_BYTES) / 512, idle_calls);
+
+  emit(";LAYER:1\nG1 X100 Y100 Z0.4 E99999\n");
+  const uint64_t t = test_micros();
+  TEST_ASSERT(!scan(lf, rb));
+  MEASURE("%u KB scanned in %.1f ms on the host", unsigned(G29_ADAPTIVE_SCAN_BYTES) / 1024, (test_micros() - t) / 1e3);
+}
@@ -0,0 +1,266 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/**
+ * G29 U sweep probing against stock G29, on a model of the Kobra
+ *
+ * The machine is modelled from Configuration.h: accelerations, probing
+ * speeds and the 5x5 grid over 200x210 mm. Moves are trapezoids, touches
+ * stop dead, and a move starting from rest waits
+ * BLOCK_DELAY_FOR_1ST_MOVE unless the planner has three blocks. The sweep
+ * follows Probe::sweep() with the G29_SWEEP_* settings and the grid is
+ * fitted the way g29_sweep_fit() does it.
+ *
+ * A nozzle probe's strain gauge drifts between tares. That drift has not
+ * been measured on the printer, so the model assumes an offset that
+ * creeps and wanders with each touch, and compares one tare for the whole
+ * sweep with a tare at each row start.
+ */
+
+#include "marlin_tests.h"
+#include "inc/MarlinConfig.h"
+
+// Machine
+static const float accel[] = DEFAULT_MAX_ACCELERATION;
+#define AX        accel[X_AXIS]
+#define AY        accel[Y_AXIS]
+#define AZ        accel[Z_AXIS]
+#define VZ_MAX    20.0f
+#define V_XY      (XY_PROBE_SPEED / 60.0f)
+#define V_FAST    (Z_PROBE_SPEED_FAST / 60.0f)
+#define V_SLOW    (Z_PROBE_SPEED_SLOW / 60.0f)
+#define DELAY_1ST 0.1f    // (s) BLOCK_DELAY_FOR_1ST_MOVE with fewer than 3 blocks
+#define TARE_S    0.4f    // (s) The AUTO_LEVEL_TX_PIN pulse
+
+// Grid
+#define N   GRID_MAX_POINTS_X
+#define X0  10.0f
+#define Y0  10.0f
+#define X1  210.0f
+#define Y1  220.0f
+#define CLR Z_CLEARANCE_BETWEEN_PROBES
+
+// Probe (mm). Fast touches land deeper than slow ones.
+#define FAST_OFS  -0.030f
+#define FAST_SD    0.006f
+#define SLOW_OFS  -0.012f
+#define SLOW_SD    0.003f
+#define MOVE_SD    0.010f   // A touch on the move
+#define FULL_OFS  ((3 * SLOW_OFS + 2 * FAST_OFS) / 5)   // Weighted fast+slow, what stock G29 stores
+
+// Assumed gauge drift per touch since the last tare (mm)
+#define DRIFT_CREEP 0.0005f
+#define DRIFT_WALK  0.0015f
+
+static float gauss(const float sd) {
+  const float u = test_randf(1e-6f, 1), v = test_randf(0, 1);
+  return sd * sqrtf(-2 * logf(u)) * cosf(2 * M_PI * v);
+}
+
+static float trap(const float l, const float v, const float a) {
+  if (l <= 0) return 0;
+  return l > v * v / a ? l / v + v / a : 2 * sqrtf(l / a);
+}
+
+static float move_accel(const float dx, const float dy, const float dz) {
+  const float l = sqrtf(dx * dx + dy * dy + dz * dz);
+  float a = 1e9f;
+  if (dx) NOMORE(a, AX * l / fabsf(dx));
+  if (dy) NOMORE(a, AY * l / fabsf(dy));
+  if (dz) NOMORE(a, AZ * l / fabsf(dz));
+  return a;
+}
+
+static float move_speed(const float dx, const float dy, const float dz, const float f) {
+  const float l = sqrtf(dx * dx + dy * dy + dz * dz);
+  return dz ? _MIN(f, VZ_MAX * l / fabsf(dz)) : f;
+}
+
+static float move(const float dx, const float dy, const float dz, const float f) {
+  const float l = sqrtf(dx * dx + dy * dy + dz * dz);
+  return l ? trap(l, move_speed(dx, dy, dz, f), move_accel(dx, dy, dz)) : 0;
+}
+
+// From rest into a touch after d, stopping dead
+static float into(const float d, const float v, const float a) {
+  return d > v * v / (2 * a) ? d / v + v / (2 * a) : sqrtf(2 * d / a);
+}
+
+struct bed_t {
+  float tx, ty, bowl;
+  float z(const float x, const float y) const {
+    const float u = (x - 110) / 110, w = (y - 110) / 110;
+    return tx * u + ty * w + bowl * (u * u + w * w);
+  }
+};
+
+// A regular fast+slow probe from rest. probe_down_to_z() tares before each touch.
+static float regular_probe_s(const float fall) {
+  return TARE_S + DELAY_1ST + into(fall, V_FAST, AZ) + DELAY_1ST + move(0, 0, CLR, V_FAST)
+       + TARE_S + DELAY_1ST + into(CLR, V_SLOW, AZ);
+}
+
+static float stock_s() {
+  const float spx = (X1 - X0) / (N - 1), spy = (Y1 - Y0) / (N - 1);
+  float t = 0, x = X0, y = Y0;
+  for (int gy = 0; gy < N; gy++) for (int k = 0; k < N; k++) {
+    const float px = X0 + spx * ((gy & 1) ? N - 1 - k : k), py = Y0 + spy * gy;
+    t += DELAY_1ST + move(px - x, py - y, 0, V_XY) + regular_probe_s(CLR) + DELAY_1ST + move(0, 0, CLR, V_FAST);
+    x = px; y = py;
+  }
+  return t;
+}
+
+typedef struct { float x, y, z; } sample_t;
+static sample_t samples[G29_SWEEP_MAX_SAMPLES];
+
+// Probe::sweep() on the model. Returns the time and fills samples.
+static float sweep_s(const bed_t &bed, const bool tare_rows, int &n) {
+  float drift = 0, creep = 0;
+  auto gauge = [&]{ creep += DRIFT_CREEP; drift += gauss(DRIFT_WALK); return creep + drift; };
+  auto tare = [&]{ creep = drift = 0; return TARE_S; };
+
+  float x = X0, y = Y0, t = regular_probe_s(CLR);
+  const float full = bed.z(x, y) + FULL_OFS + gauss(SLOW_SD);
+  t += DELAY_1ST + move(0, 0, G29_SWEEP_LIFT, V_FAST) + tare() + DELAY_1ST + into(G29_SWEEP_LIFT, V_FAST, AZ);
+  float z = bed.z(x, y) + FAST_OFS + gauss(FAST_SD);
+  const float bias = full - z;
+  float touch_z = z;
+  n = 0;
+  samples[n++] = { x, y, full };
+
+  for (int r = 0; r < G29_SWEEP_ROWS; r++) {
+    const float dir = (r & 1) ? -1 : 1, end_x = (r & 1) ? X0 : X1;
+    if (r) {
+      const float ny = Y0 + (Y1 - Y0) * r / (G29_SWEEP_ROWS - 1);
+      t += move(0, 0, touch_z + CLR - z, V_FAST) + move(0, ny - y, 0, V_XY);
+      if (tare_rows) t += tare();
+      z = touch_z + CLR;
+      y = ny;
+    }
+    for (bool touched = !r; n < G29_SWEEP_MAX_SAMPLES;) {
+      float left = (end_x - x) * dir;
+      if (touched) {
+        if (left < 0.1f) break;
+        const float dx = _MIN(left, _MAX(0.0f, float(G29_SWEEP_SPACING) - (G29_SWEEP_LIFT) * (G29_SWEEP_FEEDRATE) / V_FAST)),
+                    dz = touch_z + (G29_SWEEP_LIFT) - z;
+        t += move(dx, 0, dz, dx ? (G29_SWEEP_FEEDRATE) * HYPOT(dx, dz) / dx : V_FAST);
+        x += dir * dx; z += dz; left -= dx;
+      }
+      const float start_z = z, drop = start_z - (touch_z - (G29_SWEEP_DEPTH)),
+                  dx = start_z <= touch_z + (G29_SWEEP_LIFT) + 0.01f ? _MIN(left, drop * (G29_SWEEP_FEEDRATE) / V_FAST) : 0,
+                  l = HYPOT(dx, drop);
+
+      // Walk the fall to where the (drifted) trigger point meets the bed
+      const float trigger = FAST_OFS - gauge();
+      float hit = -1;
+      for (int i = 1; i <= 1000; i++) {
+        const float f = i / 1000.0f;
+        if (start_z - drop * f <= bed.z(x + dir * dx * f, y) + trigger) { hit = f; break; }
+      }
+      if (hit < 0) {                      // Nothing in reach: regular probe from where the fall ended
+        t += move(dx, 0, drop, V_FAST * l / drop) + regular_probe_s(CLR);
+        tare();
+        x += dir * dx;
+        z = bed.z(x, y) + FULL_OFS + gauss(SLOW_SD);
+        samples[n++] = { x, y, z };
+      }
+      else {
+        t += into(hit * l, move_speed(dx, 0, drop, V_FAST * l / drop), move_accel(dx, 0, drop));
+        x += dir * dx * hit;
+        z = start_z - drop * hit + gauss(MOVE_SD);
+        samples[n++] = { x, y, z + bias };
+      }
+      touch_z = z;
+      touched = true;
+    }
+  }
+  return t + move(0, 0, CLR, V_FAST);
+}
+
+// g29_sweep_fit(): weighted local plane through the samples around each point
+static float fit(const int n, const float px, const float py) {
+  const float rx = 2 * (G29_SWEEP_SPACING), ry = (Y1 - Y0) / (G29_SWEEP_ROWS - 1);
+  float sw = 0, su = 0, sv = 0, suu = 0, suv = 0, svv = 0, sz = 0, suz = 0, svz = 0;
+  for (int i = 0; i < n; i++) {
+    const sample_t &s = samples[i];
+    const float u = (s.x - px) / rx, v = (s.y - py) / ry;
+    if (fabsf(u) >= 1 || fabsf(v) >= 1) continue;
+    const float w = (1 - fabsf(u)) * (1 - fabsf(v));
+    sw += w; su += w * u; sv += w * v; suu += w * u * u; suv += w * u * v; svv += w * v * v;
+    sz += w * s.z; suz += w * u * s.z; svz += w * v * s.z;
+  }
+  const float d3 = sw * (suu * svv - suv * suv) - su * (su * svv - suv * sv) + sv * (su * suv - suu * sv),
+              d2 = sw * suu - su * su;
+  if (d3 > 1e-3f * sw * sw * sw) return (sz * (suu * svv - suv * suv) - su * (suz * svv - suv * svz) + sv * (suz * suv - suu * svz)) / d3;
+  if (d2 > 1e-3f * sw * sw) return (sz * suu - su * suz) / d2;
+  return sz / sw;
+}
+
+typedef struct { float stock_s, sweep_s, touches, sd, worst; } result_t;
+
+static result_t trial(const float tilt, const float bowl, const bool tare_rows) {
+  const int beds = 50;
+  result_t res = { 0 };
+  double e = 0, e2 = 0;
+  int points = 0;
+  for (int b = 0; b < beds; b++) {
+    const bed_t bed = { tilt * test_randf(-1, 1), tilt * test_randf(-1, 1), bowl };
+    int n;
+    res.stock_s += stock_s() / beds;
+    res.sweep_s += sweep_s(bed, tare_rows, n) / beds;
+    res.touches += float(n) / beds;
+    for (int gx = 0; gx < N; gx++) for (int gy = 0; gy < N; gy++) {
+      const float px = X0 + (X1 - X0) * gx / (N - 1), py = Y0 + (Y1 - Y0) * gy / (N - 1),
+                  err = fit(n, px, py) - (bed.z(px, py) + FULL_OFS);
+      e += err; e2 += err * err; points++;
+      NOLESS(res.worst, fabsf(err));
+    }
+  }
+  e /= points;
+  res.sd = sqrt(e2 / points - e * e);
+  return res;
+}
+
+MARLIN_TEST(sweep_model, faster_than_stock) {
+  const result_t r = trial(0.3f, 0.1f, true);
+  TEST_ASSERT(r.sweep_s * 3 < r.stock_s);
+  MEASURE("stock %.1f s, sweep %.1f s with a tare per row, %.0f touches", r.stock_s, r.sweep_s, r.touches);
+}
+
+// A tare per row bounds what the gauge can drift before the fit sees it
+MARLIN_TEST(sweep_model, tare_per_row) {
+  static const struct { const char *name; float tilt, bowl; } beds[] = {
+    { "flat", 0.05f, 0.02f }, { "tilted 0.3mm", 0.3f, 0.03f }, { "warped", 0.6f, 0.4f }
+  };
+  for (auto &b : beds) {
+    test_srand(1);
+    const result_t once = trial(b.tilt, b.bowl, false);
+    test_srand(1);
+    const result_t rows = trial(b.tilt, b.bowl, true);
+    TEST_ASSERT(rows.sd < once.sd);
+    TEST_ASSERT(rows.worst < 0.06f);
+    MEASURE("%-13s one tare: sd %.1f worst %.1f um | tare per row: sd %.1f worst %.1f um, +%.1f s",
+      b.name, once.sd * 1000, once.worst * 1000, rows.sd * 1000, rows.worst * 1000, rows.sweep_s - once.sweep_s);
+  }
+}
@@ -0,0 +1,241 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/**
+ * TMC UART transactions against emulated TMC2209 drivers
+ *
+ * Four drivers share a one-wire UART at 115200 baud. The wire echoes every
+ * byte to the MCU and the drivers, each driver answers reads addressed to it
+ * after its SENDDELAY, and resets its receiver after 63 idle bit times. The
+ * USART1 interrupts run whenever the main loop asks for the time.
+ *
+ * The bus is included rather than linked so its cycle counter and UART
+ * start can run on simulated time.
+ */
+
+// flags: -no-pie -Wl,--unresolved-symbols=ignore-all
+
+#include "marlin_tests.h"
+#include "inc/MarlinConfig.h"
+#include <string.h>
+
+static uint32_t sim_cycles();
+static void sim_reset();
+static void sim_uart_send();
+
+#undef HAL_cycle_count
+#undef HAL_TMC_UART_SEND
+#define HAL_cycle_counter_init() sim_reset()
+#define HAL_cycle_count()        sim_cycles()
+#define HAL_TMC_UART_SEND()      sim_uart_send()
+
+#include "../src/feature/tmc_bus.cpp"
+
+uint32_t F_CPU = 168000000;       // Set by startup.cpp from the PLL
+void (*usart1_rx_hook)(uint8_t c);
+int16_t (*usart1_tx_hook)(void);
+
+#define BYTE_NS   86806ULL        // 10 bits at 115200 baud
+#define NODES     4
+#define REGS      128
+
+static uint64_t now_ns;           // Simulated time
+static uint64_t line_free;        // The wire is busy until then
+static bool txe,                  // TX-empty interrupt enabled
+            in_isr;
+static uint32_t p_corrupt, p_drop; // Chance per reply, out of 1000
+
+// Bytes on the wire, due at t[]
+static uint64_t wire_t[32];
+static uint8_t wire_c[32], wire_head, wire_tail;
+
+// Send a byte after any already on the wire
+static void put(const uint8_t c) {
+  line_free = _MAX(now_ns, line_free) + BYTE_NS;
+  wire_t[wire_tail] = line_free;
+  wire_c[wire_tail] = c;
+  wire_tail = (wire_tail + 1) % COUNT(wire_t);
+}
+
+static uint8_t crc8(const uint8_t *d, const int n) {
+  uint8_t crc = 0;
+  for (int i = 0; i < n; i++) {
+    uint8_t b = d[i];
+    for (int j = 0; j < 8; j++) {
+      crc = ((crc >> 7) ^ (b & 1)) ? (crc << 1) ^ 7 : crc << 1;
+      b >>= 1;
+    }
+  }
+  return crc;
+}
+
+struct TMC2209 {
+  uint8_t addr, buf[8], n;
+  uint32_t reg[REGS];
+  uint64_t last;
+
+  void rx(const uint8_t c) {
+    if (now_ns - last > 63 * BYTE_NS / 10) n = 0;
+    last = now_ns;
+    if (n == 0 && c != 0x05) return;
+    buf[n++] = c;
+    if (n == 4 && !(buf[2] & 0x80)) {             // Read request
+      n = 0;
+      if (buf[1] != addr || crc8(buf, 3) != buf[3]) return;
+      if (test_rand() % 1000 < p_drop) return;
+      const uint32_t v = reg[buf[2] & 0x7F];
+      uint8_t r[8] = { 0x05, 0xFF, buf[2], uint8_t(v >> 24), uint8_t(v >> 16), uint8_t(v >> 8), uint8_t(v), 0 };
+      r[7] = crc8(r, 7);
+      if (test_rand() % 1000 < p_corrupt) r[3 + test_rand() % 5] ^= 1 << (test_rand() % 8);
+      line_free = _MAX(line_free, now_ns + 8 * BYTE_NS / 10);   // SENDDELAY 8 bit times
+      for (const uint8_t b : r) put(b);
+    }
+    else if (n == 8) {                            // Write
+      n = 0;
+      if (buf[1] != addr || crc8(buf, 7) != buf[7]) return;
+      reg[buf[2] & 0x7F] = uint32_t(buf[3]) << 24 | uint32_t(buf[4]) << 16 | uint32_t(buf[5]) << 8 | buf[6];
+    }
+  }
+} drv[NODES];
+
+// Advance simulated time, running the UART interrupts as they come due
+static void sim(const uint64_t dt) {
+  if (in_isr) return;
+  const uint64_t end = now_ns + dt;
+  for (;;) {
+    uint64_t next = end;
+    if (txe && line_free <= now_ns) next = now_ns;
+    const bool rx = wire_head != wire_tail;
+    if (rx && wire_t[wire_head] < next) next = wire_t[wire_head];
+    if (next >= end) break;
+    now_ns = _MAX(now_ns, next);
+    in_isr = true;
+    if (rx && wire_t[wire_head] <= now_ns) {
+      const uint8_t c = wire_c[wire_head];
+      wire_head = (wire_head + 1) % COUNT(wire_t);
+      for (TMC2209 &d : drv) d.rx(c);
+      usart1_rx_hook(c);
+    }
+    else {
+      const int16_t c = usart1_tx_hook();
+      if (c < 0) txe = false; else put(c);
+    }
+    in_isr = false;
+  }
+  now_ns = end;
+}
+
+static void sim_reset() {
+  now_ns = line_free = 0;
+  txe = in_isr = false;
+  p_corrupt = p_drop = 0;
+  wire_head = wire_tail = 0;
+  LOOP_L_N(i, NODES) { ZERO(drv[i].reg); drv[i].addr = i; drv[i].n = 0; }
+}
+
+static void sim_uart_send() { txe = true; }
+static uint32_t sim_cycles() { sim(1000); return uint32_t(now_ns * (F_CPU / 1000000) / 1000); }
+
+// Each call costs the main loop 2us
+uint32_t millis() { sim(2000); return now_ns / 1000000; }
+
+static uint32_t shadow[NODES][REGS];
+
+MARLIN_TEST(tmc_bus, writes_and_reads_back) {
+  tmc_bus.init();
+  memset(shadow, 0, sizeof(shadow));
+  int wrong = 0, failed = 0;
+  for (int k = 0; k < 20000; k++) {
+    const uint8_t node = test_rand() % NODES, reg = test_rand() % REGS;
+    if (test_rand() & 1) {
+      const uint32_t v = test_rand();
+      tmc_bus.write(node, reg, v);
+      shadow[node][reg] = v;
+    }
+    else {
+      uint32_t v;
+      if (!tmc_bus.read_wait(node, reg, v)) failed++;
+      else if (v != shadow[node][reg]) wrong++;
+    }
+  }
+  tmc_bus.drain();
+  TEST_ASSERT_EQUAL(0, failed);
+  TEST_ASSERT_EQUAL(0, wrong);
+  LOOP_L_N(n, NODES) TEST_ASSERT(!memcmp(drv[n].reg, shadow[n], sizeof(shadow[n])));
+}
+
+// Corrupted and lost replies are retried, and never come back as a good value
+MARLIN_TEST(tmc_bus, faulty_bus_never_lies) {
+  tmc_bus.init();
+  LOOP_L_N(n, NODES) LOOP_L_N(r, REGS) drv[n].reg[r] = test_rand();
+  p_corrupt = 50; p_drop = 20;
+  int good = 0, lost = 0, wrong = 0;
+  for (int k = 0; k < 20000; k++) {
+    const uint8_t node = test_rand() % NODES, reg = test_rand() % REGS;
+    uint32_t v;
+    if (!tmc_bus.read_wait(node, reg, v)) lost++;
+    else if (v != drv[node].reg[reg]) wrong++;
+    else good++;
+  }
+  TEST_ASSERT_EQUAL(0, wrong);
+  TEST_ASSERT(good > 19900);
+  MEASURE("5%% corrupt, 2%% lost replies: %d good, %d failed after retries", good, lost);
+}
+
+static uint32_t polled[NODES], callbacks;
+static void poll_cb(void * const ctx, const bool ok, const uint32_t v) {
+  polled[intptr_t(ctx)] = ok ? v : 0;
+  callbacks++;
+}
+
+// DRV_STATUS of all drivers every 500ms, with idle() every 200us
+MARLIN_TEST(tmc_bus, poll_cost) {
+  tmc_bus.init();
+  LOOP_L_N(n, NODES) drv[n].reg[0x6F] = 0xC0000000 | n;
+  callbacks = 0;
+  const int rounds = 200;
+  uint64_t busy_ns = 0;
+  for (int k = 0; k < rounds; k++) {
+    const uint64_t start = now_ns;
+    uint64_t t = now_ns;
+    LOOP_L_N(n, NODES) tmc_bus.read(n, 0x6F, poll_cb, (void*)intptr_t(n));
+    busy_ns += now_ns - t;
+    while (now_ns - start < 500000000ULL) {
+      sim(200000);
+      t = now_ns;
+      tmc_bus.task();
+      busy_ns += now_ns - t;
+    }
+  }
+  LOOP_L_N(n, NODES) TEST_ASSERT_EQUAL(0xC0000000 | n, polled[n]);
+  TEST_ASSERT_EQUAL(uint32_t(NODES * rounds), callbacks);
+  MEASURE("%.1f us of main loop per %d-driver poll, including 2500 idle() calls (blocking: ~%.1f ms)",
+    busy_ns / 1e3 / rounds, NODES, NODES * (12 * BYTE_NS + 2e6 + 8 * BYTE_NS / 10) / 1e6);
+}
+
+MARLIN_TEST(tmc_bus, read_wait_latency) {
+  tmc_bus.init();
+  const uint64_t t = now_ns;
+  for (int k = 0; k < 1000; k++) { uint32_t v; TEST_ASSERT(tmc_bus.read_wait(k % NODES, 0x6F, v)); }
+  MEASURE("%.2f ms per blocking read", (now_ns - t) / 1e6 / 1000);
+}
@@ -0,0 +1,90 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "flash_sim.h"
+#include "flash.h"
+#include <string.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+
+#define SIM_BASE FLASH_DATA_AREA_START
+#define SIM_SIZE (FLASH_ALL_END + 1 - FLASH_DATA_AREA_START)
+
+int flash_sim_cut_after = -1;
+uint32_t flash_sim_words, flash_sim_erases;
+bool flash_sim_overwrite, flash_sim_nested;
+double flash_sim_us;
+void (*flash_sim_interrupt)();
+
+static bool unlocked;
+
+static void map_at(const uint32_t base, const uint32_t size) {
+  void * const m = mmap((void*)uintptr_t(base), size, PROT_READ | PROT_WRITE, MAP_FIXED | MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (m != (void*)uintptr_t(base)) { printf("flash_sim: can't map %x\n", base); exit(1); }
+}
+
+void flash_sim_init() {
+  static bool mapped;
+  if (!mapped) {
+    map_at(SIM_BASE, SIM_SIZE);
+    map_at(FLASH_STOCK_EEPROM_BASE, FLASH_SECTOR_SIZE);
+    mapped = true;
+  }
+  memset((void*)uintptr_t(SIM_BASE), 0xFF, SIM_SIZE);
+  memset((void*)uintptr_t(FLASH_STOCK_EEPROM_BASE), 0xFF, FLASH_SECTOR_SIZE);
+  flash_sim_cut_after = -1;
+  flash_sim_words = flash_sim_erases = 0;
+  flash_sim_overwrite = flash_sim_nested = unlocked = false;
+  flash_sim_us = 0;
+  flash_sim_interrupt = nullptr;
+}
+
+static bool in_sim(const uint32_t addr) { return addr >= SIM_BASE && addr - SIM_BASE < SIM_SIZE; }
+
+void EFM_Unlock() {
+  if (unlocked) flash_sim_nested = true;
+  unlocked = true;
+}
+void EFM_Lock() { unlocked = false; }
+void EFM_FlashCmd(en_functional_state_t) {}
+en_flag_status_t EFM_GetFlagStatus(uint32_t) { return Set; }
+
+en_result_t EFM_SectorErase(uint32_t addr) {
+  if (flash_sim_interrupt) flash_sim_interrupt();
+  if (!in_sim(addr) || flash_sim_cut_after == 0) return Error;
+  memset((void*)uintptr_t(addr & ~(FLASH_SECTOR_SIZE - 1)), 0xFF, FLASH_SECTOR_SIZE);
+  flash_sim_erases++;
+  flash_sim_us += FLASH_SIM_ERASE_US;
+  return Ok;
+}
+
+en_result_t EFM_SingleProgram(uint32_t addr, uint32_t data) {
+  if (flash_sim_interrupt) flash_sim_interrupt();
+  if (!in_sim(addr) || flash_sim_cut_after == 0) return Error;
+  if (flash_sim_cut_after > 0) flash_sim_cut_after--;
+  uint32_t &w = *(uint32_t*)uintptr_t(addr);
+  if ((w & data) != data) flash_sim_overwrite = true;
+  w &= data;
+  flash_sim_words++;
+  flash_sim_us += FLASH_SIM_WORD_US;
+  return Ok;
+}
@@ -0,0 +1,50 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * host/flash_sim.h - The HC32 flash controller over host memory
+ *
+ * The data area (FLASH_DATA_AREA_START up to the end of flash) is mapped
+ * at its real address so firmware can read it through plain pointers. So is
+ * the stock firmware's EEPROM page, which is only ever read.
+ * The EFM_* driver calls behave like NOR flash: an erase sets a sector to
+ * FF and programming can only clear bits. A power cut can be scheduled
+ * after any number of programmed words.
+ */
+
+#include <stdint.h>
+
+void flash_sim_init();                  // Map the flash and erase it all
+
+extern int flash_sim_cut_after;         // Words to program before the power fails, -1 for never
+extern uint32_t flash_sim_words, flash_sim_erases;
+extern bool flash_sim_overwrite;        // Set if a word was programmed over cleared bits
+extern bool flash_sim_nested;           // Set if the controller was unlocked while already unlocked
+
+// Time the operations would take on the HC32F460, using conservative datasheet figures
+#define FLASH_SIM_WORD_US     30
+#define FLASH_SIM_ERASE_US 20000
+extern double flash_sim_us;
+
+// Called inside each erase and before each programmed word, e.g., to run an interrupt
+extern void (*flash_sim_interrupt)();
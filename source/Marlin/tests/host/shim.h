@@ -0,0 +1,18 @@
+/**
+ * Host build shim, force-included ahead of every test unit.
+ * Maps the Keil and CMSIS keywords used by the HC32 headers onto GCC.
+ */
+#pragma once
+
+#define __weak __attribute__((weak))
+#define __align(x) __attribute__((aligned(x)))
+#define __packed __attribute__((packed))
+#define __irq
+#define __asm__(...)
+
+#include <sys/cdefs.h>
+#undef __always_inline
+#define __always_inline
+
+#include <stdlib.h>
+#define random random_marlin
@@ -0,0 +1,2 @@
+// Host stand-in for a header the tree does not ship
+#pragma once
@@ -0,0 +1,26 @@
+// Host stand-in for the CMSIS compiler header. Intrinsics do nothing.
+#pragma once
+#include <stdint.h>
+#define __ASM __asm__
+#define __INLINE inline
+#define __STATIC_INLINE static inline
+#define __STATIC_FORCEINLINE static inline
+#define __NO_RETURN
+#define __USED
+#define __WEAK __attribute__((weak))
+#define __PACKED __attribute__((packed))
+#define __PACKED_STRUCT struct __attribute__((packed))
+#define __PACKED_UNION union __attribute__((packed))
+#define __ALIGNED(x) __attribute__((aligned(x)))
+#define __RESTRICT
+#define __COMPILER_BARRIER()
+#define __UNALIGNED_UINT32(x) (*(uint32_t*)(x))
+static inline void __DSB(){} static inline void __ISB(){} static inline void __DMB(){} static inline void __NOP(){}
+static inline void __enable_irq(){} static inline void __disable_irq(){}
+static inline uint32_t __get_PRIMASK(){return 0;} static inline void __set_PRIMASK(uint32_t){}
+static inline uint32_t __get_FPSCR(){return 0;} static inline void __set_FPSCR(uint32_t){}
+static inline uint32_t __get_IPSR(){return 0;} 
+static inline uint32_t __REV(uint32_t v){return v;}
+static inline uint32_t __RBIT(uint32_t v){return v;}
+static inline uint8_t __CLZ(uint32_t v){return __builtin_clz(v);}
+static inline void __WFI(){} static inline void __BKPT(int){}
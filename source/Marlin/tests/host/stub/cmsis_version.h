@@ -0,0 +1,4 @@
+// Host stand-in for the CMSIS version header
+#pragma once
+#define __CM_CMSIS_VERSION_MAIN 5
+#define __CM_CMSIS_VERSION_SUB 0
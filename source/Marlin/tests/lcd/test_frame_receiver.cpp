@@ -0,0 +1,126 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * Fuzz and throughput for the DGUS panel frame parser
+ *
+ * Valid frames are fed in random chunks, with bursts of line noise and
+ * idle gaps between them. Every frame that follows a gap must come out
+ * intact, and random bytes alone must never yield a bad length.
+ */
+
+// sources: Marlin/src/lcd/extui/lib/anycubic_dgus/dgus_FrameReceiver.cpp
+// poll() reads the panel UART, which the test never calls
+// flags: -no-pie -Wl,--unresolved-symbols=ignore-all
+
+#include "marlin_tests.h"
+#include "lcd/extui/lib/anycubic_dgus/dgus_FrameReceiver.h"
+#include <string.h>
+
+using namespace Anycubic;
+
+static millis_t now_ms;
+
+// Feed bytes the way poll() does, a UART read at a time
+static void feed(const uint8_t *b, const int n) {
+  for (int i = 0; i < n; i++) FrameReceiver::parse(b[i], now_ms);
+}
+
+static int make_frame(uint8_t *f, const uint8_t len) {
+  f[0] = 0x5A; f[1] = 0xA5; f[2] = len;
+  for (int i = 0; i < len; i++) f[3 + i] = test_rand();
+  return len + 3;
+}
+
+MARLIN_TEST(frame_receiver, recovers_after_noise) {
+  FrameReceiver::reset();
+  uint8_t f[3 + AC_RX_FRAME_MAX], buf[AC_RX_FRAME_MAX], noise[20];
+  int lost = 0, bad_len = 0;
+  for (int i = 0; i < 100000; i++) {
+    if (test_rand() % 3 == 0) {
+      const int n = test_rand() % sizeof(noise);
+      for (int k = 0; k < n; k++) noise[k] = test_rand();
+      feed(noise, n);
+    }
+    now_ms += AC_RX_FRAME_TIMEOUT + 1;    // Idle gap drops any partial frame
+
+    const uint8_t len = 1 + test_rand() % AC_RX_FRAME_MAX;
+    const int size = make_frame(f, len);
+    for (int p = 0; p < size;) {
+      const int c = _MIN(size - p, 1 + int(test_rand() % 8));
+      feed(f + p, c);
+      p += c;
+      now_ms++;
+    }
+
+    bool found = false;
+    for (uint8_t l; (l = FrameReceiver::pop(buf));) {
+      if (!WITHIN(l, 1, AC_RX_FRAME_MAX)) bad_len++;
+      if (l == len && !memcmp(buf, f + 3, len)) found = true;
+    }
+    if (!found) lost++;
+  }
+  TEST_ASSERT_EQUAL(0, lost);
+  TEST_ASSERT_EQUAL(0, bad_len);
+}
+
+MARLIN_TEST(frame_receiver, random_bytes_stay_bounded) {
+  FrameReceiver::reset();
+  uint8_t buf[AC_RX_FRAME_MAX];
+  int bad_len = 0;
+  for (int i = 0; i < 2000000; i++) {
+    FrameReceiver::parse(test_rand(), now_ms);
+    if (i % 64 == 0)
+      for (uint8_t l; (l = FrameReceiver::pop(buf));)
+        if (!WITHIN(l, 1, AC_RX_FRAME_MAX)) bad_len++;
+  }
+  TEST_ASSERT_EQUAL(0, bad_len);
+}
+
+MARLIN_TEST(frame_receiver, stalled_frame_times_out) {
+  FrameReceiver::reset();
+  uint8_t f[3 + AC_RX_FRAME_MAX], buf[AC_RX_FRAME_MAX];
+  const int size = make_frame(f, 10);
+  feed(f, 6);                             // Half a frame, then the panel goes quiet
+  now_ms += AC_RX_FRAME_TIMEOUT + 1;
+  feed(f, size);
+  TEST_ASSERT_EQUAL(10, FrameReceiver::pop(buf));
+  TEST_ASSERT(!memcmp(buf, f + 3, 10));
+  TEST_ASSERT_EQUAL(0, FrameReceiver::pop(buf));
+}
+
+MARLIN_TEST(frame_receiver, throughput) {
+  FrameReceiver::reset();
+  // A typical key press: 83 write, VP 0x1002, one word
+  static const uint8_t key[] = { 0x5A, 0xA5, 0x06, 0x83, 0x10, 0x02, 0x01, 0x00, 0x05 };
+  uint8_t buf[AC_RX_FRAME_MAX];
+  const long frames = 1000000;
+  long got = 0;
+  const uint64_t t0 = test_micros();
+  for (long i = 0; i < frames; i++) {
+    feed(key, sizeof(key));
+    while (FrameReceiver::pop(buf)) got++;
+  }
+  const double s = (test_micros() - t0) * 1e-6;
+  TEST_ASSERT_EQUAL(frames, got);
+  MEASURE("%.1f MB/s parsed on the host (-O0)", frames * sizeof(key) / s / 1e6);
+}
@@ -0,0 +1,152 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * DGUS transmit queue against a model panel
+ *
+ * Random value, range, text and raw writes go through the queue while the
+ * UART drains at random. The panel memory left by the queued stream must
+ * match the memory left by sending every write straight away, and raw text
+ * must come out whole and in order.
+ */
+
+// sources: Marlin/src/lcd/extui/lib/anycubic_dgus/dgus_TxQueue.cpp arduino/Print.cpp
+// flags: -no-pie -Wl,--unresolved-symbols=ignore-all
+
+#include "marlin_tests.h"
+#include "lcd/extui/lib/anycubic_dgus/dgus_TxQueue.h"
+#include <string.h>
+#include <string>
+
+using namespace Anycubic;
+
+#define VP_BASE  0x1000
+#define VP_COUNT 64
+
+// The panel: VP memory plus whatever arrived outside a frame
+typedef struct {
+  uint16_t vp[VP_COUNT];
+  std::string text;
+  uint8_t frame[256];
+  int got;
+
+  void clear() { memset(vp, 0, sizeof(vp)); text.clear(); got = 0; }
+
+  void apply(const uint8_t *f) {
+    const uint16_t at = ((f[4] << 8) | f[5]) - VP_BASE;
+    for (int i = 0; i < f[2] - 3; i++) {
+      const int w = at + i / 2;
+      if (w < VP_COUNT) vp[w] = i & 1 ? (vp[w] & 0xFF00) | f[6 + i] : (vp[w] & 0x00FF) | (f[6 + i] << 8);
+    }
+  }
+
+  void receive(const uint8_t c) {
+    if (got == 0 && c != 0x5A) { text += char(c); return; }
+    frame[got++] = c;
+    if (got >= 3 && got == frame[2] + 3) { apply(frame); got = 0; }
+  }
+} panel_t;
+
+static panel_t queued, direct;
+static int tx_room;
+
+HardwareSerial::HardwareSerial(M4_USART_TypeDef *base, unsigned char *, uint16_t) : uart_base(base) {}
+int HardwareSerial::available() { return 0; }
+int HardwareSerial::read() { return -1; }
+int HardwareSerial::peek() { return -1; }
+void HardwareSerial::flush() {}
+int HardwareSerial::availableForWrite() { return tx_room; }
+size_t HardwareSerial::write(uint8_t c) {
+  queued.receive(c);
+  if (tx_room) tx_room--;
+  return 1;
+}
+HardwareSerial TFTSer(nullptr, nullptr, 0);
+
+static void send(const uint8_t *f, const uint8_t len, const bool words=false) {
+  TxQueue::push(f, len, words);
+  for (int i = 0; i < len; i++) direct.receive(f[i]);
+}
+
+static void send_values(const uint16_t vp, const uint8_t n) {
+  uint8_t f[6 + 2 * 4] = { 0x5A, 0xA5, uint8_t(3 + 2 * n), 0x82, uint8_t(vp >> 8), uint8_t(vp) };
+  for (int i = 0; i < 2 * n; i++) f[6 + i] = test_rand();
+  send(f, 6 + 2 * n, true);
+}
+
+// Text fills its whole field, padded with FF as the firmware does
+static void send_text(const uint16_t vp) {
+  uint8_t f[6 + 8] = { 0x5A, 0xA5, 3 + 8, 0x82, uint8_t(vp >> 8), uint8_t(vp) };
+  const uint8_t n = 1 + test_rand() % 8;
+  for (int i = 0; i < 8; i++) f[6 + i] = i < n ? 'a' + test_rand() % 26 : 0xFF;
+  send(f, sizeof(f));
+}
+
+static void send_raw() {
+  uint8_t t[12];
+  const uint8_t n = 1 + test_rand() % sizeof(t);
+  for (int i = 0; i < n; i++) t[i] = 'A' + test_rand() % 25;   // No 'Z', which is 5A
+  TxQueue::write(t, n);
+  for (int i = 0; i < n; i++) direct.receive(t[i]);
+}
+
+MARLIN_TEST(tx_queue, matches_direct_writes) {
+  int mismatches = 0;
+  for (int run = 0; run < 2000; run++) {
+    TxQueue::reset();
+    queued.clear();
+    direct.clear();
+    tx_room = 0;
+    for (int op = 0; op < 60; op++) {
+      const uint16_t vp = VP_BASE + test_rand() % (VP_COUNT - 4);
+      switch (test_rand() % 8) {
+        case 0: send_text(vp); break;
+        case 1: send_raw(); break;
+        case 2: case 3: send_values(vp, 2 + test_rand() % 3); break;
+        default: send_values(vp, 1); break;
+      }
+      if (test_rand() % 4 == 0) { tx_room = test_rand() % 64; TxQueue::pump(); }
+    }
+    TxQueue::flush();
+    if (memcmp(queued.vp, direct.vp, sizeof(direct.vp)) || queued.text != direct.text) mismatches++;
+  }
+  TEST_ASSERT_EQUAL(0, mismatches);
+}
+
+// A write must not patch an older frame that a newer queued frame overlaps
+MARLIN_TEST(tx_queue, newest_write_wins) {
+  TxQueue::reset();
+  queued.clear();
+  direct.clear();
+  tx_room = 0;
+  const uint8_t range[]  = { 0x5A, 0xA5, 0x09, 0x82, 0x10, 0x00, 0, 1, 0, 2, 0, 3 },
+                other[]  = { 0x5A, 0xA5, 0x05, 0x82, 0x10, 0x20, 0, 0 },
+                across[] = { 0x5A, 0xA5, 0x07, 0x82, 0x10, 0x02, 0, 8, 0, 9 },
+                one[]    = { 0x5A, 0xA5, 0x05, 0x82, 0x10, 0x02, 0, 5 };
+  send(range, sizeof(range), true);
+  send(other, sizeof(other), true);
+  send(across, sizeof(across), true);
+  send(one, sizeof(one), true);       // Patches 'across', not 'range' which goes out before it
+  TxQueue::flush();
+  TEST_ASSERT_EQUAL(5, queued.vp[2]);
+  TEST_ASSERT_EQUAL(9, queued.vp[3]);
+}
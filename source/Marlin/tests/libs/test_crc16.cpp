@@ -0,0 +1,95 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * CRC-16 table against the bitwise CRC it replaced
+ *
+ * Settings and journal records already in flash carry CRCs from the old
+ * bitwise loop, so the table must give the same result for any block,
+ * alignment, starting value and split into calls. The host has no CRC
+ * unit, so only the table is checked and timed here.
+ */
+
+// sources: Marlin/src/libs/crc16.cpp
+
+#include "marlin_tests.h"
+#include "libs/crc16.h"
+
+// libs/crc16.cpp before the table
+static void crc16_bitwise(uint16_t *crc, const void * const data, uint16_t cnt) {
+  uint8_t *ptr = (uint8_t *)data;
+  while (cnt--) {
+    *crc = (uint16_t)(*crc ^ (uint16_t)(((uint16_t)*ptr++) << 8));
+    for (uint8_t i = 0; i < 8; i++)
+      *crc = (uint16_t)((*crc & 0x8000) ? ((uint16_t)(*crc << 1) ^ 0x1021) : (*crc << 1));
+  }
+}
+
+static uint8_t buf[4096];
+
+MARLIN_TEST(crc16, check_value) {
+  uint16_t c = 0;
+  crc16(&c, "123456789", 9);
+  TEST_ASSERT_EQUAL(0x31C3, c);     // CRC-16/XMODEM
+}
+
+MARLIN_TEST(crc16, matches_bitwise) {
+  for (auto &b : buf) b = test_rand();
+  int mismatches = 0;
+  for (int i = 0; i < 100000; i++) {
+    const int off = test_rand() % 64, len = test_rand() % 1000;
+    uint16_t a = test_rand(), b = a;
+    crc16_bitwise(&a, buf + off, len);
+    for (int p = 0; p < len;) {                 // Chained in random pieces
+      int n = 1 + test_rand() % 40;
+      if (n > len - p) n = len - p;
+      crc16(&b, buf + off + p, n);
+      p += n;
+    }
+    if (a != b) mismatches++;
+  }
+  TEST_ASSERT_EQUAL(0, mismatches);
+}
+
+/**
+ * settings.cpp walks about 1KB of settings one field at a time on every
+ * boot (M501) and on every save (M500), which does the walk twice.
+ */
+MARLIN_TEST(crc16, settings_walk) {
+  static const uint8_t fields[] = { 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 2, 1, 1, 4, 4, 4, 4, 12, 12, 12, 12, 1, 1, 2, 2, 4, 100, 4, 4, 4, 4, 4, 4, 16, 16, 1 };
+  const int size = 1000, reps = 5000, count = sizeof(fields);
+  uint16_t old_crc = 0, new_crc = 0;
+
+  const uint64_t t0 = test_micros();
+  for (int r = 0; r < reps; r++)
+    for (int pos = 0, f = 0; pos < size; pos += fields[f], f = (f + 1) % count)
+      crc16_bitwise(&old_crc, buf + pos, fields[f] < size - pos ? fields[f] : size - pos);
+  const uint64_t t1 = test_micros();
+  for (int r = 0; r < reps; r++)
+    for (int pos = 0, f = 0; pos < size; pos += fields[f], f = (f + 1) % count)
+      crc16(&new_crc, buf + pos, fields[f] < size - pos ? fields[f] : size - pos);
+  const uint64_t t2 = test_micros();
+
+  TEST_ASSERT_EQUAL(old_crc, new_crc);
+  MEASURE("1000-byte settings walk on the host (-O0): bitwise %.1f us, table %.1f us, %.1fx",
+    double(t1 - t0) / reps, double(t2 - t1) / reps, double(t1 - t0) / (t2 - t1));
+}
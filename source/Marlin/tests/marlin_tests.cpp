@@ -0,0 +1,68 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "marlin_tests.h"
+#include <time.h>
+
+static MarlinTest *first_test, *last_test;
+static bool test_failed;
+static uint32_t rand_state = 1;
+
+MarlinTest::MarlinTest(const char * const n, const marlin_test_fn f) : name(n), fn(f), next(nullptr) {
+  if (last_test) last_test->next = this; else first_test = this;
+  last_test = this;
+}
+
+void marlin_test_fail(const char * const file, const int line, const char * const what) {
+  printf("  %s:%d: check failed: %s\n", file, line, what);
+  test_failed = true;
+}
+
+void test_srand(const uint32_t seed) { rand_state = seed ? seed : 1; }
+
+uint32_t test_rand() {
+  // xorshift32
+  rand_state ^= rand_state << 13;
+  rand_state ^= rand_state >> 17;
+  rand_state ^= rand_state << 5;
+  return rand_state;
+}
+
+uint64_t test_micros() {
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return uint64_t(ts.tv_sec) * 1000000 + ts.tv_nsec / 1000;
+}
+
+int main() {
+  int run = 0, failed = 0;
+  for (MarlinTest *t = first_test; t; t = t->next) {
+    printf("%s\n", t->name);
+    test_failed = false;
+    test_srand(1);
+    t->fn();
+    run++;
+    if (test_failed) { failed++; printf("  FAILED\n"); }
+  }
+  printf("%d tests, %d failed\n", run, failed);
+  return failed ? 1 : 0;
+}
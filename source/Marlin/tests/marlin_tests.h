@@ -0,0 +1,64 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * tests/marlin_tests.h - Minimal host test runner
+ *
+ * Each MARLIN_TEST registers itself and marlin_tests.cpp runs them all.
+ * A failed check reports its line, fails the test and lets it continue.
+ * MEASURE lines are printed for the record and never fail a test.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <math.h>
+
+typedef void (*marlin_test_fn)();
+
+struct MarlinTest {
+  const char * const name;
+  const marlin_test_fn fn;
+  MarlinTest *next;
+  MarlinTest(const char * const n, const marlin_test_fn f);
+};
+
+void marlin_test_fail(const char * const file, const int line, const char * const what);
+
+#define MARLIN_TEST(SUITE, NAME) \
+  static void SUITE##_##NAME(); \
+  static MarlinTest SUITE##_##NAME##_test(#SUITE "." #NAME, SUITE##_##NAME); \
+  static void SUITE##_##NAME()
+
+#define TEST_ASSERT(C) do{ if (!(C)) marlin_test_fail(__FILE__, __LINE__, #C); }while(0)
+#define TEST_ASSERT_EQUAL(E, A) TEST_ASSERT((E) == (A))
+#define TEST_ASSERT_WITHIN(D, E, A) TEST_ASSERT(fabs(double(A) - double(E)) <= double(D))
+
+#define MEASURE(...) do{ printf("  measure: "); printf(__VA_ARGS__); printf("\n"); }while(0)
+
+// Deterministic generator so every run sees the same data
+uint32_t test_rand();
+void test_srand(const uint32_t seed);
+inline float test_randf(const float lo, const float hi) { return lo + (hi - lo) * (test_rand() & 0xFFFFFF) * (1.0f / 0x1000000); }
+
+// Host clock for timing measurements
+uint64_t test_micros();
@@ -0,0 +1,139 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/**
+ * PROBE_TARE timing against a model of a strain-gauge probe
+ *
+ * The Kobra configuration leaves PROBE_TARE off, so this test turns it on
+ * with the Configuration.h timings. The probe holds its output triggered
+ * while the tare pin is asserted and for a while after the release. Each
+ * G29 point is run the way probe_at_point() and run_z_probe() do it with
+ * MULTIPLE_PROBING 2: a tare started before the XY hop and finished before
+ * the fast touch, and one started before the raise for the slow touch.
+ *
+ * The probe is included rather than linked so its pins can be simulated.
+ */
+
+// flags: -DPROBE_TARE -DPROBE_TARE_PIN=PA5 -no-pie -Wl,--unresolved-symbols=ignore-all
+
+#include "marlin_tests.h"
+#include "inc/MarlinConfig.h"
+#include <string.h>
+
+static void pin_write(const pin_t pin, const bool state);
+static bool pin_read(const pin_t pin);
+
+#undef WRITE
+#undef READ
+#undef OUT_WRITE
+#define WRITE(IO,V)     pin_write(IO, V)
+#define READ(IO)        pin_read(IO)
+#define OUT_WRITE(IO,V) pin_write(IO, V)
+
+#include "../src/module/probe.cpp"
+
+#define HOP_MS     450    // XY move to the next point
+#define RAISE_MS  1250    // Raise and settle between the fast and slow touches
+
+uint8_t marlin_debug_flags;
+volatile uint8_t Endstops::hit_state;
+
+static millis_t now_ms,
+                released_ms;    // When the tare pin was last released
+static bool tare_pin;
+static int busy_ms;             // Output stays triggered this long after the release, or forever if < 0
+
+uint32_t millis() { return now_ms; }
+void idle(TERN_(ADVANCED_PAUSE_FEATURE, bool)) { now_ms++; }
+static int not_ready;            // "Probe not ready after tare" messages
+void serialprintPGM(PGM_P str) { if (strstr(str, "not ready")) not_ready++; }
+
+static void pin_write(const pin_t pin, const bool state) {
+  if (pin != PROBE_TARE_PIN) return;
+  const bool held = state == PROBE_TARE_STATE;
+  if (tare_pin && !held) released_ms = now_ms;
+  tare_pin = held;
+}
+
+static bool pin_read(const pin_t pin) {
+  const bool triggered = tare_pin || busy_ms < 0 || now_ms - released_ms < millis_t(busy_ms);
+  TEST_ASSERT_EQUAL(Z_MIN_PIN, pin);
+  return triggered != Z_MIN_ENDSTOP_INVERTING;
+}
+
+// Tare time per point over a 5x5 G29. False if any tare failed.
+static bool g29_tare_ms(const int busy, float &per_point) {
+  busy_ms = busy;
+  probe.tare_init();
+  millis_t total = 0;
+  bool ok = true;
+  for (int p = 0; p < 25; p++) {
+    probe.tare_ms = 0;
+    probe.tare_start();             // probe_at_point(), before the XY move
+    now_ms += HOP_MS;
+    ok &= !probe.tare();            // Fast touch
+    now_ms += 100;
+    probe.tare_start();             // run_z_probe(), before the raise
+    now_ms += RAISE_MS;
+    ok &= !probe.tare();            // Slow touch
+    now_ms += 200;
+    total += probe.tare_ms;
+  }
+  per_point = total / 25.0f;
+  return ok;
+}
+
+MARLIN_TEST(probe_tare, overlaps_travel) {
+  float ms;
+  TEST_ASSERT(g29_tare_ms(0, ms));
+  TEST_ASSERT_WITHIN(2, 2 * (PROBE_TARE_SETTLE), ms);   // Only the settle is left to wait for
+  MEASURE("probe ready at release: %.0f ms/point (fixed waits: %d)", ms, 4 * ((PROBE_TARE_TIME) + (PROBE_TARE_DELAY)));
+}
+
+MARLIN_TEST(probe_tare, waits_for_a_busy_probe) {
+  static const int busy[] = { 30, 150 };
+  for (const int b : busy) {
+    float ms;
+    TEST_ASSERT(g29_tare_ms(b, ms));
+    TEST_ASSERT_WITHIN(2, 2 * (b + (PROBE_TARE_SETTLE)), ms);
+    MEASURE("probe busy %3d ms after release: %.0f ms/point", b, ms);
+  }
+}
+
+// The pulse is never cut short, even when no travel came before the tare
+MARLIN_TEST(probe_tare, holds_the_pin) {
+  busy_ms = 0;
+  probe.tare_init();
+  const millis_t start = now_ms;
+  TEST_ASSERT(!probe.tare());
+  TEST_ASSERT(released_ms - start >= PROBE_TARE_TIME);
+}
+
+MARLIN_TEST(probe_tare, fails_when_stuck) {
+  float ms;
+  not_ready = 0;
+  TEST_ASSERT(!g29_tare_ms(-1, ms));
+  TEST_ASSERT_EQUAL(50, not_ready);
+  TEST_ASSERT_WITHIN(2, 2 * (PROBE_TARE_DELAY), ms);
+  MEASURE("probe stuck triggered: every tare fails after %.0f ms", ms / 2);
+}
@@ -0,0 +1,63 @@
+#!/usr/bin/env bash
+#
+# run_tests.sh - Build and run the host tests
+#
+# Each tests/<area>/test_*.cpp is one program. It is compiled with the
+# Kobra configuration and linked with the firmware files named on its
+# "// sources:" lines (relative to source/). A "// flags:" line adds
+# compiler or linker flags for that test.
+#
+# Usage: Marlin/tests/run_tests.sh [name-filter]
+#
+
+set -e
+
+TESTS=$(cd "$(dirname "$0")" && pwd)
+SRC=$(cd "$TESTS/../.." && pwd)
+OUT=${TEST_OUT:-/tmp/marlin_tests}
+CXX=${CXX:-g++}
+
+mkdir -p "$OUT/hdsc"
+
+# The core headers sit next to an embedded stdio.h/stdint.h that must not shadow the host ones
+for f in core_cm4.h hc32_common.h hc32_ddl.h hc32f46x.h system_hc32f46x.h; do
+  ln -sf "$SRC/main/hdsc32core/$f" "$OUT/hdsc/$f"
+done
+
+DEFINES="-DHC32F46x -D__CC_ARM -D__arm__ -D__ARM_ARCH_7EM__ -DUSE_DEVICE_DRIVER_LIB -D__FPU_PRESENT=1 \
+  -DARM_MATH_CM4 -D__MPU_PRESENT=1 -DSTM32_HIGH_DENSITY -DARDUINO_ARCH_STM32F1 -DARDUINO_ARCH_STM32"
+
+INCLUDES="-I$TESTS -I$TESTS/host/stub -I$OUT/hdsc"
+for d in compoment/sdio compoment/sdio/sd_card/inc compoment/Utility drivers/board drivers/library \
+         drivers/library/inc framework/cores main Marlin Marlin/src Marlin/src/pins Marlin/src/core \
+         Marlin/src/feature Marlin/src/feature/bedlevel Marlin/src/feature/bedlevel/abl Marlin/src/gcode \
+         Marlin/src/HAL Marlin/src/HAL/shared Marlin/src/HAL/STM32 Marlin/src/HAL/STM32/inc Marlin/src/inc \
+         Marlin/src/lcd Marlin/src/lcd/language Marlin/src/libs Marlin/src/module Marlin/src/module/stepper \
+         Marlin/src/module/thermistor Marlin/src/pins/stm32f1 Marlin/src/sd Marlin/src/sd/usb_flashdrive \
+         Marlin/src/lcd/extui Marlin/src/lcd/extui/lib/anycubic_chiron Marlin/src/lcd/extui/lib/anycubic_dgus \
+         framework/TMCStepper framework/TMCStepper/source arduino board FatFs framework/SoftwareSerial; do
+  INCLUDES="$INCLUDES -I$SRC/$d"
+done
+
+CXXFLAGS="-std=gnu++14 -O0 -g -w -fpermissive -include $TESTS/host/shim.h $DEFINES $INCLUDES"
+
+pass=0; fail=0; failed=""
+for t in "$TESTS"/*/test_*.cpp; do
+  name=$(basename "$t" .cpp)
+  [[ -n "$1" && "$name" != *"$1"* ]] && continue
+
+  sources=$(sed -n 's|^// sources:||p' "$t")
+  flags=$(sed -n 's|^// flags:||p' "$t")
+  srcs=""; for s in $sources; do srcs="$srcs $SRC/$s"; done
+
+  echo "== $name"
+  if $CXX $CXXFLAGS $flags -o "$OUT/$name" "$t" "$TESTS/marlin_tests.cpp" $srcs -lm \
+     && "$OUT/$name"; then
+    pass=$((pass + 1))
+  else
+    fail=$((fail + 1)); failed="$failed $name"
+  fi
+done
+
+echo "$pass passed, $fail failed$failed"
+[ $fail -eq 0 ]
@@ -0,0 +1,175 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * SdBaseFile::readBlockUncached against a FAT16 image in memory
+ *
+ * The image holds one fragmented file. A "print" reads it a byte at a time
+ * through the volume cache, as card.get() does, while a scanner reads ahead
+ * of it a block at a time, as PrintETA does. Card reads are counted to show
+ * whether the scanner makes the print read its blocks again.
+ */
+
+// sources: Marlin/src/sd/SdBaseFile.cpp Marlin/src/sd/SdVolume.cpp
+// flags: -no-pie -Wl,--unresolved-symbols=ignore-all
+
+#include "marlin_tests.h"
+#include "sd/SdBaseFile.h"
+#include <string.h>
+
+#define CLUSTER_BLOCKS   2
+#define CLUSTERS      4100                            // Enough to be FAT16
+#define FAT_BLOCKS    ((CLUSTERS + 2) * 2 / 512 + 1)
+#define ROOT_BLOCK    (1 + FAT_BLOCKS)
+#define DATA_BLOCK    (ROOT_BLOCK + 1)
+#define TOTAL_BLOCKS  (DATA_BLOCK + CLUSTERS * CLUSTER_BLOCKS)
+
+#define FILE_CLUSTERS   12
+#define FILE_SIZE       (FILE_CLUSTERS * CLUSTER_BLOCKS * 512 - 300)
+
+static uint8_t image[TOTAL_BLOCKS][512];
+static uint32_t card_reads;
+
+bool SDIO_Init() { return true; }
+bool SDIO_ReadBlock(uint32_t block, uint8_t *dst) {
+  if (block >= TOTAL_BLOCKS) return false;
+  memcpy(dst, image[block], 512);
+  card_reads++;
+  return true;
+}
+bool SDIO_WriteBlock(uint32_t, const uint8_t*) { return false; }
+
+static uint8_t file_byte(const uint32_t pos) { return uint8_t(pos * 7 + (pos >> 9)); }
+
+// One file whose clusters are spread over the FAT, so most cluster steps read another FAT block
+static void make_image() {
+  memset(image, 0, sizeof(image));
+
+  fat_boot_t &fbs = *(fat_boot_t*)image[0];
+  fbs.bytesPerSector = 512;
+  fbs.sectorsPerCluster = CLUSTER_BLOCKS;
+  fbs.reservedSectorCount = 1;
+  fbs.fatCount = 1;
+  fbs.rootDirEntryCount = 16;
+  fbs.totalSectors16 = TOTAL_BLOCKS;
+  fbs.sectorsPerFat16 = FAT_BLOCKS;
+  fbs.bootSectorSig0 = 0x55;
+  fbs.bootSectorSig1 = 0xAA;
+
+  uint16_t * const fat = (uint16_t*)image[1];
+  fat[0] = 0xFFF8; fat[1] = 0xFFFF;
+  uint16_t cluster[FILE_CLUSTERS];
+  LOOP_L_N(i, FILE_CLUSTERS) cluster[i] = 10 + i * 301;
+  LOOP_L_N(i, FILE_CLUSTERS) fat[cluster[i]] = i + 1 < FILE_CLUSTERS ? cluster[i + 1] : 0xFFFF;
+
+  dir_t &d = *(dir_t*)image[ROOT_BLOCK];
+  memcpy(d.name, "ETA     GCO", 11);
+  d.attributes = DIR_ATT_ARCHIVE;
+  d.firstClusterLow = cluster[0];
+  d.fileSize = FILE_SIZE;
+
+  for (uint32_t pos = 0; pos < FILE_SIZE; pos++)
+    image[DATA_BLOCK + (cluster[pos / 1024] - 2) * CLUSTER_BLOCKS + (pos / 512) % CLUSTER_BLOCKS][pos % 512] = file_byte(pos);
+}
+
+static Sd2Card sd2card;
+static SdVolume volume;
+static SdBaseFile root;
+
+static bool open_file(SdBaseFile &f) {
+  f.close();
+  return f.open(&root, "ETA.GCO", O_READ);
+}
+
+static void mount() {
+  make_image();
+  root.close();
+  TEST_ASSERT(volume.init(&sd2card, 0));
+  TEST_ASSERT_EQUAL(16, volume.fatType());
+  TEST_ASSERT(root.openRoot(&volume));
+}
+
+// Read the file a byte at a time, and a block ahead of every 'step' bytes with the scanner
+static uint32_t print_with_scan(const int step, const bool uncached) {
+  SdBaseFile print, scan;
+  TEST_ASSERT(open_file(print));
+  TEST_ASSERT(open_file(scan));
+  static cache_t block;
+  card_reads = 0;
+  bool scanning = step > 0;
+  for (uint32_t pos = 0; pos < FILE_SIZE; pos++) {
+    if (scanning && pos % step == 0) {
+      const int16_t n = uncached ? scan.readBlockUncached(&block) : scan.read(block.data, 512);
+      scanning = n > 0;
+    }
+    if (print.read() != file_byte(pos)) { TEST_ASSERT(false); break; }
+  }
+  return card_reads;
+}
+
+static uint32_t scan_alone() {
+  SdBaseFile scan;
+  TEST_ASSERT(open_file(scan));
+  static cache_t block;
+  card_reads = 0;
+  while (scan.readBlockUncached(&block) > 0) { /* nada */ }
+  return card_reads;
+}
+
+MARLIN_TEST(sd, uncached_reads_match_the_file) {
+  mount();
+  SdBaseFile f;
+  TEST_ASSERT(open_file(f));
+  static cache_t block;
+  uint32_t pos = 0;
+  bool same = true;
+  for (;;) {
+    const int16_t n = f.readBlockUncached(&block);
+    TEST_ASSERT(n >= 0);
+    if (n <= 0) break;
+    TEST_ASSERT(n == 512 || pos + n == FILE_SIZE);
+    for (int16_t i = 0; i < n; i++) same &= block.data[i] == file_byte(pos + i);
+    pos += n;
+  }
+  TEST_ASSERT(same);
+  TEST_ASSERT_EQUAL(uint32_t(FILE_SIZE), pos);
+
+  // Only from a block boundary
+  TEST_ASSERT(open_file(f));
+  TEST_ASSERT(f.read() >= 0);
+  TEST_ASSERT_EQUAL(-1, f.readBlockUncached(&block));
+}
+
+MARLIN_TEST(sd, scan_leaves_the_print_cache_alone) {
+  mount();
+  const uint32_t print_only = print_with_scan(0, true),
+                 scan_only = scan_alone(),
+                 uncached = print_with_scan(64, true),
+                 cached = print_with_scan(64, false);
+  MEASURE("card reads: print %u, scan %u, print + uncached scan %u, print + cached scan %u", print_only, scan_only, uncached, cached);
+
+  // Scanning the whole file costs one read per block and one per FAT step
+  const uint32_t blocks = (FILE_SIZE + 511) / 512;
+  TEST_ASSERT(scan_only >= blocks && scan_only < blocks + FILE_CLUSTERS);
+  TEST_ASSERT_EQUAL(print_only + scan_only, uncached);
+  TEST_ASSERT(cached > uncached);
+}
@@ -0,0 +1,98 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * Host check of the M303 F1 model fit against known plants, the same
+ * check M111 S8 runs on the printer.
+ */
+
+// sources: Marlin/src/feature/fopdt.cpp
+
+#include "marlin_tests.h"
+#include "feature/fopdt.h"
+
+struct plant_case_t { fopdt_model_t plant; float target; uint16_t period_ms; };
+
+static const plant_case_t cases[] = {
+  { { 1.30f, 150, 4.0f },  200, 500 },  // Hotend
+  { { 0.55f, 260, 12.0f },  60, 2000 }, // Bed
+  { { 1.30f, 150, 1.0f },  230, 500 },  // Hotend, short dead time
+  { { 0.90f,  90, 6.0f },  210, 500 }   // Hotend with a heavy block
+};
+
+// Step the plant in 10ms steps and feed the fitter readings with sensor noise
+static void run_noisy(FOPDTFit &f, const fopdt_model_t &p, const float T0, const float u, const float target, const float noise) {
+  float x = 0;
+  for (millis_t ms = 0; T0 + x < target && ms < 3600000UL; ms += 10) {
+    const float drive = ms * 0.001f >= p.L ? p.K * u : 0;
+    x += (drive - x) * 0.01f / p.tau;
+    f.sample(ms, T0 + x + test_randf(-noise, noise));
+  }
+}
+
+MARLIN_TEST(fopdt, fit_recovers_simulated_plants) {
+  for (const plant_case_t &c : cases) {
+    FOPDTFit f;
+    f.start(25, 255, c.period_ms);
+    f.simulate(c.plant, c.target);
+    fopdt_model_t m;
+    TEST_ASSERT(f.fit(m));
+    MEASURE("plant K %.3f tau %.0f L %.1f -> K %.3f tau %.1f L %.2f", c.plant.K, c.plant.tau, c.plant.L, m.K, m.tau, m.L);
+    TEST_ASSERT_WITHIN(c.plant.K * 0.05f, c.plant.K, m.K);
+    TEST_ASSERT_WITHIN(c.plant.tau * 0.05f, c.plant.tau, m.tau);
+    TEST_ASSERT_WITHIN(c.period_ms * 0.001f + 0.5f, c.plant.L, m.L);
+  }
+}
+
+// A bed step to 60°C only covers a quarter of its rise, so the fit of its
+// curvature is far more sensitive to noise. Only the hotends are checked.
+MARLIN_TEST(fopdt, fit_tolerates_sensor_noise) {
+  for (const plant_case_t &c : cases) {
+    if (c.period_ms != 500) continue;
+    FOPDTFit f;
+    f.start(25, 255, c.period_ms);
+    run_noisy(f, c.plant, 25, 255, c.target, 0.25f);
+    fopdt_model_t m;
+    TEST_ASSERT(f.fit(m));
+    MEASURE("noisy: plant K %.3f tau %.0f L %.1f -> K %.3f tau %.1f L %.2f", c.plant.K, c.plant.tau, c.plant.L, m.K, m.tau, m.L);
+    TEST_ASSERT_WITHIN(c.plant.K * 0.15f, c.plant.K, m.K);
+    TEST_ASSERT_WITHIN(c.plant.tau * 0.15f, c.plant.tau, m.tau);
+    TEST_ASSERT_WITHIN(c.period_ms * 0.002f + 1.0f, c.plant.L, m.L);
+  }
+}
+
+MARLIN_TEST(fopdt, too_few_samples_fail) {
+  FOPDTFit f;
+  f.start(25, 255, 500);
+  for (millis_t ms = 0; ms < 1500; ms += 500) f.sample(ms, 25 + ms * 0.01f);
+  fopdt_model_t m;
+  TEST_ASSERT(!f.fit(m));
+}
+
+MARLIN_TEST(fopdt, gains_slow_down_with_lambda) {
+  const fopdt_model_t m = { 1.3f, 150, 4 };
+  const fopdt_gains_t g1 = FOPDTFit::gains(m, 1), g3 = FOPDTFit::gains(m, 3);
+  MEASURE("lambda 1: Kp %.2f Ki %.3f Kd %.1f", g1.Kp, g1.Ki, g1.Kd);
+  TEST_ASSERT(g1.Kp > 0 && g1.Ki > 0 && g1.Kd > 0);
+  TEST_ASSERT(g3.Kp < g1.Kp);
+  TEST_ASSERT(g3.Ki < g1.Ki);
+}
@@ -0,0 +1,148 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * Fault injection for HEATER_HEALTH_CHECK
+ *
+ * A PID loop drives a two-node plant: the heater block, and a sensor that
+ * lags behind it. Cases vary flow load, model error and supply voltage,
+ * and inject a loose sensor, an open heater or a shorted MOSFET.
+ * Healthy runs must never trip. Faults must trip with the right verdict.
+ */
+
+// sources: Marlin/src/feature/heater_health.cpp
+
+#include "marlin_tests.h"
+#include "feature/heater_health.h"
+
+Temperature thermalManager;
+static float supply_scale = 1;
+float Temperature::heater_supply_scale() { return supply_scale; }
+
+enum fault_t { NO_FAULT, SENSOR_LOOSE, HEATER_OPEN, MOSFET_SHORT };
+
+typedef struct {
+  const char *name;
+  uint8_t index;                // 0 or HEALTH_INDEX_BED
+  heater_model_t plant;         // True plant, before model error
+  float sensor_lag,             // (s) Sensor time constant
+        target;
+  fault_t fault;
+  float fault_s,                // (s) Time of the fault
+        flow_watts,             // Load switched on and off from 200s to 600s
+        model_error,            // Plant = configured model * this
+        supply;                 // Supply voltage scale
+} health_case_t;
+
+static const heater_model_t hotend = HOTEND_THERMAL_MODEL, bed = BED_THERMAL_MODEL;
+
+#define HOTEND_CASE(N, LAG, T, F, FS, W, ERR, V) { N, 0, hotend, LAG, T, F, FS, W, ERR, V }
+#define BED_CASE(N, LAG, T, F, FS, ERR)          { N, HEALTH_INDEX_BED, bed, LAG, T, F, FS, 0, ERR, 1 }
+
+static const health_case_t healthy[] = {
+  HOTEND_CASE("hotend",                     2.5, 210, NO_FAULT, 0,  0, 1.00, 1.00),
+  HOTEND_CASE("hotend 10W flow",            2.5, 230, NO_FAULT, 0, 10, 1.00, 1.00),
+  HOTEND_CASE("hotend model +25%",          2.5, 210, NO_FAULT, 0,  6, 1.25, 1.00),
+  HOTEND_CASE("hotend model -20%",          2.5, 210, NO_FAULT, 0,  6, 0.80, 1.00),
+  HOTEND_CASE("hotend low supply",          2.5, 210, NO_FAULT, 0,  6, 1.00, 0.85),
+  HOTEND_CASE("hotend 12W flow, -20%",      2.5, 240, NO_FAULT, 0, 12, 0.80, 1.00),
+  HOTEND_CASE("hotend 12W flow, +25%, lag", 4.0, 240, NO_FAULT, 0, 12, 1.25, 1.00),
+  HOTEND_CASE("hotend slow sensor",         5.0, 240, NO_FAULT, 0,  0, 1.00, 1.00),
+  BED_CASE("bed",                           8.0,  60, NO_FAULT, 0, 1.00),
+  BED_CASE("bed slow sensor",              15.0, 100, NO_FAULT, 0, 1.00),
+  BED_CASE("bed model -20%",                8.0, 100, NO_FAULT, 0, 0.80),
+  BED_CASE("bed model +25%",                8.0, 100, NO_FAULT, 0, 1.25)
+};
+
+static const health_case_t faulty[] = {
+  HOTEND_CASE("hotend sensor loose",  2.5, 210, SENSOR_LOOSE, 400, 6, 1, 1),
+  HOTEND_CASE("hotend heater open",   2.5, 210, HEATER_OPEN,  400, 6, 1, 1),
+  HOTEND_CASE("hotend MOSFET short",  2.5, 210, MOSFET_SHORT, 400, 0, 1, 1),
+  BED_CASE("bed sensor loose",        8.0, 100, SENSOR_LOOSE, 400, 1),
+  BED_CASE("bed heater open",         8.0, 100, HEATER_OPEN,  400, 1),
+  BED_CASE("bed MOSFET short",        8.0, 100, MOSFET_SHORT, 500, 1)
+};
+
+// Run a case for 900s at PID_dT. Return the verdict and when it came.
+static HeaterHealth::Verdict run(const health_case_t &c, float &trip_s) {
+  const bool isbed = c.index == HEALTH_INDEX_BED;
+  const float dt = 0.16f, ambient = 22,
+              Kp = isbed ? 60 : 20, Ki = isbed ? 6 : 2.4f, Kd = isbed ? 60 : 6,
+              watts = c.plant.watts * c.model_error * c.supply,
+              capacity = c.plant.capacity * c.model_error,
+              loss = c.plant.loss * c.model_error;
+  float block = ambient, sensor = ambient, prev = ambient, integral = 0;
+
+  heater_health.reset();
+  supply_scale = c.supply;
+
+  for (uint32_t n = 0; n < uint32_t(900 / dt); n++) {
+    const float t = n * dt;
+
+    // A shorted MOSFET shows up after the target was dropped, so any heat is unexplained
+    const float target = (c.fault == MOSFET_SHORT && t > c.fault_s * 0.5f) ? 0 : c.target;
+    const float e = target - sensor;
+    integral = constrain(integral + e * dt, -200.0f, 200.0f);
+    const float out = target ? Kp * e + Ki * integral - Kd * (sensor - prev) / dt : 0;
+    prev = sensor;
+    const uint8_t pwm = uint8_t(int(constrain(out, 0.0f, 255.0f)) >> 1);
+
+    float applied = watts * pwm / 127;
+    if (t > c.fault_s) {
+      if (c.fault == HEATER_OPEN) applied = 0;
+      if (c.fault == MOSFET_SHORT) applied = watts;
+    }
+    const float load = (t > 200 && t < 600 && (int(t) / 40) % 2) ? c.flow_watts : 0;
+    block += (applied - loss * (block - ambient) - load) / capacity * dt;
+
+    if (c.fault == SENSOR_LOOSE && t > c.fault_s)
+      sensor += (60 - sensor) / 12 * dt;  // Falls out and reads the air near the block
+    else
+      sensor += (block - sensor) / c.sensor_lag * dt;
+
+    const float reading = sensor + test_randf(-0.3f, 0.3f);
+    const HeaterHealth::Verdict v = heater_health.update(c.index, reading, pwm, millis_t(t * 1000) + 1);
+    if (v != HeaterHealth::HEALTH_OK) { trip_s = t; return v; }
+  }
+  return HeaterHealth::HEALTH_OK;
+}
+
+MARLIN_TEST(heater_health, healthy_heaters_never_trip) {
+  for (const health_case_t &c : healthy) {
+    float trip_s = 0;
+    const HeaterHealth::Verdict v = run(c, trip_s);
+    if (v != HeaterHealth::HEALTH_OK) MEASURE("%s: false trip at %.1fs", c.name, trip_s);
+    TEST_ASSERT_EQUAL(HeaterHealth::HEALTH_OK, v);
+  }
+}
+
+MARLIN_TEST(heater_health, faults_trip_in_seconds) {
+  for (const health_case_t &c : faulty) {
+    float trip_s = 0;
+    const HeaterHealth::Verdict v = run(c, trip_s),
+                                want = c.fault == MOSFET_SHORT ? HeaterHealth::HEALTH_HEAT_EXCESS : HeaterHealth::HEALTH_HEAT_MISSING;
+    MEASURE("%s: %s %.1fs after the fault", c.name, v == HeaterHealth::HEALTH_OK ? "missed," : "tripped", trip_s - c.fault_s);
+    TEST_ASSERT_EQUAL(want, v);
+    TEST_ASSERT(trip_s > c.fault_s);
+    TEST_ASSERT(trip_s - c.fault_s <= (c.index == HEALTH_INDEX_BED ? 3 * (HEATER_HEALTH_BED_WINDOW) : 4 * (HEATER_HEALTH_WINDOW)));
+  }
+}
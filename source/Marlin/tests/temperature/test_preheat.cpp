@@ -0,0 +1,173 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * PREHEAT_SCHEDULER release order
+ *
+ * The Kobra configuration leaves the scheduler off, so this test turns it on.
+ * PreheatScheduler::run() is driven against plants built from the configured
+ * thermal models. Each idle() call advances the clock by 100ms, applies the
+ * heater targets and power caps, and notes when each heater was released
+ * and when it arrived.
+ */
+
+// sources: Marlin/src/feature/preheat.cpp arduino/Print.cpp
+// flags: -DPREHEAT_SCHEDULER -no-pie -Wl,--unresolved-symbols=ignore-all
+
+#include "marlin_tests.h"
+#include "feature/preheat.h"
+#include "gcode/gcode.h"
+#include "lcd/marlinui.h"
+#include "MarlinCore.h"
+
+#define TICK_MS 100
+
+Temperature thermalManager;
+hotend_info_t Temperature::temp_hotend[HOTENDS];
+bed_info_t Temperature::temp_bed;
+temp_range_t Temperature::temp_range[HOTENDS] = { { 0, 0, 0, HEATER_0_MAXTEMP } };
+float Temperature::heater_supply_scale() { return 1; }
+void Temperature::print_heater_states(const uint8_t) {}
+#if WATCH_HOTENDS
+  void Temperature::start_watching_hotend(const uint8_t) {}
+#endif
+#if WATCH_BED
+  void Temperature::start_watching_bed() {}
+#endif
+
+GcodeSuite gcode;
+millis_t GcodeSuite::previous_move_ms;
+void MarlinUI::status_printf_P(const uint8_t, PGM_P const, ...) {}
+void serialprintPGM(PGM_P) {}
+HardwareSerial::HardwareSerial(M4_USART_TypeDef *base, unsigned char *, uint16_t) : uart_base(base) {}
+int HardwareSerial::available() { return 0; }
+int HardwareSerial::read() { return -1; }
+int HardwareSerial::peek() { return -1; }
+void HardwareSerial::flush() {}
+int HardwareSerial::availableForWrite() { return 0; }
+size_t HardwareSerial::write(uint8_t) { return 1; }
+HardwareSerial Serial2(nullptr, nullptr, 0);
+void serial_echopair_PGM(PGM_P const, long) {}
+void serial_echopair_PGM(PGM_P const, int) {}
+
+bool wait_for_heatup;
+
+enum { HOTEND, BED, HEATERS };
+
+static heater_info_t * const info[HEATERS] = { &thermalManager.temp_hotend[0], &thermalManager.temp_bed };
+static const heater_model_t model[HEATERS] = { HOTEND_THERMAL_MODEL, BED_THERMAL_MODEL };
+static const float window[HEATERS] = { TEMP_WINDOW, TEMP_BED_WINDOW };
+
+static millis_t now_ms, cancel_ms;
+static float peak_watts;
+static struct {
+  millis_t released_ms, arrived_ms;
+  bool released, arrived;
+} log_[HEATERS];
+static uint8_t order[HEATERS], released_count;
+
+uint32_t millis() { return now_ms; }
+
+// One tick of bang-bang control on first-order plants that match the models
+void idle(TERN_(ADVANCED_PAUSE_FEATURE, bool)) {
+  float watts = 0;
+  LOOP_L_N(i, HEATERS) {
+    heater_info_t &h = *info[i];
+    h.soft_pwm_amount = h.target > h.celsius ? 127 : 0;
+    h.apply_limit();
+    const float p = model[i].watts * h.soft_pwm_amount / 127;
+    h.celsius += (p - model[i].loss * (h.celsius - 25)) / model[i].capacity * (TICK_MS * 0.001f);
+    watts += p;
+
+    if (h.target && !log_[i].released) {
+      log_[i].released = true;
+      log_[i].released_ms = now_ms;
+      order[released_count++] = i;
+    }
+    if (h.target && !log_[i].arrived && h.celsius >= h.target - window[i]) {
+      log_[i].arrived = true;
+      log_[i].arrived_ms = now_ms;
+    }
+  }
+  NOLESS(peak_watts, watts);
+  now_ms += TICK_MS;
+  if (cancel_ms && now_ms >= cancel_ms) wait_for_heatup = false;
+}
+
+static bool heat(const float hotend_from, const float bed_from, const int16_t hotend_target, const int16_t bed_target) {
+  now_ms = 1000; cancel_ms = 0; peak_watts = 0; released_count = 0;
+  ZERO(log_);
+  thermalManager.temp_hotend[0].celsius = hotend_from;
+  thermalManager.temp_bed.celsius = bed_from;
+  LOOP_L_N(i, HEATERS) info[i]->target = 0;
+  return preheat.run(hotend_target, bed_target);
+}
+
+static float seconds(const millis_t ms) { return (ms - 1000) * 0.001f; }
+
+MARLIN_TEST(preheat, slow_bed_leads) {
+  TEST_ASSERT(heat(25, 25, 200, 100));
+  MEASURE("bed released %.1fs arrived %.1fs, hotend released %.1fs arrived %.1fs",
+    seconds(log_[BED].released_ms), seconds(log_[BED].arrived_ms),
+    seconds(log_[HOTEND].released_ms), seconds(log_[HOTEND].arrived_ms));
+  TEST_ASSERT_EQUAL(2, released_count);
+  TEST_ASSERT_EQUAL(BED, order[0]);
+  TEST_ASSERT_EQUAL(HOTEND, order[1]);
+  TEST_ASSERT(seconds(log_[BED].released_ms) < 1);
+  TEST_ASSERT(seconds(log_[HOTEND].released_ms) > 30);
+  // The follower is released PREHEAT_ARRIVAL_MARGIN early, so it lands first but not by much
+  TEST_ASSERT(log_[HOTEND].arrived_ms <= log_[BED].arrived_ms);
+  TEST_ASSERT(log_[BED].arrived_ms - log_[HOTEND].arrived_ms <= SEC_TO_MS(PREHEAT_ARRIVAL_MARGIN + 2));
+  TEST_ASSERT(peak_watts <= PREHEAT_POWER_BUDGET);
+}
+
+MARLIN_TEST(preheat, slow_hotend_leads) {
+  TEST_ASSERT(heat(25, 25, 210, 60));
+  MEASURE("hotend released %.1fs arrived %.1fs, bed released %.1fs arrived %.1fs",
+    seconds(log_[HOTEND].released_ms), seconds(log_[HOTEND].arrived_ms),
+    seconds(log_[BED].released_ms), seconds(log_[BED].arrived_ms));
+  TEST_ASSERT_EQUAL(2, released_count);
+  TEST_ASSERT_EQUAL(HOTEND, order[0]);
+  TEST_ASSERT_EQUAL(BED, order[1]);
+  TEST_ASSERT(seconds(log_[BED].released_ms) > 10);
+  TEST_ASSERT(log_[BED].arrived_ms <= log_[HOTEND].arrived_ms);
+  TEST_ASSERT(log_[HOTEND].arrived_ms - log_[BED].arrived_ms <= SEC_TO_MS(PREHEAT_ARRIVAL_MARGIN + 2));
+}
+
+MARLIN_TEST(preheat, hot_heater_keeps_its_target) {
+  TEST_ASSERT(heat(200, 25, 200, 60));
+  TEST_ASSERT_EQUAL(2, released_count);
+  TEST_ASSERT_EQUAL(HOTEND, order[0]);
+  TEST_ASSERT_EQUAL(0, log_[HOTEND].released_ms - 1000);
+  TEST_ASSERT_EQUAL(200, thermalManager.temp_hotend[0].target);
+}
+
+MARLIN_TEST(preheat, cancel_releases_everything) {
+  now_ms = 1000; cancel_ms = 5000;
+  ZERO(log_); released_count = 0;
+  thermalManager.temp_hotend[0].celsius = thermalManager.temp_bed.celsius = 25;
+  TEST_ASSERT(!preheat.run(200, 100));
+  TEST_ASSERT_EQUAL(200, thermalManager.temp_hotend[0].target);
+  TEST_ASSERT_EQUAL(100, thermalManager.temp_bed.target);
+  TEST_ASSERT_EQUAL(0, thermalManager.temp_hotend[0].soft_pwm_limit);
+  TEST_ASSERT_EQUAL(0, thermalManager.temp_bed.soft_pwm_limit);
+}
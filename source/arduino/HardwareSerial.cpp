@@ -35,8 +35,10 @@ extern uint8_t g_rxBuffer[128];
 extern uint8_t g_rxBuffer8[128];
 // Constructors ////////////////////////////////////////////////////////////////
 
-HardwareSerial::HardwareSerial(M4_USART_TypeDef *base) :
-    _rx_buffer_head(0), _rx_buffer_tail(0)
+HardwareSerial::HardwareSerial(M4_USART_TypeDef *base, unsigned char *tx_buffer, uint16_t tx_size) :
+    _rx_buffer_head(0), _rx_buffer_tail(0),
+    _tx_buffer_head(0), _tx_buffer_tail(0),
+    _tx_buffer_mask((tx_buffer_index_t)(tx_size - 1)), _tx_buffer(tx_buffer)
 {
 	uart_base = base;
 }
@@ -67,15 +69,62 @@ int HardwareSerial::available(void)
   return ((unsigned int)(SERIAL_RX_BUFFER_SIZE + _rx_buffer_head - _rx_buffer_tail)) % SERIAL_RX_BUFFER_SIZE;
 }
 
-void HardwareSerial::flush()
+int HardwareSerial::availableForWrite(void)
+{
+  return (_tx_buffer_tail - _tx_buffer_head - 1) & _tx_buffer_mask;
+}
+
+// The TX interrupt can't run from an ISR or with interrupts off
+static inline bool tx_irq_blocked(void)
+{
+  return __get_PRIMASK() || (__get_IPSR() & 0x1FFu);
+}
+
+// Send everything queued without the TX interrupt. Call with interrupts masked:
+// from a lower-priority ISR the TX interrupt could still preempt and move the tail.
+void HardwareSerial::_tx_drain_polled(void)
 {
+  while (_tx_buffer_head != _tx_buffer_tail) {
+    USART_SendData(uart_base, _tx_buffer[_tx_buffer_tail]);
+    _tx_buffer_tail = (tx_buffer_index_t)(_tx_buffer_tail + 1) & _tx_buffer_mask;
+  }
+  USART_FuncCmd(uart_base, UsartTxEmptyInt, Disable);
+}
 
+void HardwareSerial::flush()
+{
+  if (tx_irq_blocked()) {
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    _tx_drain_polled();
+    __set_PRIMASK(primask);
+  }
+  else
+    while (_tx_buffer_head != _tx_buffer_tail) { /* nada */ }
+  while (Reset == USART_GetStatus(uart_base, UsartTxComplete)) { /* nada */ }
 }
 
 size_t HardwareSerial::write(uint8_t c)
 {
+  if (tx_irq_blocked()) {
+    // Keep the order: send what is queued, then this byte
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    _tx_drain_polled();
     USART_SendData(uart_base, c);
+    __set_PRIMASK(primask);
     return 1;
+  }
+
+  tx_buffer_index_t i = (tx_buffer_index_t)(_tx_buffer_head + 1) & _tx_buffer_mask;
+
+  // Ring full: wait for the TX interrupt to make room
+  while (i == _tx_buffer_tail) { /* nada */ }
+
+  _tx_buffer[_tx_buffer_head] = c;
+  _tx_buffer_head = i;
+  USART_FuncCmd(uart_base, UsartTxEmptyInt, Enable);
+  return 1;
 }
 
 // Actual interrupt handlers //////////////////////////////////////////////////////////////
@@ -94,6 +143,16 @@ void HardwareSerial::_rx_complete_callback(unsigned char c)
 
     }
 }
+void HardwareSerial::_tx_empty_irq(void)
+{
+  if (_tx_buffer_head == _tx_buffer_tail) {
+    USART_FuncCmd(uart_base, UsartTxEmptyInt, Disable);
+    return;
+  }
+  uart_base->DR_f.TDR = _tx_buffer[_tx_buffer_tail];
+  _tx_buffer_tail = (tx_buffer_index_t)(_tx_buffer_tail + 1) & _tx_buffer_mask;
+}
+
 void HardwareSerial::set_buffer_head(rx_buffer_index_t index)
 {
 	if (index != _rx_buffer_tail) {
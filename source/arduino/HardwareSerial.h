@@ -40,6 +40,9 @@
 // atomicity guards needed for that are not implemented. This will
 // often work, but occasionally a race condition can occur that makes
 // Serial behave erratically. See https://github.com/arduino/Arduino/issues/2405
+// Output is queued in a ring given to the constructor and sent by the TX
+// empty interrupt, so writers only wait when the ring is full. A ring is a
+// power of 2 bytes, at most 256. SERIAL_TX_BUFFER_SIZE is the usual size.
 #if !defined(SERIAL_TX_BUFFER_SIZE)
 #if ((RAMEND - RAMSTART) < 1023)
 #define SERIAL_TX_BUFFER_SIZE 128
@@ -74,6 +77,9 @@ class HardwareSerial : public Stream
 
     volatile rx_buffer_index_t _rx_buffer_head;
     volatile rx_buffer_index_t _rx_buffer_tail;
+    volatile tx_buffer_index_t _tx_buffer_head;
+    volatile tx_buffer_index_t _tx_buffer_tail;
+    tx_buffer_index_t _tx_buffer_mask;
 
     // Don't put any members after these buffers, since only the first
     // 32 bytes of this struct can be accessed quickly using the ldd
@@ -83,14 +89,15 @@ class HardwareSerial : public Stream
 
   public:
     unsigned char _rx_buffer[SERIAL_RX_BUFFER_SIZE];
-    unsigned char _tx_buffer[SERIAL_TX_BUFFER_SIZE];
+    unsigned char *_tx_buffer;
     unsigned char *g_rx_buffer;
-    HardwareSerial(M4_USART_TypeDef *base);
+    HardwareSerial(M4_USART_TypeDef *base, unsigned char *tx_buffer, uint16_t tx_size);
     virtual int available(void);
     virtual int read(void);
     virtual void flush(void);
     virtual size_t write(uint8_t);
     virtual int peek();
+    virtual int availableForWrite(void);
     inline size_t begin(uint32_t baudrate) { return baudrate; }
     inline size_t write(unsigned long n) { return write((uint8_t)n); }
     inline size_t write(long n) { return write((uint8_t)n); }
@@ -101,7 +108,11 @@ class HardwareSerial : public Stream
     operator bool() { return true; }
     // Interrupt handlers - Not intended to be called externally
     void _rx_complete_callback(unsigned char c);
+    void _tx_empty_irq(void);
     void set_buffer_head(rx_buffer_index_t index);
+
+  private:
+    void _tx_drain_polled(void);
 };
 
 
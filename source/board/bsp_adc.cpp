@@ -1,5 +1,6 @@
 #include "bsp_adc.h"
 #include "bsp_irq.h"
+#include "bsp_timer.h"
 
 
 #define ADC_CH_COUNT    3
@@ -387,3 +388,142 @@ void adc_dma_config(void)
     DMA_SetTriggerSrc(M4_DMA2, DmaCh3, EVT_ADC1_EOCA);
 }
 
+
+/*
+ * Convert sequence A once per Timer01 channel A compare instead of
+ * continuously, and interrupt when DMA has stored the whole scan.
+ */
+void adc_event_trigger_init(uint32_t frequency)
+{
+    stc_adc_init_t stcAdcInit;
+    stc_adc_trg_cfg_t stcTrgCfg;
+    stc_irq_regi_conf_t stcIrqRegiCfg;
+
+    MEM_ZERO_STRUCT(stcAdcInit);
+    MEM_ZERO_STRUCT(stcTrgCfg);
+    MEM_ZERO_STRUCT(stcIrqRegiCfg);
+
+    ADC_StopConvert(M4_ADC1);
+
+    stcAdcInit.enResolution = AdcResolution_12Bit;
+    stcAdcInit.enDataAlign  = AdcDataAlign_Right;
+    stcAdcInit.enAutoClear  = AdcClren_Enable;
+    stcAdcInit.enScanMode   = AdcMode_SAOnce;
+    stcAdcInit.enRschsel    = AdcRschsel_Restart;
+    ADC_Init(M4_ADC1, &stcAdcInit);
+
+    stcTrgCfg.u8Sequence = ADC_SEQ_A;
+    stcTrgCfg.enTrgSel   = AdcTrgsel_TRGX0;
+    stcTrgCfg.enInTrg0   = EVT_TMR01_GCMA;
+    ADC_ConfigTriggerSrc(M4_ADC1, &stcTrgCfg);
+    ADC_TriggerSrcCmd(M4_ADC1, ADC_SEQ_A, Enable);
+
+    /* One DMA block is one scan of all channels */
+    M4_DMA2->CH3CTL_f.IE = 1u;
+    DMA_ClearIrqFlag(M4_DMA2, DmaCh3, BlkTrnCpltIrq);
+    DMA_EnableIrq(M4_DMA2, DmaCh3, BlkTrnCpltIrq);
+
+    stcIrqRegiCfg.enIRQn = IRQ_INDEX_INT_DMA2_BTC3;
+    stcIrqRegiCfg.pfnCallback = &adc_dma_btc_irq_cb;
+    stcIrqRegiCfg.enIntSrc = INT_DMA2_BTC3;
+    enIrqRegistration(&stcIrqRegiCfg);
+    NVIC_SetPriority(stcIrqRegiCfg.enIRQn, DDL_IRQ_PRIORITY_DEFAULT);
+    NVIC_ClearPendingIRQ(stcIrqRegiCfg.enIRQn);
+    NVIC_EnableIRQ(stcIrqRegiCfg.enIRQn);
+
+    timer01A_init(frequency);
+}
+
+
+/*
+ * Convert the PSU voltage channel alone as sequence B, on each TimerA1
+ * overflow, and interrupt from the analog watchdog when it reads below
+ * low. DMA still copies DR12 into g_adc_value[2] with each sequence A scan.
+ */
+void adc_awd_init(uint16_t low, uint32_t frequency)
+{
+    stc_adc_ch_cfg_t stcChCfg;
+    stc_adc_trg_cfg_t stcTrgCfg;
+    stc_adc_awd_cfg_t stcAwdCfg;
+    stc_timera_base_init_t stcTimeraInit;
+    stc_irq_regi_conf_t stcIrqRegiCfg;
+    stc_clk_freq_t stcClkTmp;
+    bool bContinuous;
+
+    uint8_t au8AdcSbSampTime[1] = { 0x60 };
+
+    MEM_ZERO_STRUCT(stcChCfg);
+    MEM_ZERO_STRUCT(stcTrgCfg);
+    MEM_ZERO_STRUCT(stcAwdCfg);
+    MEM_ZERO_STRUCT(stcTimeraInit);
+    MEM_ZERO_STRUCT(stcIrqRegiCfg);
+
+    bContinuous = (AdcMode_SAContinuous == M4_ADC1->CR0_f.MS);
+    ADC_StopConvert(M4_ADC1);
+
+    /* A channel belongs to one sequence only */
+    stcChCfg.u32Channel  = BOARD_ADC_CH2_CH;
+    stcChCfg.u8Sequence  = ADC_SEQ_A;
+    stcChCfg.pu8SampTime = au8AdcSbSampTime;
+    ADC_DelAdcChannel(M4_ADC1, &stcChCfg);
+    stcChCfg.u8Sequence  = ADC_SEQ_B;
+    ADC_AddAdcChannel(M4_ADC1, &stcChCfg);
+
+    M4_ADC1->CR0_f.MS = bContinuous ? AdcMode_SAContinuousSBOnce : AdcMode_SAOnceSBOnce;
+
+    stcTrgCfg.u8Sequence = ADC_SEQ_B;
+    stcTrgCfg.enTrgSel   = AdcTrgsel_TRGX1;
+    stcTrgCfg.enInTrg1   = EVT_TMRA1_OVF;
+    ADC_ConfigTriggerSrc(M4_ADC1, &stcTrgCfg);
+    ADC_TriggerSrcCmd(M4_ADC1, ADC_SEQ_B, Enable);
+
+    /* Out of range is below low or above full scale */
+    stcAwdCfg.enAwdmd   = AdcAwdCmpMode_0;
+    stcAwdCfg.enAwdss   = AdcAwdSel_SB;
+    stcAwdCfg.u16AwdDr0 = low;
+    stcAwdCfg.u16AwdDr1 = 0xFFFu;
+    ADC_ConfigAwd(M4_ADC1, &stcAwdCfg);
+    ADC_AddAwdChannel(M4_ADC1, BOARD_ADC_CH2_CH);
+    ADC_ClrAwdFlag(M4_ADC1);
+    ADC_AwdITCmd(M4_ADC1, Enable);
+    ADC_AwdCmd(M4_ADC1, Enable);
+
+    /* Just below the stepper, which runs at DDL_IRQ_PRIORITY_00 */
+    stcIrqRegiCfg.enIRQn = IRQ_INDEX_INT_ADC1_SEQCMP;
+    stcIrqRegiCfg.pfnCallback = &adc_awd_irq_cb;
+    stcIrqRegiCfg.enIntSrc = INT_ADC1_SEQCMP;
+    enIrqRegistration(&stcIrqRegiCfg);
+    NVIC_SetPriority(stcIrqRegiCfg.enIRQn, DDL_IRQ_PRIORITY_01);
+    NVIC_ClearPendingIRQ(stcIrqRegiCfg.enIRQn);
+    NVIC_EnableIRQ(stcIrqRegiCfg.enIRQn);
+
+    /* TimerA1 only raises EVT_TMRA1_OVF, used as the sequence B trigger */
+    PWC_Fcg2PeriphClockCmd(PWC_FCG2_PERIPH_TIMA1, Enable);
+    PWC_Fcg0PeriphClockCmd(PWC_FCG0_PERIPH_AOS, Enable);
+
+    CLK_GetClockFreq(&stcClkTmp);
+
+    stcTimeraInit.enClkDiv = TimeraPclkDiv16;
+    stcTimeraInit.enCntMode = TimeraCountModeSawtoothWave;
+    stcTimeraInit.enCntDir = TimeraCountDirUp;
+    stcTimeraInit.enSyncStartupEn = Disable;
+    stcTimeraInit.u16PeriodVal = (uint16_t)(stcClkTmp.pclk1Freq / 16ul / frequency - 1ul);
+    TIMERA_BaseInit(M4_TMRA1, &stcTimeraInit);
+    TIMERA_Cmd(M4_TMRA1, Enable);
+
+    if (bContinuous)
+    {
+        ADC_StartConvert(M4_ADC1);
+    }
+}
+
+void adc_awd_irq_cmd(en_functional_state_t state)
+{
+    ADC_ClrAwdFlag(M4_ADC1);
+    ADC_AwdITCmd(M4_ADC1, state);
+}
+
+bool adc_awd_irq_enabled(void)
+{
+    return (1u == M4_ADC1->AWDCR_f.AWDIEN);
+}
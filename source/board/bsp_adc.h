@@ -59,6 +59,18 @@ static void AdcSetPinMode(uint8_t u8AdcPin, en_pin_mode_t enMode);
 
 void adc_dma_config(void);
 
+void adc_event_trigger_init(uint32_t frequency);
+
+extern void adc_dma_btc_irq_cb(void);
+
+void adc_awd_init(uint16_t low, uint32_t frequency);
+
+void adc_awd_irq_cmd(en_functional_state_t state);
+
+bool adc_awd_irq_enabled(void);
+
+extern void adc_awd_irq_cb(void);
+
 
 void BSP_DMA2CH0_TcIrqHander(void);
 
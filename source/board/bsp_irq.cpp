@@ -6,6 +6,9 @@
 uint8_t g_uart2_rx_buf[128];
 uint8_t g_uart2_rx_index;
 
+void (*usart1_rx_hook)(uint8_t c) = NULL;
+int16_t (*usart1_tx_hook)(void) = NULL;
+
 
 extern HardwareSerial Serial1;
 extern HardwareSerial Serial2;
@@ -16,7 +19,10 @@ extern HardwareSerial Serial4;
 void BSP_USART1_RIIrqHander(void)
 {
     uint8_t c = USART_RecData(USART1_CH);
-    Serial1._rx_complete_callback(c);
+    if (usart1_rx_hook)
+        usart1_rx_hook(c);
+    else
+        Serial1._rx_complete_callback(c);
 //  RingBuf_Write(&Usart1RingBuf,(uint8_t)tmp);
 }
 
@@ -33,7 +39,15 @@ void BSP_USART1_EIIrqHander(void)
 
 void BSP_USART1_TIrqHander(void)
 {
-
+  if (usart1_tx_hook) {
+    const int16_t c = usart1_tx_hook();
+    if (c < 0)
+      USART_FuncCmd(USART1_CH, UsartTxEmptyInt, Disable);
+    else
+      USART_SendData(USART1_CH, (uint16_t)c);
+  }
+  else
+    Serial1._tx_empty_irq();
 }
 
 void BSP_USART1_TCIIrqHander(void)
@@ -61,7 +75,7 @@ void BSP_USART2_EIIrqHander(void)
 
 void BSP_USART2_TIrqHander(void)
 {
-
+  Serial2._tx_empty_irq();
 }
 
 void BSP_USART2_TCIIrqHander(void)
@@ -88,7 +102,7 @@ void BSP_USART3_EIIrqHander(void)
 
 void BSP_USART3_TIrqHander(void)
 {
-
+  Serial3._tx_empty_irq();
 }
 
 void BSP_USART3_TCIIrqHander(void)
@@ -115,7 +129,7 @@ void BSP_USART4_EIIrqHander(void)
 
 void BSP_USART4_TIrqHander(void)
 {
-
+  Serial4._tx_empty_irq();
 }
 
 void BSP_USART4_TCIIrqHander(void)
@@ -45,10 +45,19 @@ extern "C"
 #define IRQ_INDEX_INT_TMR41_GCMB        Int023_IRQn
 #define IRQ_INDEX_INT_TMR42_GCMB        Int024_IRQn
 
+#define IRQ_INDEX_INT_DMA2_BTC3         Int025_IRQn
+
+#define IRQ_INDEX_INT_ADC1_SEQCMP       Int026_IRQn
+
 
 extern uint8_t g_uart2_rx_buf[128];
 extern uint8_t g_uart2_rx_index;
 
+// Optional USART1 owner: RX bytes go to rx_hook instead of Serial1 and the
+// TX-empty interrupt pulls bytes from tx_hook until it returns -1.
+extern void (*usart1_rx_hook)(uint8_t c);
+extern int16_t (*usart1_tx_hook)(void);
+
 
 void BSP_USART1_RIIrqHander(void);
 void BSP_USART1_EIIrqHander(void);
@@ -136,6 +136,35 @@ void timer01B_disable(void)
     M4_TMR01->CNTBR = 0;
 }
 
+// Timer01 channel A only raises EVT_TMR01_GCMA, used as the ADC trigger
+void timer01A_init(uint32_t frequency)
+{
+    stc_clk_freq_t stcClkTmp;
+
+    uint32_t u32Pclk1;
+
+    stc_tim0_base_init_t stcTimerCfg;
+
+    MEM_ZERO_STRUCT(stcTimerCfg);
+
+    PWC_Fcg2PeriphClockCmd(PWC_FCG2_PERIPH_TIM01, Enable);
+
+// Get pclk1
+    CLK_GetClockFreq(&stcClkTmp);
+    u32Pclk1 = stcClkTmp.pclk1Freq;
+
+    stcTimerCfg.Tim0_CounterMode = Tim0_Sync;
+    stcTimerCfg.Tim0_SyncClockSource = Tim0_Pclk1;
+    stcTimerCfg.Tim0_ClockDivision = Tim0_ClkDiv1024;
+    stcTimerCfg.Tim0_CmpValue = (uint16_t)(u32Pclk1/1024ul/frequency);
+    TIMER0_BaseInit(M4_TMR01, Tim0_ChannelA, &stcTimerCfg);
+
+    /* AOS carries the compare event to the ADC */
+    PWC_Fcg0PeriphClockCmd(PWC_FCG0_PERIPH_AOS, Enable);
+
+    TIMER0_Cmd(M4_TMR01, Tim0_ChannelA, Enable);
+}
+
 extern void Timer02B_CallBack(void);
 
 void timer02B_init(void)
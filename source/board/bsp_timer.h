@@ -26,6 +26,7 @@ void timer01B_init(void);
 void timer01B_set_overflow(uint16_t ms);
 void timer01B_enable(void);
 void timer01B_disable(void);
+void timer01A_init(uint32_t frequency);
 
 void timer41_init(void);
 
@@ -2,19 +2,46 @@
 
 namespace Intflash {
 
-// just use 1k bytes, not a full sector
+// just use 2k bytes, not a full sector
 static uint8_t eeprom_buffer[EEPROM_SIZE] __attribute__((aligned(8))) = {0};
 
+// nesting depth of flash users, and who to tell when it drops to zero
+static volatile uint8_t busy_depth = 0;
+static void (*release_callback)(void) = NULL;
+
+bool FlashBusy()
+{
+    return busy_depth != 0;
+}
+
+void FlashClaim()
+{
+    busy_depth++;
+}
+
+void FlashRelease()
+{
+    if(--busy_depth == 0 && release_callback) {
+        release_callback();
+    }
+}
+
+void FlashSetReleaseCallback(void (*callback)(void))
+{
+    release_callback = callback;
+}
+
     
 en_result_t FlashErasePage(uint32_t u32Addr)
 {
     en_result res = Error;
 
-    if(u32Addr < FLASH_OUTAGE_DATA_ADDR) {
+    if(u32Addr < FLASH_DATA_AREA_START) {
         printf("can NOT erase code area.\n");
         return res;
     }
 
+    FlashClaim();
     EFM_Unlock();
     EFM_FlashCmd(Enable);
 
@@ -26,6 +53,7 @@ en_result_t FlashErasePage(uint32_t u32Addr)
     }
 
     EFM_Lock();
+    FlashRelease();
 
     return res;
 }
@@ -37,6 +65,7 @@ uint32_t Flash_Updata(uint32_t flashAddr, const void * dataBuf, uint16_t length)
     uint32_t addr_end = flashAddr + length;
     uint32_t offset = 0;
 
+    FlashClaim();
     EFM_Unlock();
     EFM_FlashCmd(Enable);
 
@@ -58,6 +87,42 @@ uint32_t Flash_Updata(uint32_t flashAddr, const void * dataBuf, uint16_t length)
     }
 
     EFM_Lock();
+    FlashRelease();
+
+    return res;
+}
+
+// program words into erased flash, without erasing the sector first
+en_result_t FlashProgram(uint32_t flashAddr, const void * dataBuf, uint16_t length)
+{
+    en_result res = Error;
+    uint32_t addr = flashAddr;
+    uint32_t addr_end = flashAddr + length;
+    uint32_t offset = 0;
+
+    if(flashAddr < FLASH_DATA_AREA_START) {
+        printf("can NOT program code area.\n");
+        return res;
+    }
+
+    FlashClaim();
+    EFM_Unlock();
+    EFM_FlashCmd(Enable);
+
+    while(Set != EFM_GetFlagStatus(EFM_FLAG_RDY));
+
+    while(addr < addr_end) {
+        res = EFM_SingleProgram(addr, *((uint32_t *)((uint8_t *)dataBuf + offset)));
+        if(res != Ok) {
+            printf("Error, func: %s, line: %d.\n", __FUNCTION__, __LINE__);
+            break;
+        }
+        addr += 4;
+        offset += 4;
+    }
+
+    EFM_Lock();
+    FlashRelease();
 
     return res;
 }
@@ -74,6 +139,7 @@ void eeprom_buffer_flush()
     uint32_t addr_end = FLASH_EEPROM_BASE + EEPROM_SIZE;
     uint32_t offset = 0;
 
+    FlashClaim();
     EFM_Unlock();
     EFM_FlashCmd(Enable);
 
@@ -95,6 +161,7 @@ void eeprom_buffer_flush()
     }
 
     EFM_Lock();
+    FlashRelease();
 }
 
 uint8_t eeprom_read_byte(const uint32_t pos)
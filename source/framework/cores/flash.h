@@ -12,29 +12,54 @@ extern "C" {
 #endif
 
 
-// use 256k to improve compatibility
-// 32 sectors, 8k bytes per sector
-#define FLASH_SECTOR_TOTAL    32
+// HC32F460PETB: 512k, 64 sectors, 8k bytes per sector
+#define FLASH_SECTOR_TOTAL    64
 #define FLASH_SECTOR_SIZE     ((uint32_t)(8*1024U))
 #define FLASH_ALL_START       0
-#define FLASH_ALL_END         ((uint32_t)0x0003FFFFU)
+#define FLASH_ALL_END         ((uint32_t)0x0007FFFFU)
+
+// The data sectors take the top 32k. Code runs from 0x8000, after the
+// bootloader, up to FLASH_DATA_AREA_START.
 
 // use last sector to emulate eeprom
-#define FLASH_EEPROM_BASE     ((uint32_t)0x0003E000U)
+#define FLASH_EEPROM_BASE     ((uint32_t)0x0007E000U)
 
 
-#define FLASH_BASE            ((uint32_t)0x0003E000U)              /*!< FLASH base address in the alias region */
+#define FLASH_BASE            ((uint32_t)0x0007E000U)              /*!< FLASH base address in the alias region */
 
-// just use 1k bytes, not a full sector
-#define EEPROM_SIZE           1024
+// just use 2k bytes, not a full sector: settings, then the mesh slots at the end
+#define EEPROM_SIZE           2048
 
 
 // power outage
-#define FLASH_OUTAGE_DATA_ADDR  ((uint32_t)0x0003C000U)
+#define FLASH_OUTAGE_DATA_ADDR  ((uint32_t)0x0007C000U)
+
+// power-loss journal, a ring of sectors ending with the outage sector
+#define FLASH_PLR_JOURNAL_BASE      ((uint32_t)0x0007A000U)
+#define FLASH_PLR_JOURNAL_SECTORS   2
+
+// settings log, takes turns with the eeprom sector
+#define FLASH_SETTINGS_BASE     ((uint32_t)0x00078000U)
+
+// everything below is code and may not be erased, keep in step with IROM1 in the project
+// (0x8000 + 0x70000): armlink then refuses an image that would run into the data area
+#define FLASH_DATA_AREA_START   FLASH_SETTINGS_BASE
+
+// the stock firmware kept its eeprom page here, read once to import its settings
+#define FLASH_STOCK_EEPROM_BASE ((uint32_t)0x0003E000U)
 
 
 
 namespace Intflash {
+    // Every flash operation holds the flash while it runs, and a caller may
+    // hold it across several. An interrupt must not start a flash operation
+    // while FlashBusy(); it can leave the work to the release callback, which
+    // runs when the last holder lets go.
+    bool FlashBusy();
+    void FlashClaim();
+    void FlashRelease();
+    void FlashSetReleaseCallback(void (*callback)(void));
+
     void eeprom_buffer_fill();
     uint8_t eeprom_buffered_read_byte(const uint32_t pos);
     void eeprom_buffered_write_byte(uint32_t pos, uint8_t value);
@@ -43,6 +68,7 @@ namespace Intflash {
     void eeprom_buffer_flush();
      uint32_t Flash_Updata(uint32_t flashAddr, const void * dataBuf, uint16_t length);
      en_result_t FlashErasePage(uint32_t u32Addr);
+     en_result_t FlashProgram(uint32_t flashAddr, const void * dataBuf, uint16_t length);
 }
 
 #ifdef __cplusplus